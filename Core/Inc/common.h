@@ -41,6 +41,15 @@ extern "C"
 				+((x&0x0F000000LU)?64:0) \
 				+((x&0xF0000000LU)?128:0)
 
+// DWT cycle counter, count CPU clock cycles
+#define CYCLE_COUNTER_ENABLE()	do \
+								{ \
+									CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; \
+									DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; \
+								} \
+								while(0)
+#define CYCLE_COUNTER_GET()		(DWT->CYCCNT)
+
 /*******************************************************************************
  * ENUMERATED
  ******************************************************************************/
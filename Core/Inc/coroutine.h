@@ -0,0 +1,126 @@
+/*******************************************************************************
+ * Filename:			coroutine.h
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Stackless coroutine (protothread) function
+*******************************************************************************/
+
+#ifndef _COROUTINE_H_
+#define _COROUTINE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "common.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+#define NUM_OF_COROUTINE		4
+
+// Coroutine body must be wrapped by COROUTINE_BEGIN and COROUTINE_END.
+// Local variables are lost when coroutine yield or wait, use static variables
+// for value need to keep. Do not use switch statement inside coroutine body.
+#define COROUTINE_BEGIN(psContext)		switch((psContext)->line) \
+										{ \
+											case 0:
+
+#define COROUTINE_END(psContext)		} \
+										(psContext)->line = 0; \
+										return COROUTINE_EXITED
+
+// Give up CPU, continue on next schedule
+#define COROUTINE_YIELD(psContext)		do \
+										{ \
+											(psContext)->line = __LINE__; \
+											return COROUTINE_YIELDED; \
+											case __LINE__:; \
+										} \
+										while(0)
+
+// Wait until condition is true
+#define COROUTINE_WAIT_UNTIL(psContext, condition) \
+										do \
+										{ \
+											(psContext)->line = __LINE__; \
+											case __LINE__: \
+											if(!(condition)) \
+											{ \
+												return COROUTINE_WAITING; \
+											} \
+										} \
+										while(0)
+
+// Wait for delay (ms)
+#define COROUTINE_DELAY(psContext, delay) \
+										do \
+										{ \
+											(psContext)->timestamp = HAL_GetTick(); \
+											COROUTINE_WAIT_UNTIL(psContext, (HAL_GetTick() - (psContext)->timestamp) >= (delay)); \
+										} \
+										while(0)
+
+// Finish coroutine immediately
+#define COROUTINE_EXIT(psContext)		do \
+										{ \
+											(psContext)->line = 0; \
+											return COROUTINE_EXITED; \
+										} \
+										while(0)
+
+/*******************************************************************************
+ * ENUMERATE
+ ******************************************************************************/
+// Coroutine state define
+typedef enum
+{
+	COROUTINE_WAITING = 0,
+	COROUTINE_YIELDED,
+	COROUTINE_EXITED,
+}
+eCOROUTINE_STATE;
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define coroutine context structure
+typedef struct
+{
+	uint16_t line;
+	uint32_t timestamp;
+}
+sCOROUTINE_CONTEXT;
+
+// Coroutine function.
+typedef eCOROUTINE_STATE (*COROUTINE_FUNCTION)(sCOROUTINE_CONTEXT *psContext);
+
+// Define coroutine function structure
+typedef struct _sCOROUTINE
+{
+	uint8_t (*Initialize)(COROUTINE_FUNCTION coroutineFunction);
+	void (*Start)(uint8_t coroutineId);
+	void (*Stop)(uint8_t coroutineId);
+	bool (*Schedule)(void);
+	bool (*IsIdle)(void);
+}
+sCOROUTINE;
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+extern sCOROUTINE sCoroutine;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _COROUTINE_H_ */
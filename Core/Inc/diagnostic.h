@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Filename:			diagnostic.h
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Event dispatch latency diagnostic function
+*******************************************************************************/
+
+#ifndef _DIAGNOSTIC_H_
+#define _DIAGNOSTIC_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "common.h"
+#include "main_loop.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// Log2 histogram, bucket n hold value from 2^n to 2^(n+1)-1 cycles
+#define NUM_OF_DIAGNOSTIC_BUCKET		32
+// Print to SWV ITM data console every period (s)
+#define DIAGNOSTIC_PRINT_PERIOD			10
+// Key / screen pair tracked for edge to display latency
+#define NUM_OF_DIAGNOSTIC_DISPLAY_PAIR	16
+// Edge to last LCD byte budget (ms)
+#define DIAGNOSTIC_DISPLAY_BUDGET		60
+
+/*******************************************************************************
+ * ENUMERATE
+ ******************************************************************************/
+// Diagnostic metric define
+typedef enum
+{
+	// First EXTI edge to event flag raised
+	DIAGNOSTIC_DEBOUNCE = 0,
+	// Event flag raised to handler called
+	DIAGNOSTIC_DISPATCH,
+	// Handler called to handler returned
+	DIAGNOSTIC_HANDLER,
+	// Stop 2 mode wake up to event flag raised, include clock restore
+	// counted at MSI clock
+	DIAGNOSTIC_WAKE,
+	// First EXTI edge to last LCD byte of the resulting screen
+	DIAGNOSTIC_DISPLAY,
+	maximumDiagnosticMetric,
+}
+eDIAGNOSTIC_METRIC;
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define diagnostic statistic structure, all value in CPU cycles
+typedef struct
+{
+	uint32_t count;
+	uint32_t minimum;
+	uint32_t average;
+	uint32_t maximum;
+	// Upper bound of histogram bucket
+	uint32_t percentile50;
+	uint32_t percentile90;
+	uint32_t percentile99;
+	// Sample over DIAGNOSTIC_DISPLAY_BUDGET
+	uint32_t overBudget;
+}
+sDIAGNOSTIC_STATISTIC;
+
+// Define diagnostic function structure
+typedef struct _sDIAGNOSTIC
+{
+	void (*Initialize)(void);
+	void (*EdgeDetected)(eEVENT_FLAGS eEventFlag);
+	void (*FlagRaised)(eEVENT_FLAGS eEventFlag);
+	void (*HandlerStart)(eEVENT_FLAGS eEventFlag);
+	void (*HandlerEnd)(eEVENT_FLAGS eEventFlag);
+	void (*Wakeup)(eEVENT_FLAGS eEventFlag, uint32_t wakeCycle);
+	void (*DisplayStart)(eEVENT_FLAGS eEventFlag, uint8_t key);
+	void (*DisplayWritten)(void);
+	void (*DisplayEnd)(uint16_t screen);
+	void (*GetStatistic)(eEVENT_FLAGS eEventFlag, eDIAGNOSTIC_METRIC eDiagnosticMetric, sDIAGNOSTIC_STATISTIC *psDiagnosticStatistic);
+	bool (*GetDisplayStatistic)(uint8_t pair, uint8_t *key, uint16_t *screen, sDIAGNOSTIC_STATISTIC *psDiagnosticStatistic);
+	void (*Print)(void);
+}
+sDIAGNOSTIC;
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+extern sDIAGNOSTIC sDiagnostic;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DIAGNOSTIC_H_ */
@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * Filename:			field_editor.h
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Typed field editor, edit one field in place on LCD
+*******************************************************************************/
+
+#ifndef _FIELD_EDITOR_H_
+#define _FIELD_EDITOR_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "common.h"
+#include "key_map.h"
+#include "software_timer.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+#define FIELD_MAX_LENGTH	16
+
+/*******************************************************************************
+ * ENUMERATE
+ ******************************************************************************/
+// Field type define
+typedef enum
+{
+	// Bounded integer, Up / Down step, digit key type in
+	FIELD_INTEGER = 0,
+	// Integer shown with decimal point, minimum / maximum / step in raw unit
+	FIELD_FIXED_POINT,
+	// One of maximum texts, Up / Down select
+	FIELD_ENUM,
+	// Digit string, minimum / maximum is length, may be masked
+	FIELD_STRING,
+	// Multi-tap or predictive text (Function B, long press '1' of 4x3),
+	// maximum is length
+	FIELD_TEXT,
+	// 20YY-MM-DD, per digit edit
+	FIELD_DATE,
+	// HH:MM:SS, per digit edit
+	FIELD_TIME,
+}
+eFIELD_TYPE;
+
+// Multi-tap character set define, Function A key select next set
+typedef enum
+{
+	CHARACTER_SET_UPPER = 0,
+	CHARACTER_SET_ALPHANUMERIC,
+	CHARACTER_SET_SYMBOL,
+	maximumCharacterSet,
+}
+eCHARACTER_SET;
+
+// Field editor key result define
+typedef enum
+{
+	FIELD_EDITING = 0,
+	FIELD_DONE,
+	FIELD_CANCEL,
+}
+eFIELD_RESULT;
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Field enum text function, index is 0 to maximum - 1
+typedef const char* (*FIELD_ENUM_TEXT)(uint8_t index);
+
+// Define field structure
+typedef struct
+{
+	uint8_t eFieldType;
+	bool isHidden;
+	uint8_t decimal;
+	uint8_t eCharacterSet;
+	int16_t minimum;
+	int16_t maximum;
+	int16_t step;
+	FIELD_ENUM_TEXT GetEnumText;
+}
+sFIELD;
+
+// Define field editor function structure
+typedef struct _sFIELD_EDITOR
+{
+	void (*Initialize)(SOFTWARE_TIMER_CALLBACK tapTimerCallback);
+	void (*Open)(const sFIELD *psField, uint8_t line, uint8_t position, const char *value);
+	eFIELD_RESULT (*Key)(const sKEY_MAP_ENTRY *psKeyMapEntry);
+	eFIELD_RESULT (*LongKey)(const sKEY_MAP_ENTRY *psKeyMapEntry);
+	void (*TapTimeout)(void);
+	const char* (*GetText)(void);
+	int32_t (*GetValue)(void);
+	void (*Close)(void);
+}
+sFIELD_EDITOR;
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+extern sFIELD_EDITOR sFieldEditor;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _FIELD_EDITOR_H_ */
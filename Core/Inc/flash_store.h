@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Filename:			flash_store.h
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Key value log in last two flash pages
+*******************************************************************************/
+
+#ifndef _FLASH_STORE_H_
+#define _FLASH_STORE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "common.h"
+#include "software_timer.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// Key 0 to FLASH_STORE_KEY_COUNT - 1
+#define FLASH_STORE_KEY_COUNT		8
+// Value of one key, record is at most 3 double words
+#define FLASH_STORE_MAX_LENGTH		20
+// Write is kept in RAM until no write for this time (ms)
+#define FLASH_STORE_FLUSH_DELAY		2000
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define flash store statistic structure
+typedef struct
+{
+	// Boot scan duration
+	uint32_t loadCycles;
+	// Value bytes written by user, record bytes programmed to flash
+	uint32_t valueBytes;
+	uint32_t programBytes;
+	uint16_t compactionCount;
+	uint16_t errorCount;
+}
+sFLASH_STORE_STATISTIC;
+
+// Define flash store function structure
+typedef struct _sFLASH_STORE
+{
+	void (*Initialize)(SOFTWARE_TIMER_CALLBACK eventCallback);
+	uint8_t (*Read)(uint8_t key, void *data, uint8_t size);
+	void (*Write)(uint8_t key, const void *data, uint8_t length);
+	void (*Process)(void);
+	void (*OperationEnd)(bool isError);
+	bool (*IsIdle)(void);
+	void (*EccError)(void);
+	void (*GetStatistic)(sFLASH_STORE_STATISTIC *psFlashStoreStatistic);
+	void (*Print)(void);
+}
+sFLASH_STORE;
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+extern sFLASH_STORE sFlashStore;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _FLASH_STORE_H_ */
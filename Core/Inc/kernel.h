@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Filename:			kernel.h
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Fixed priority preemptive kernel function
+*******************************************************************************/
+
+#ifndef _KERNEL_H_
+#define _KERNEL_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "common.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// Set 1 to run main loop as kernel tasks instead of super loop
+#ifndef KERNEL_ENABLE
+#define KERNEL_ENABLE					0
+#endif
+#define NUM_OF_KERNEL_TASK				5
+// Lowest priority, reserved for idle task
+#define KERNEL_IDLE_PRIORITY			0
+#define KERNEL_IDLE_STACK_SIZE			128
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Kernel task function.
+typedef void (*KERNEL_TASK)(void);
+// Kernel idle function, called repeatedly by idle task
+typedef void (*KERNEL_IDLE_CALLBACK)(void);
+
+// Define kernel statistic structure
+typedef struct
+{
+	uint32_t contextSwitchCount;
+	// Context switch time (CPU cycles), PendSV entry to exception return
+	uint32_t minimumContextSwitchCycles;
+	uint32_t averageContextSwitchCycles;
+	uint32_t maximumContextSwitchCycles;
+}
+sKERNEL_STATISTIC;
+
+// Define kernel function structure
+typedef struct _sKERNEL
+{
+	void (*Initialize)(KERNEL_IDLE_CALLBACK idleCallback);
+	uint8_t (*CreateTask)(KERNEL_TASK kernelTask, uint8_t priority, uint32_t *stack, uint32_t stackSize);
+	void (*Start)(void);
+	void (*Delay)(uint32_t delay);
+	uint32_t (*WaitEvent)(void);
+	void (*SignalEvent)(uint8_t taskId, uint32_t event);
+	void (*GetStatistic)(sKERNEL_STATISTIC *psKernelStatistic);
+	bool (*IsIdle)(void);
+}
+sKERNEL;
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+extern sKERNEL sKernel;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INTERRUPT CALLBACK
+ ******************************************************************************/
+/*******************************************************************************
+ * @fn      KernelTickInterruptCallback
+ * @brief   Kernel tick interrupt callback, call from SysTick every 1ms
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+void KernelTickInterruptCallback(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _KERNEL_H_ */
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * Filename:			key_map.h
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Keypad layout to logical key function
+*******************************************************************************/
+
+#ifndef _KEY_MAP_H_
+#define _KEY_MAP_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "common.h"
+#include "matrix_button.h"
+
+/*******************************************************************************
+ * ENUMERATE
+ ******************************************************************************/
+// Logical key function define
+typedef enum
+{
+	KEY_NONE = 0,
+	KEY_UP,
+	KEY_DOWN,
+	KEY_EXIT,
+	KEY_ENTER,
+	KEY_FUNCTION_A,
+	KEY_FUNCTION_B,
+	KEY_FUNCTION_C,
+	KEY_FUNCTION_D,
+}
+eKEY_FUNCTION;
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define key map entry structure, a key may have both digit and function
+typedef struct
+{
+	// '0' - '9', 0 if the key is not a digit
+	char digit;
+	eKEY_FUNCTION eKeyFunction;
+	// Function of held key at long press, for keypad short of function key
+	eKEY_FUNCTION eLongKeyFunction;
+}
+sKEY_MAP_ENTRY;
+
+// Define key map function structure
+typedef struct _sKEY_MAP
+{
+	const sKEY_MAP_ENTRY* (*Get)(uint32_t pressedButton);
+}
+sKEY_MAP;
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+extern sKEY_MAP sKeyMap;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _KEY_MAP_H_ */
@@ -102,10 +102,11 @@ typedef struct _sLCD
 	bool (*ClearDisplay)(void);
 	bool (*ReturnHome)(void);
 	bool (*GoTo)(uint8_t line, uint8_t position);
-	bool (*WriteString)(uint8_t line, uint8_t position, char* data, eLCD_ALIGN eLcdAlign);
+	bool (*WriteString)(uint8_t line, uint8_t position, const char* data, eLCD_ALIGN eLcdAlign);
 	bool (*WriteCharacter)(uint8_t data);
 	bool (*WriteCharacterTo)(uint8_t line, uint8_t position, uint8_t data);
 	bool (*ShiftCursorDisplay)(eLCD_SHIFT eLcdShift);
+	bool (*SetCharacter)(uint8_t character, const uint8_t *pattern);
 }
 sLCD;
 
@@ -58,8 +58,6 @@ void Error_Handler(void);
 /* USER CODE END EFP */
 
 /* Private defines -----------------------------------------------------------*/
-#define TIMER_PRESCALER 7999
-#define TIMER_COUNTER 9
 #define LCD_TIMER_PRESCALER 1
 #define LCD_TIMER_COUNTER 3
 #define LCD_DB4_Pin GPIO_PIN_0
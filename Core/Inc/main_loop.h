@@ -26,6 +26,9 @@ typedef enum
 {
 	matrixButtonEventFlag	= 0,
 	rtcOneSecondEventFlag,
+	multiTapEventFlag,
+	flashStoreEventFlag,
+	temperatureSensorEventFlag,
 	maximumEventFlag,
 }
 eEVENT_FLAGS;
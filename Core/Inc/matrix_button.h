@@ -21,14 +21,67 @@ extern "C"
 /*******************************************************************************
  * CONSTANTS
  ******************************************************************************/
+// Scan mode, select at build time
+#define MATRIX_BUTTON_EXTI_MODE				0
+#define MATRIX_BUTTON_PERIODIC_MODE			1
+#define MATRIX_BUTTON_DMA_MODE				2
+#ifndef MATRIX_BUTTON_SCAN_MODE
+#define MATRIX_BUTTON_SCAN_MODE				MATRIX_BUTTON_EXTI_MODE
+#endif
 #define DEBOUNCE_DELAY						50
+// Number of keypad instance, every keypad has the same maximum size. DMA scan
+// mode own TIM1 and DMA1 channels, it serve one keypad only.
+#ifndef NUM_OF_MATRIX_BUTTON_KEYPAD
+#if MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_DMA_MODE
+#define NUM_OF_MATRIX_BUTTON_KEYPAD			1
+#else
+#define NUM_OF_MATRIX_BUTTON_KEYPAD			2
+#endif
+#endif
+#if MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_DMA_MODE && NUM_OF_MATRIX_BUTTON_KEYPAD != 1
+#error "DMA scan mode serve one keypad only, use periodic scan mode for more keypad"
+#endif
 #define NUM_OF_MATRIX_BUTTON_ROW			4
 #define NUM_OF_MATRIX_BUTTON_COLUMN			4
+#define NUM_OF_MATRIX_BUTTON				(NUM_OF_MATRIX_BUTTON_ROW * NUM_OF_MATRIX_BUTTON_COLUMN)
+// Scan step period (ms), one column per step
+#define MATRIX_BUTTON_SCAN_PERIOD			1
+// Number of empty full scan to detect release
+#define MATRIX_BUTTON_RELEASE_SCAN			3
+// Periodic mode: default number of agreeing scans to change key state
+#define MATRIX_BUTTON_DEBOUNCE_SCAN			5
+// Periodic mode: row settle time after column driven low (CPU cycles)
+#define MATRIX_BUTTON_SETTLE_CYCLES			160
+// DMA mode: TIM1 step per column (us) and full scans per half buffer
+#define MATRIX_BUTTON_DMA_STEP_PERIOD		250
+#define MATRIX_BUTTON_DMA_SCAN				8
+// DMA mode: column pins span up to 2 ports, row pins up to 3 ports
+#define MATRIX_BUTTON_DMA_COLUMN_PORT		2
+#define MATRIX_BUTTON_DMA_ROW_PORT			3
+#define NUM_OF_KEY_EVENT					16
+// Default hold timing (ms), repeat interval shrink 1/8 per repeat down to minimum
+#define KEY_LONG_PRESS_DELAY				1000
+#define KEY_REPEAT_DELAY					500
+#define KEY_REPEAT_INTERVAL					200
+#define KEY_REPEAT_MINIMUM_INTERVAL			40
+
+/*******************************************************************************
+ * ENUMERATE
+ ******************************************************************************/
+// Key event type define
+typedef enum
+{
+	KEY_PRESS = 0,
+	KEY_RELEASE,
+	KEY_LONG_PRESS,
+	KEY_REPEAT,
+}
+eKEY_EVENT_TYPE;
 
 /*******************************************************************************
  * STRUCTURE
  ******************************************************************************/
-// Define matrix button structure
+// Define matrix button pin structure
 typedef struct
 {
 	GPIO_TypeDef* gpio;
@@ -36,15 +89,46 @@ typedef struct
 }
 sMATRIX_BUTTON_PIN;
 
+// Define matrix button keypad descriptor structure, keep it const in flash.
+// Row pins of all keypads must use different EXTI line (pin number).
+typedef struct
+{
+	sMATRIX_BUTTON_PIN sColumnPin[NUM_OF_MATRIX_BUTTON_COLUMN];
+	sMATRIX_BUTTON_PIN sRowPin[NUM_OF_MATRIX_BUTTON_ROW];
+	// Periodic and DMA mode: agreeing scans to change key state, every key
+	uint8_t debounceScan;
+}
+sMATRIX_BUTTON_CONFIG;
+
+// Define key event structure
+typedef struct
+{
+	// Bit number in key state, (row * NUM_OF_MATRIX_BUTTON_COLUMN) + column
+	uint8_t key;
+	eKEY_EVENT_TYPE eKeyEventType;
+	// Number of repeat since press, 0 for other type
+	uint16_t repeatCount;
+	// HAL tick (ms)
+	uint32_t timestamp;
+}
+sKEY_EVENT;
+
 // Matrix button callback function.
-typedef void (*MATRIX_BUTTON_CALLBACK)(void);
+typedef void (*MATRIX_BUTTON_CALLBACK)(uint8_t keypadId);
 
 // Define matrix button function structure
 typedef struct _sMATRIX_BUTTON
 {
-	void (*Initialize)(MATRIX_BUTTON_CALLBACK matrixButtonCallback, ...);
-	uint32_t (*GetPressedButton)(void);
-	void (*StartDebounce)(uint8_t row);
+	uint8_t (*Initialize)(const sMATRIX_BUTTON_CONFIG *psMatrixButtonConfig, MATRIX_BUTTON_CALLBACK matrixButtonCallback);
+	uint32_t (*GetPressedButton)(uint8_t keypadId);
+	bool (*StartDebounce)(uint16_t gpioPin);
+	uint16_t (*GetKeyState)(uint8_t keypadId);
+	void (*GetKeyEdge)(uint8_t keypadId, uint16_t *pressEdge, uint16_t *releaseEdge);
+	void (*SetDebounce)(uint8_t keypadId, uint8_t key, uint8_t debounceScan);
+	bool (*GetKeyEvent)(uint8_t keypadId, sKEY_EVENT *psKeyEvent);
+	void (*SetRepeat)(uint8_t keypadId, uint16_t longPressDelay, uint16_t repeatDelay, uint16_t repeatInterval, uint16_t repeatMinimumInterval);
+	bool (*EnterLowPower)(void);
+	bool (*ExitLowPower)(void);
 }
 sMATRIX_BUTTON;
 
@@ -57,6 +141,17 @@ extern sMATRIX_BUTTON sMatrixButton;
  * PUBLIC FUNCTIONS
  ******************************************************************************/
 
+/*******************************************************************************
+ * INTERRUPT CALLBACK
+ ******************************************************************************/
+/*******************************************************************************
+ * @fn      MatrixButtonDmaInterruptCallback
+ * @brief   Row sample DMA interrupt callback, DMA mode only
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+void MatrixButtonDmaInterruptCallback(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,7 +26,6 @@ extern "C"
  * CONSTANTS
  ******************************************************************************/
 #define TITLE_MAX_LENGTH				17
-#define NUM_OF_MENU_LIST				50
 #define INDICATE_CURRENT_MENU_SYMBOL	'~'
 #define HIDDEN_SYMBOL					'*'
 #define ALPHABET_BUTTON_DELAY			1500
@@ -41,7 +40,11 @@ typedef struct _sMENU_LIST
 {
 	void (*Initialize)(void);
 	void (*ButtonPressed)(uint32_t pressedButton);
+	void (*ButtonRepeated)(uint32_t pressedButton);
+	void (*ButtonLongPressed)(uint32_t pressedButton);
 	void (*UpdateDateTime)(void);
+	void (*UpdateTemperature)(void);
+	uint16_t (*GetScreen)(void);
 }
 sMENU_LIST;
 
@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * Filename:			menu_tree.h
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Menu tree definition, expanded by menu_list.c only
+*******************************************************************************/
+
+#ifndef _MENU_TREE_H_
+#define _MENU_TREE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "common.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// Menu field, one line per editable value. Field type select the editor,
+// validator check minimum / maximum as number (VALIDATE_RANGE) or length
+// (VALIDATE_LENGTH), VALIDATE_MATCH take minimum as value to match. Integer
+// field is bounded by minimum / maximum and Up / Down change it by step.
+// Commit may still reject, on success go to next menu, MENU_NONE go back to
+// parent. Value with store key is kept in flash store and loaded at boot.
+// X(value, prompt, eFieldType, eMenuValidator, minimum, maximum, step, commit, nextMenu, storeKey)
+#define MENU_FIELD(X) \
+	X(VALUE_PASSWORD,			"Key in password",	FIELD_STRING,	VALIDATE_PASSWORD,	0,					0,	0,	NULL,			MENU_SETTING,			STORE_NONE) \
+	X(VALUE_USER_NAME,			NULL,				FIELD_TEXT,		VALIDATE_NONE,		0,					0,	0,	NULL,			MENU_NONE,				STORE_USER_NAME) \
+	X(VALUE_SERIAL_NUMBER,		NULL,				FIELD_STRING,	VALIDATE_NONE,		0,					0,	0,	NULL,			MENU_NONE,				STORE_SERIAL_NUMBER) \
+	X(VALUE_TEMPERATURE,		NULL,				FIELD_ENUM,		VALIDATE_NONE,		0,					0,	0,	NULL,			MENU_NONE,				STORE_TEMPERATURE) \
+	X(VALUE_BACKLIGHT,			"Backlight %",		FIELD_INTEGER,	VALIDATE_RANGE,		0,					100,	10,	NULL,			MENU_NONE,				STORE_BACKLIGHT) \
+	X(VALUE_DATE,				"Date",				FIELD_DATE,		VALIDATE_NONE,		0,					0,	0,	NULL,			MENU_TIME,				STORE_NONE) \
+	X(VALUE_TIME,				"Time",				FIELD_TIME,		VALIDATE_NONE,		0,					0,	0,	DateTimeCommit,	MENU_NONE,				STORE_NONE) \
+	X(VALUE_OLD_PASSWORD,		"Old Password",		FIELD_STRING,	VALIDATE_PASSWORD,	0,					0,	0,	NULL,			MENU_NEW_PASSWORD,		STORE_NONE) \
+	X(VALUE_NEW_PASSWORD,		"New Password",		FIELD_STRING,	VALIDATE_LENGTH,	6,					6,	0,	NULL,			MENU_CONFIRM_PASSWORD,	STORE_NONE) \
+	X(VALUE_CONFIRM_PASSWORD,	"Confirm Password",	FIELD_STRING,	VALIDATE_MATCH,		VALUE_NEW_PASSWORD,	0,	0,	PasswordCommit,	MENU_NONE,				STORE_NONE)
+
+// Menu provider, one line per virtual menu list. Entries are made on
+// demand from index, count may be any size and change at any time.
+// X(provider, count, title, open)
+#define MENU_PROVIDER(X) \
+	X(PROVIDER_DAILY_REPORT,	DailyReportCount,	DailyReportTitle,	DailyReportOpen) \
+	X(PROVIDER_WEEKLY_REPORT,	WeeklyReportCount,	WeeklyReportTitle,	WeeklyReportOpen) \
+	X(PROVIDER_MONTHLY_REPORT,	MonthlyReportCount,	MonthlyReportTitle,	MonthlyReportOpen)
+
+// Menu tree, one line per menu, links name other menu ID or MENU_NONE.
+// eMenuValue is menu value of EDITOR and menu provider of VIRTUAL.
+// X(id, parent, child, previous, next, title, eMenuAction, eMenuType, isHidden, keyinMaxLength, eMenuValue)
+#define MENU_TREE(X) \
+	X(MENU_DATE_TIME,			MENU_NONE,				MENU_PASSWORD,				MENU_NONE,					MENU_NONE,					"",					DATE_TIME_ACTION,	TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_PASSWORD,			MENU_DATE_TIME,			MENU_NONE,					MENU_NONE,					MENU_SETTING,				"",					EDITOR_ACTION,		EDITOR,		true,	6,	VALUE_PASSWORD) \
+	X(MENU_SETTING,				MENU_DATE_TIME,			MENU_USER_NAME,				MENU_PASSWORD,				MENU_REPORT,				"Setting",			TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_USER_NAME,			MENU_SETTING,			MENU_USER_NAME_VALUE,		MENU_NONE,					MENU_SERIAL_NUMBER,			"User Name",		TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_USER_NAME_VALUE,		MENU_USER_NAME,			MENU_NONE,					MENU_NONE,					MENU_NONE,					"",					EDITOR_ACTION,		EDITOR,		false,	8,	VALUE_USER_NAME) \
+	X(MENU_SERIAL_NUMBER,		MENU_SETTING,			MENU_SERIAL_NUMBER_VALUE,	MENU_USER_NAME,				MENU_TEMPERATURE,			"Serial Number",	TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_SERIAL_NUMBER_VALUE,	MENU_SERIAL_NUMBER,		MENU_NONE,					MENU_NONE,					MENU_NONE,					"",					EDITOR_ACTION,		EDITOR,		false,	8,	VALUE_SERIAL_NUMBER) \
+	X(MENU_TEMPERATURE,			MENU_SETTING,			MENU_TEMPERATURE_VALUE,		MENU_SERIAL_NUMBER,			MENU_BACKLIGHT,				"Temperature",		TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_TEMPERATURE_VALUE,	MENU_TEMPERATURE,		MENU_TEMPERATURE_LOW,		MENU_NONE,					MENU_NONE,					"",					EDITOR_ACTION,		EDITOR,		false,	0,	VALUE_TEMPERATURE) \
+	X(MENU_TEMPERATURE_LOW,		MENU_TEMPERATURE_VALUE,	MENU_NONE,					MENU_NONE,					MENU_TEMPERATURE_MEDIUM,	"Low",				TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_TEMPERATURE_MEDIUM,	MENU_TEMPERATURE_VALUE,	MENU_NONE,					MENU_TEMPERATURE_LOW,		MENU_TEMPERATURE_HIGH,		"Medium",			TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_TEMPERATURE_HIGH,	MENU_TEMPERATURE_VALUE,	MENU_NONE,					MENU_TEMPERATURE_MEDIUM,	MENU_NONE,					"High",				TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_BACKLIGHT,			MENU_SETTING,			MENU_BACKLIGHT_VALUE,		MENU_TEMPERATURE,			MENU_SET_DATE_TIME,			"Backlight",		TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_BACKLIGHT_VALUE,		MENU_BACKLIGHT,			MENU_NONE,					MENU_NONE,					MENU_NONE,					"",					EDITOR_ACTION,		EDITOR,		false,	0,	VALUE_BACKLIGHT) \
+	X(MENU_SET_DATE_TIME,		MENU_SETTING,			MENU_DATE,					MENU_BACKLIGHT,				MENU_CHANGE_PASSWORD,		"Date Time",		TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_DATE,				MENU_SET_DATE_TIME,		MENU_NONE,					MENU_NONE,					MENU_TIME,					"",					EDITOR_ACTION,		EDITOR,		false,	0,	VALUE_DATE) \
+	X(MENU_TIME,				MENU_SET_DATE_TIME,		MENU_NONE,					MENU_DATE,					MENU_NONE,					"",					EDITOR_ACTION,		EDITOR,		false,	0,	VALUE_TIME) \
+	X(MENU_CHANGE_PASSWORD,		MENU_SETTING,			MENU_OLD_PASSWORD,			MENU_SET_DATE_TIME,			MENU_NONE,					"Change Passwd",	TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_OLD_PASSWORD,		MENU_CHANGE_PASSWORD,	MENU_NONE,					MENU_NONE,					MENU_NEW_PASSWORD,			"",					EDITOR_ACTION,		EDITOR,		true,	6,	VALUE_OLD_PASSWORD) \
+	X(MENU_NEW_PASSWORD,		MENU_CHANGE_PASSWORD,	MENU_NONE,					MENU_OLD_PASSWORD,			MENU_CONFIRM_PASSWORD,		"",					EDITOR_ACTION,		EDITOR,		true,	6,	VALUE_NEW_PASSWORD) \
+	X(MENU_CONFIRM_PASSWORD,	MENU_CHANGE_PASSWORD,	MENU_NONE,					MENU_NEW_PASSWORD,			MENU_NONE,					"",					EDITOR_ACTION,		EDITOR,		true,	6,	VALUE_CONFIRM_PASSWORD) \
+	X(MENU_REPORT,				MENU_DATE_TIME,			MENU_DAILY_REPORT,			MENU_SETTING,				MENU_INFO,					"Report",			TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_DAILY_REPORT,		MENU_REPORT,			MENU_DAILY_REPORT_LIST,		MENU_NONE,					MENU_WEEKLY_REPORT,			"Daily Report",		TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_DAILY_REPORT_LIST,	MENU_DAILY_REPORT,		MENU_NONE,					MENU_NONE,					MENU_NONE,					"",					VIRTUAL_ACTION,		VIRTUAL,	false,	0,	PROVIDER_DAILY_REPORT) \
+	X(MENU_WEEKLY_REPORT,		MENU_REPORT,			MENU_WEEKLY_REPORT_LIST,	MENU_DAILY_REPORT,			MENU_MONTHLY_REPORT,		"Weekly Report",	TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_WEEKLY_REPORT_LIST,	MENU_WEEKLY_REPORT,		MENU_NONE,					MENU_NONE,					MENU_NONE,					"",					VIRTUAL_ACTION,		VIRTUAL,	false,	0,	PROVIDER_WEEKLY_REPORT) \
+	X(MENU_MONTHLY_REPORT,		MENU_REPORT,			MENU_MONTHLY_REPORT_LIST,	MENU_WEEKLY_REPORT,			MENU_NONE,					"Monthly Report",	TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_MONTHLY_REPORT_LIST,	MENU_MONTHLY_REPORT,	MENU_NONE,					MENU_NONE,					MENU_NONE,					"",					VIRTUAL_ACTION,		VIRTUAL,	false,	0,	PROVIDER_MONTHLY_REPORT) \
+	X(MENU_INFO,				MENU_DATE_TIME,			MENU_VERSION,				MENU_REPORT,				MENU_NONE,					"Info",				TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_VERSION,				MENU_INFO,				MENU_VERSION_VALUE,			MENU_NONE,					MENU_LAST_UPDATE,			"Version",			TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_VERSION_VALUE,		MENU_VERSION,			MENU_NONE,					MENU_NONE,					MENU_NONE,					"V1.0.0",			INFO_ACTION,		INFO,		false,	0,	NO_VALUE) \
+	X(MENU_LAST_UPDATE,			MENU_INFO,				MENU_LAST_UPDATE_VALUE,		MENU_VERSION,				MENU_DIAGNOSTIC,			"Last Update",		TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_LAST_UPDATE_VALUE,	MENU_LAST_UPDATE,		MENU_NONE,					MENU_NONE,					MENU_NONE,					"20.05.25 23:00",	INFO_ACTION,		INFO,		false,	0,	NO_VALUE) \
+	X(MENU_DIAGNOSTIC,			MENU_INFO,				MENU_DIAGNOSTIC_VALUE,		MENU_LAST_UPDATE,			MENU_SENSOR,				"Diagnostic",		TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_DIAGNOSTIC_VALUE,	MENU_DIAGNOSTIC,		MENU_NONE,					MENU_NONE,					MENU_NONE,					"",					DIAGNOSTIC_ACTION,	INFO,		false,	0,	NO_VALUE) \
+	X(MENU_SENSOR,				MENU_INFO,				MENU_SENSOR_VALUE,			MENU_DIAGNOSTIC,			MENU_NONE,					"Sensor",			TITLE_ACTION,		TITLE,		false,	0,	NO_VALUE) \
+	X(MENU_SENSOR_VALUE,		MENU_SENSOR,			MENU_NONE,					MENU_NONE,					MENU_NONE,					"",					TEMPERATURE_ACTION,	INFO,		false,	0,	NO_VALUE)
+
+/*******************************************************************************
+ * ENUMERATE
+ ******************************************************************************/
+// Menu value define, user key in and selected option are kept in RAM
+typedef enum
+{
+#define MENU_VALUE_ID(value, prompt, type, validator, minimum, maximum, step, commit, nextMenu, storeKey)	value,
+	MENU_FIELD(MENU_VALUE_ID)
+#undef MENU_VALUE_ID
+	maximumMenuValue,
+	NO_VALUE = maximumMenuValue,
+}
+eMENU_VALUE;
+
+// Menu provider define
+typedef enum
+{
+#define MENU_PROVIDER_ID(provider, count, title, open)	provider,
+	MENU_PROVIDER(MENU_PROVIDER_ID)
+#undef MENU_PROVIDER_ID
+	maximumMenuProvider,
+}
+eMENU_PROVIDER;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MENU_TREE_H_ */
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * Filename:			power_manager.h
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Idle low power function
+*******************************************************************************/
+
+#ifndef _POWER_MANAGER_H_
+#define _POWER_MANAGER_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "common.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// Set 0 to never go deeper than sleep mode
+#define POWER_MANAGER_STOP2_ENABLE		1
+// Typical supply current of each mode (uA), used as average current proxy
+#define POWER_RUN_CURRENT				8000
+#define POWER_SLEEP_CURRENT				2000
+#define POWER_STOP2_CURRENT				2
+
+/*******************************************************************************
+ * ENUMERATE
+ ******************************************************************************/
+// Power mode define
+typedef enum
+{
+	POWER_RUN_MODE = 0,
+	POWER_SLEEP_MODE,
+	POWER_STOP2_MODE,
+	maximumPowerMode,
+}
+ePOWER_MODE;
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define power statistic structure
+typedef struct
+{
+	// Time spent in each mode (us)
+	uint64_t modeTime[maximumPowerMode];
+	// Number of wake up from each mode
+	uint32_t wakeCount[maximumPowerMode];
+	// Wake up to event dispatch latency (CPU cycles)
+	uint32_t lastWakeLatency[maximumPowerMode];
+	uint32_t maximumWakeLatency[maximumPowerMode];
+	// Cycles to restore PLL after stop 2 mode (counted at MSI clock)
+	uint32_t clockRestoreCycles;
+	// Average current proxy (uA)
+	uint32_t averageCurrent;
+}
+sPOWER_STATISTIC;
+
+// Define power manager function structure
+typedef struct _sPOWER_MANAGER
+{
+	void (*Initialize)(void);
+	void (*Idle)(volatile uint32_t *eventFlags);
+	void (*EventDispatched)(void);
+	void (*GetStatistic)(sPOWER_STATISTIC *psPowerStatistic);
+	void (*Print)(void);
+}
+sPOWER_MANAGER;
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+extern sPOWER_MANAGER sPowerManager;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _POWER_MANAGER_H_ */
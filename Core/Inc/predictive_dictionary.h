@@ -0,0 +1,160 @@
+/*******************************************************************************
+ * Filename:			predictive_dictionary.h
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Predictive text dictionary, generated by
+ * 						Tools/predictive_dictionary.py from predictive_words.txt, do not edit
+*******************************************************************************/
+
+#ifndef _PREDICTIVE_DICTIONARY_H_
+#define _PREDICTIVE_DICTIONARY_H_
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// 82 word, 203 node, 1008 byte flash
+#define PREDICTIVE_NODE_COUNT	203
+#define PREDICTIVE_RANK_BLOCK	16
+#define PREDICTIVE_BLOCK_COUNT	13
+#define PREDICTIVE_GROUP_COUNT	73
+
+/*******************************************************************************
+ * LOCAL VARIBLES
+ ******************************************************************************/
+// Child digit bitmap of node in level order, bit 0 is key '2'
+static const uint8_t predictiveChild[PREDICTIVE_NODE_COUNT] =
+{
+	0xFF, 0x3F, 0x33, 0x12, 0x17, 0x1F, 0x55, 0x37, 0x14, 0x20, 0x51, 0x01, 0x01, 0xDB, 0x04, 0x40,
+	0x80, 0x10, 0x04, 0x18, 0x14, 0x71, 0x72, 0x30, 0x04, 0x30, 0x82, 0x01, 0x02, 0x04, 0x70, 0x01,
+	0x11, 0x62, 0x10, 0x20, 0x12, 0x10, 0x02, 0x08, 0x10, 0x10, 0x10, 0x00, 0x40, 0x10, 0x10, 0x00,
+	0x00, 0x02, 0x23, 0x04, 0x00, 0x01, 0x04, 0x01, 0x11, 0x01, 0x02, 0x20, 0x00, 0x02, 0x00, 0x02,
+	0x12, 0x20, 0x00, 0x10, 0x20, 0x04, 0x03, 0x21, 0x10, 0x03, 0x88, 0x04, 0x00, 0x04, 0x00, 0x00,
+	0x02, 0x01, 0x08, 0x24, 0x02, 0x11, 0x40, 0x01, 0x04, 0x00, 0x40, 0x00, 0x10, 0x00, 0x20, 0x08,
+	0x04, 0x08, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x10, 0x02, 0x20, 0x00, 0x01,
+	0x00, 0x10, 0x04, 0x00, 0x20, 0x10, 0x10, 0x01, 0x04, 0x04, 0x10, 0x02, 0x01, 0x00, 0x00, 0x00,
+	0x80, 0x00, 0x00, 0x00, 0x01, 0x01, 0x20, 0x04, 0x00, 0x01, 0x10, 0x20, 0x08, 0x00, 0x02, 0x10,
+	0x00, 0x00, 0x01, 0x00, 0x04, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x02, 0x00, 0x00, 0x02, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x20, 0x00, 0x00, 0x02, 0x02, 0x01, 0x00, 0x20, 0x10, 0x40,
+	0x02, 0x10, 0x00, 0x20, 0x01, 0x80, 0x00, 0x00, 0x01, 0x08, 0x00, 0x08, 0x00, 0x02, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00,
+};
+
+// Child bit count before each block
+static const uint16_t predictiveChildRank[PREDICTIVE_BLOCK_COUNT] =
+{
+	0, 54, 83, 101, 116, 133, 148, 156, 167, 178, 183, 191,
+	200,
+};
+
+// Node has word bit vector, bit n of entry is node block * 16 + n
+static const uint16_t predictiveTerminal[PREDICTIVE_BLOCK_COUNT] =
+{
+	0x0000, 0x2C10, 0x8820, 0x5011, 0xD04C, 0x2A00, 0x43F4, 0xE009, 0x210E, 0xB6EB, 0x11AF, 0xD4C4,
+	0x07B7,
+};
+
+// Terminal bit count before each block
+static const uint16_t predictiveTerminalRank[PREDICTIVE_BLOCK_COUNT] =
+{
+	0, 0, 4, 7, 11, 17, 20, 28, 33, 38, 49, 57,
+	64,
+};
+
+// Word group start in predictiveWord, last entry is end of pool
+static const uint32_t predictiveWordIndex[PREDICTIVE_GROUP_COUNT + 1] =
+{
+	0, 6, 12, 15, 21, 24, 28, 32, 40, 44, 48, 52,
+	56, 60, 64, 68, 72, 76, 80, 84, 88, 93, 98, 103,
+	108, 113, 118, 123, 128, 133, 158, 163, 173, 178, 183, 188,
+	193, 198, 203, 208, 213, 218, 223, 229, 235, 241, 247, 253,
+	259, 265, 271, 277, 283, 289, 295, 301, 307, 313, 319, 326,
+	333, 340, 347, 354, 361, 368, 375, 382, 390, 398, 406, 414,
+	422, 431,
+};
+
+// Word pool, word of a group share digit sequence, highest frequency first
+static const char predictiveWord[] =
+	"in\0"
+	"go\0"
+	"of\0"
+	"me\0"
+	"ng\0"
+	"on\0"
+	"no\0"
+	"to\0"
+	"ben\0"
+	"bob\0"
+	"and\0"
+	"coe\0"
+	"amy\0"
+	"goh\0"
+	"lab\0"
+	"lee\0"
+	"ken\0"
+	"lim\0"
+	"new\0"
+	"old\0"
+	"ong\0"
+	"tan\0"
+	"the\0"
+	"tom\0"
+	"adam\0"
+	"chan\0"
+	"alan\0"
+	"cole\0"
+	"anna\0"
+	"anne\0"
+	"amos\0"
+	"emma\0"
+	"eric\0"
+	"home\0"
+	"good\0"
+	"gone\0"
+	"hood\0"
+	"hoof\0"
+	"lisa\0"
+	"kiss\0"
+	"lips\0"
+	"john\0"
+	"name\0"
+	"mark\0"
+	"mary\0"
+	"paul\0"
+	"room\0"
+	"ruth\0"
+	"test\0"
+	"user\0"
+	"wong\0"
+	"carol\0"
+	"betty\0"
+	"brian\0"
+	"david\0"
+	"donna\0"
+	"helen\0"
+	"james\0"
+	"karen\0"
+	"jason\0"
+	"laura\0"
+	"leong\0"
+	"kevin\0"
+	"linda\0"
+	"nancy\0"
+	"sarah\0"
+	"susan\0"
+	"edward\0"
+	"george\0"
+	"office\0"
+	"sandra\0"
+	"sharon\0"
+	"robert\0"
+	"ronald\0"
+	"steven\0"
+	"thomas\0"
+	"anthony\0"
+	"jessica\0"
+	"michael\0"
+	"richard\0"
+	"william\0"
+	"kimberly";
+
+#endif /* _PREDICTIVE_DICTIONARY_H_ */
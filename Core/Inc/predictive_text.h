@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * Filename:			predictive_text.h
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    One key per letter word lookup in flash dictionary
+*******************************************************************************/
+
+#ifndef _PREDICTIVE_TEXT_H_
+#define _PREDICTIVE_TEXT_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "common.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// Node of empty digit sequence
+#define PREDICTIVE_ROOT		0
+// No word start with digit sequence
+#define PREDICTIVE_NO_NODE	0xFFFF
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define predictive text function structure
+typedef struct _sPREDICTIVE_TEXT
+{
+	uint16_t (*Next)(uint16_t node, char digit);
+	uint8_t (*GetWordCount)(uint16_t node);
+	const char* (*GetWord)(uint16_t node, uint8_t rank);
+	const char* (*GetCompletion)(uint16_t node);
+}
+sPREDICTIVE_TEXT;
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+extern sPREDICTIVE_TEXT sPredictiveText;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PREDICTIVE_TEXT_H_ */
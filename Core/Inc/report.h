@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Filename:			report.h
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Daily, weekly and monthly aggregate of timed sample
+*******************************************************************************/
+
+#ifndef _REPORT_H_
+#define _REPORT_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "common.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// Period kept in each ring table, older one is overwritten
+#define REPORT_DAY_COUNT			365
+#define REPORT_WEEK_COUNT			53
+#define REPORT_MONTH_COUNT			12
+
+/*******************************************************************************
+ * ENUMERATE
+ ******************************************************************************/
+// Report period define
+typedef enum
+{
+	REPORT_DAILY = 0,
+	REPORT_WEEKLY,
+	REPORT_MONTHLY,
+	maximumReportPeriod,
+}
+eREPORT_PERIOD;
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define report aggregate structure, one per period
+typedef struct
+{
+	int32_t sum;
+	uint32_t count;
+	// Period number since 1970, day, ISO week or month
+	uint16_t key;
+	int16_t minimum;
+	int16_t maximum;
+}
+sREPORT_AGGREGATE;
+
+// Define report statistic structure
+typedef struct
+{
+	uint32_t sampleCount;
+	// Sample older than its ring table
+	uint32_t droppedCount;
+	// Total of every update, 32 bit wrap within a year of 1 s sample
+	uint64_t updateCycles;
+	uint32_t maximumUpdateCycles;
+}
+sREPORT_STATISTIC;
+
+// Define report function structure
+typedef struct _sREPORT
+{
+	void (*Initialize)(void);
+	void (*AddSample)(time_t unixTime, int16_t value);
+	bool (*Get)(eREPORT_PERIOD eReportPeriod, time_t unixTime, uint16_t index, sREPORT_AGGREGATE *psReportAggregate);
+	void (*GetStatistic)(sREPORT_STATISTIC *psReportStatistic);
+	void (*Print)(void);
+}
+sREPORT;
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+extern sREPORT sReport;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _REPORT_H_ */
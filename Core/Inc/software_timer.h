@@ -18,15 +18,9 @@ extern "C"
  ******************************************************************************/
 #include "common.h"
 
-/*******************************************************************************
- * EXTERNAL VARIABLES
- ******************************************************************************/
-extern TIM_HandleTypeDef htim6;
-
 /*******************************************************************************
  * CONSTANTS
  ******************************************************************************/
-#define SOFTWARE_TIMER_HANDLE	htim6
 #define NUM_OF_SOFTWARE_TIMER	8
 
 /*******************************************************************************
@@ -54,6 +48,7 @@ typedef struct _sSOFTWARE_TIMER
 	uint8_t (*Initialize)(SOFTWARE_TIMER_CALLBACK softwareTimerStartCallback, SOFTWARE_TIMER_CALLBACK softwareTimerCallback, SOFTWARE_TIMER_CALLBACK softwareTimerStopCallback, eTIMER_TYPE eTimerType);
 	void (*Start)(uint8_t softwareTimerId, uint32_t period);
 	void (*Stop)(uint8_t softwareTimerId);
+	bool (*IsIdle)(void);
 }
 sSOFTWARE_TIMER;
 
@@ -71,7 +66,7 @@ extern sSOFTWARE_TIMER sSoftwareTimer;
  ******************************************************************************/
 /*******************************************************************************
  * @fn      SoftwareTimerInterruptCallback
- * @brief   Software timer interrupt callback
+ * @brief   Software timer interrupt callback, call from SysTick every 1ms
  * @param	None
  * @return	None
  ******************************************************************************/
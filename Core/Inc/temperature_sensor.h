@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Filename:			temperature_sensor.h
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    On-chip temperature sensor sampled by ADC1 and DMA
+*******************************************************************************/
+
+#ifndef _TEMPERATURE_SENSOR_H_
+#define _TEMPERATURE_SENSOR_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "common.h"
+#include "software_timer.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// Conversion per burst and TIM6 trigger period (us), one burst per second
+#define TEMPERATURE_SENSOR_BLOCK			16
+#define TEMPERATURE_SENSOR_SAMPLE_PERIOD	1000
+// IIR weight of new block is 1 / 2^shift
+#define TEMPERATURE_SENSOR_IIR_SHIFT		3
+// Burst per sample written to report
+#define TEMPERATURE_SENSOR_LOG_PERIOD		60
+// No block is filtered yet
+#define TEMPERATURE_SENSOR_NO_VALUE			INT16_MIN
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define temperature sensor statistic structure
+typedef struct
+{
+	uint32_t blockCount;
+	// Burst started before last one ended
+	uint32_t overrunCount;
+	uint32_t maximumFilterCycles;
+}
+sTEMPERATURE_SENSOR_STATISTIC;
+
+// Define temperature sensor function structure
+typedef struct _sTEMPERATURE_SENSOR
+{
+	void (*Initialize)(SOFTWARE_TIMER_CALLBACK eventCallback);
+	void (*Start)(void);
+	int16_t (*Get)(void);
+	bool (*IsIdle)(void);
+	void (*GetStatistic)(sTEMPERATURE_SENSOR_STATISTIC *psTemperatureSensorStatistic);
+	void (*Print)(void);
+}
+sTEMPERATURE_SENSOR;
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+extern sTEMPERATURE_SENSOR sTemperatureSensor;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INTERRUPT CALLBACK
+ ******************************************************************************/
+/*******************************************************************************
+ * @fn      TemperatureSensorDmaInterruptCallback
+ * @brief   ADC sample DMA interrupt callback
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+void TemperatureSensorDmaInterruptCallback(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TEMPERATURE_SENSOR_H_ */
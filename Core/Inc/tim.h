@@ -30,14 +30,12 @@
 
 /* USER CODE END Includes */
 
-extern TIM_HandleTypeDef htim6;
 extern TIM_HandleTypeDef htim7;
 
 /* USER CODE BEGIN Private defines */
 
 /* USER CODE END Private defines */
 
-void MX_TIM6_Init(void);
 void MX_TIM7_Init(void);
 
 /* USER CODE BEGIN Prototypes */
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ * Filename:			coroutine.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Stackless coroutine (protothread) function
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "coroutine.h"
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+
+/*******************************************************************************
+ * LOCAL VARIBLES
+ ******************************************************************************/
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define coroutine property structure
+typedef struct
+{
+	uint8_t usedCoroutine;
+	bool isRunning[NUM_OF_COROUTINE];
+	COROUTINE_FUNCTION coroutineFunction[NUM_OF_COROUTINE];
+	sCOROUTINE_CONTEXT sCoroutineContext[NUM_OF_COROUTINE];
+}
+sCOROUTINE_PRO;
+static sCOROUTINE_PRO sCoroutinePro;
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+static uint8_t CoroutineInitialize(COROUTINE_FUNCTION coroutineFunction);
+static void CoroutineStart(uint8_t coroutineId);
+static void CoroutineStop(uint8_t coroutineId);
+static bool CoroutineSchedule(void);
+static bool CoroutineIsIdle(void);
+
+/*******************************************************************************
+ * @fn      CoroutineInitialize
+ * @brief   Coroutine initialize
+ * @param   coroutineFunction
+ * @return  Coroutine ID
+ ******************************************************************************/
+static uint8_t CoroutineInitialize(COROUTINE_FUNCTION coroutineFunction)
+{
+    if(sCoroutinePro.usedCoroutine == NUM_OF_COROUTINE)
+    {
+    	// Increase "NUM_OF_COROUTINE"
+    	for(;;)
+    	{
+    	}
+    }
+    sCoroutinePro.isRunning[sCoroutinePro.usedCoroutine] = false;
+    sCoroutinePro.coroutineFunction[sCoroutinePro.usedCoroutine] = coroutineFunction;
+    sCoroutinePro.sCoroutineContext[sCoroutinePro.usedCoroutine].line = 0;
+    sCoroutinePro.usedCoroutine++;
+    return sCoroutinePro.usedCoroutine - 1;
+}
+
+/*******************************************************************************
+ * @fn      CoroutineStart
+ * @brief   Start coroutine from beginning, restart if it is running
+ * @param   coroutineId
+ * @return  None
+ ******************************************************************************/
+static void CoroutineStart(uint8_t coroutineId)
+{
+	sCoroutinePro.sCoroutineContext[coroutineId].line = 0;
+	sCoroutinePro.isRunning[coroutineId] = true;
+}
+
+/*******************************************************************************
+ * @fn      CoroutineStop
+ * @brief   Stop coroutine
+ * @param   coroutineId
+ * @return  None
+ ******************************************************************************/
+static void CoroutineStop(uint8_t coroutineId)
+{
+	sCoroutinePro.isRunning[coroutineId] = false;
+	sCoroutinePro.sCoroutineContext[coroutineId].line = 0;
+}
+
+/*******************************************************************************
+ * @fn      CoroutineSchedule
+ * @brief   Run every running coroutine until it yield, wait or exit
+ * @param   None
+ * @return  true	At least one coroutine is ready to continue immediately
+ *			false
+ ******************************************************************************/
+static bool CoroutineSchedule(void)
+{
+	uint8_t i = 0;
+	bool isReady = false;
+
+	for(i = 0; i < sCoroutinePro.usedCoroutine; i++)
+	{
+		if(!sCoroutinePro.isRunning[i])
+		{
+			continue;
+		}
+		switch(sCoroutinePro.coroutineFunction[i](&sCoroutinePro.sCoroutineContext[i]))
+		{
+			case COROUTINE_YIELDED:
+				isReady = true;
+				break;
+			case COROUTINE_EXITED:
+				sCoroutinePro.isRunning[i] = false;
+				break;
+			default:
+				break;
+		}
+	}
+	return isReady;
+}
+
+/*******************************************************************************
+ * @fn      CoroutineIsIdle
+ * @brief   Check no coroutine is running
+ * @param   None
+ * @return  true
+ *			false
+ ******************************************************************************/
+static bool CoroutineIsIdle(void)
+{
+	uint8_t i = 0;
+
+	for(i = 0; i < sCoroutinePro.usedCoroutine; i++)
+	{
+		if(sCoroutinePro.isRunning[i])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Coroutine function structure
+sCOROUTINE sCoroutine =
+{
+	CoroutineInitialize,
+	CoroutineStart,
+	CoroutineStop,
+	CoroutineSchedule,
+	CoroutineIsIdle,
+};
@@ -0,0 +1,547 @@
+/*******************************************************************************
+ * Filename:			diagnostic.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Event dispatch latency diagnostic function
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "diagnostic.h"
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+
+/*******************************************************************************
+ * LOCAL VARIBLES
+ ******************************************************************************/
+static const char *eventFlagName[maximumEventFlag] =
+{
+	"Key",
+	"RTC",
+	"Tap",
+	"Store",
+	"Temp",
+};
+
+static const char *diagnosticMetricName[maximumDiagnosticMetric] =
+{
+	"Debounce",
+	"Dispatch",
+	"Handler",
+	"Wake",
+	"Display",
+};
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define diagnostic metric structure
+typedef struct
+{
+	uint32_t count;
+	uint32_t minimum;
+	uint32_t maximum;
+	uint64_t total;
+	uint32_t overBudget;
+	uint32_t histogram[NUM_OF_DIAGNOSTIC_BUCKET];
+}
+sDIAGNOSTIC_METRIC;
+
+// Define diagnostic event structure
+typedef struct
+{
+	bool isEdgePending;
+	bool isFlagPending;
+	bool isWakePending;
+	bool isDisplayEdgePending;
+	uint32_t edgeCycle;
+	uint32_t displayEdgeCycle;
+	uint32_t wakeCycle;
+	uint32_t flagCycle;
+	uint32_t handlerCycle;
+	sDIAGNOSTIC_METRIC sDiagnosticMetric[maximumDiagnosticMetric];
+}
+sDIAGNOSTIC_EVENT;
+
+// Define diagnostic display pair structure
+typedef struct
+{
+	uint8_t key;
+	uint16_t screen;
+	sDIAGNOSTIC_METRIC sDiagnosticMetric;
+}
+sDIAGNOSTIC_DISPLAY_PAIR;
+
+// Define diagnostic property structure
+typedef struct
+{
+	sDIAGNOSTIC_EVENT sDiagnosticEvent[maximumEventFlag];
+	// One edge to display measurement in flight, a newer key replace it
+	bool isDisplayPending;
+	volatile bool isDisplayWritten;
+	eEVENT_FLAGS eDisplayEventFlag;
+	uint8_t displayKey;
+	uint32_t displayStartCycle;
+	volatile uint32_t displayCycle;
+	uint8_t usedDisplayPair;
+	// Pair table full, sample only counted in event metric
+	uint32_t droppedDisplayPair;
+	sDIAGNOSTIC_DISPLAY_PAIR sDiagnosticDisplayPair[NUM_OF_DIAGNOSTIC_DISPLAY_PAIR];
+}
+sDIAGNOSTIC_PRO;
+static sDIAGNOSTIC_PRO sDiagnosticPro;
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+static void DiagnosticRecord(sDIAGNOSTIC_METRIC *psDiagnosticMetric, uint32_t cycles);
+static uint32_t DiagnosticPercentile(sDIAGNOSTIC_METRIC *psDiagnosticMetric, uint8_t percent);
+static void DiagnosticFillStatistic(sDIAGNOSTIC_METRIC *psDiagnosticMetric, sDIAGNOSTIC_STATISTIC *psDiagnosticStatistic);
+static sDIAGNOSTIC_DISPLAY_PAIR* DiagnosticFindDisplayPair(uint8_t key, uint16_t screen);
+
+/*******************************************************************************
+ * @fn      DiagnosticRecord
+ * @brief   Add one sample to metric
+ * @param	psDiagnosticMetric
+ *			cycles
+ * @return	None
+ ******************************************************************************/
+static void DiagnosticRecord(sDIAGNOSTIC_METRIC *psDiagnosticMetric, uint32_t cycles)
+{
+	uint8_t bucket = (cycles > 0) ? (31 - __CLZ(cycles)) : 0;
+
+	if(psDiagnosticMetric->count == 0 || cycles < psDiagnosticMetric->minimum)
+	{
+		psDiagnosticMetric->minimum = cycles;
+	}
+	if(cycles > psDiagnosticMetric->maximum)
+	{
+		psDiagnosticMetric->maximum = cycles;
+	}
+	psDiagnosticMetric->total += cycles;
+	psDiagnosticMetric->histogram[bucket]++;
+	psDiagnosticMetric->count++;
+}
+
+/*******************************************************************************
+ * @fn      DiagnosticPercentile
+ * @brief   Find percentile from log2 histogram
+ * @param	psDiagnosticMetric
+ *			percent
+ * @return	Upper bound of the bucket hold the percentile (cycles)
+ ******************************************************************************/
+static uint32_t DiagnosticPercentile(sDIAGNOSTIC_METRIC *psDiagnosticMetric, uint8_t percent)
+{
+	uint8_t i = 0;
+	uint32_t target = ((uint64_t)psDiagnosticMetric->count * percent + 99) / 100;
+	uint32_t accumulate = 0;
+	uint32_t upperBound;
+
+	for(i = 0; i < NUM_OF_DIAGNOSTIC_BUCKET; i++)
+	{
+		accumulate += psDiagnosticMetric->histogram[i];
+		if(accumulate >= target)
+		{
+			break;
+		}
+	}
+	upperBound = (i < 31) ? ((0x02UL << i) - 1) : 0xFFFFFFFF;
+	// Bucket is coarse, never report more than the real maximum
+	return (upperBound < psDiagnosticMetric->maximum) ? upperBound : psDiagnosticMetric->maximum;
+}
+
+/*******************************************************************************
+ * @fn      DiagnosticFillStatistic
+ * @brief   Convert metric snapshot to statistic
+ * @param	psDiagnosticMetric
+ *			psDiagnosticStatistic
+ * @return	None
+ ******************************************************************************/
+static void DiagnosticFillStatistic(sDIAGNOSTIC_METRIC *psDiagnosticMetric, sDIAGNOSTIC_STATISTIC *psDiagnosticStatistic)
+{
+	psDiagnosticStatistic->count = psDiagnosticMetric->count;
+	psDiagnosticStatistic->overBudget = psDiagnosticMetric->overBudget;
+	if(psDiagnosticMetric->count == 0)
+	{
+		psDiagnosticStatistic->minimum = 0;
+		psDiagnosticStatistic->average = 0;
+		psDiagnosticStatistic->maximum = 0;
+		psDiagnosticStatistic->percentile50 = 0;
+		psDiagnosticStatistic->percentile90 = 0;
+		psDiagnosticStatistic->percentile99 = 0;
+		return;
+	}
+	psDiagnosticStatistic->minimum = psDiagnosticMetric->minimum;
+	psDiagnosticStatistic->average = psDiagnosticMetric->total / psDiagnosticMetric->count;
+	psDiagnosticStatistic->maximum = psDiagnosticMetric->maximum;
+	psDiagnosticStatistic->percentile50 = DiagnosticPercentile(psDiagnosticMetric, 50);
+	psDiagnosticStatistic->percentile90 = DiagnosticPercentile(psDiagnosticMetric, 90);
+	psDiagnosticStatistic->percentile99 = DiagnosticPercentile(psDiagnosticMetric, 99);
+}
+
+/*******************************************************************************
+ * @fn      DiagnosticFindDisplayPair
+ * @brief   Find key / screen pair, add it if not there
+ * @param	key
+ *			screen
+ * @return	Pair, NULL if table is full
+ ******************************************************************************/
+static sDIAGNOSTIC_DISPLAY_PAIR* DiagnosticFindDisplayPair(uint8_t key, uint16_t screen)
+{
+	uint8_t i = 0;
+	sDIAGNOSTIC_DISPLAY_PAIR *psDiagnosticDisplayPair;
+
+	for(i = 0; i < sDiagnosticPro.usedDisplayPair; i++)
+	{
+		psDiagnosticDisplayPair = &sDiagnosticPro.sDiagnosticDisplayPair[i];
+		if(psDiagnosticDisplayPair->key == key && psDiagnosticDisplayPair->screen == screen)
+		{
+			return psDiagnosticDisplayPair;
+		}
+	}
+	if(sDiagnosticPro.usedDisplayPair >= NUM_OF_DIAGNOSTIC_DISPLAY_PAIR)
+	{
+		// Increase "NUM_OF_DIAGNOSTIC_DISPLAY_PAIR" to track more pair
+		return NULL;
+	}
+	psDiagnosticDisplayPair = &sDiagnosticPro.sDiagnosticDisplayPair[sDiagnosticPro.usedDisplayPair++];
+	psDiagnosticDisplayPair->key = key;
+	psDiagnosticDisplayPair->screen = screen;
+	return psDiagnosticDisplayPair;
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+static void DiagnosticInitialize(void);
+static void DiagnosticEdgeDetected(eEVENT_FLAGS eEventFlag);
+static void DiagnosticFlagRaised(eEVENT_FLAGS eEventFlag);
+static void DiagnosticHandlerStart(eEVENT_FLAGS eEventFlag);
+static void DiagnosticHandlerEnd(eEVENT_FLAGS eEventFlag);
+static void DiagnosticWakeup(eEVENT_FLAGS eEventFlag, uint32_t wakeCycle);
+static void DiagnosticDisplayStart(eEVENT_FLAGS eEventFlag, uint8_t key);
+static void DiagnosticDisplayWritten(void);
+static void DiagnosticDisplayEnd(uint16_t screen);
+static void DiagnosticGetStatistic(eEVENT_FLAGS eEventFlag, eDIAGNOSTIC_METRIC eDiagnosticMetric, sDIAGNOSTIC_STATISTIC *psDiagnosticStatistic);
+static bool DiagnosticGetDisplayStatistic(uint8_t pair, uint8_t *key, uint16_t *screen, sDIAGNOSTIC_STATISTIC *psDiagnosticStatistic);
+static void DiagnosticPrint(void);
+
+/*******************************************************************************
+ * @fn      DiagnosticInitialize
+ * @brief   Diagnostic initialize
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+static void DiagnosticInitialize(void)
+{
+	CYCLE_COUNTER_ENABLE();
+	memset(&sDiagnosticPro, 0, sizeof(sDiagnosticPro));
+}
+
+/*******************************************************************************
+ * @fn      DiagnosticEdgeDetected
+ * @brief   Raw interrupt edge detected, call from interrupt, only the first
+ *			edge of a bounce burst is kept
+ * @param	eEventFlag
+ * @return	None
+ ******************************************************************************/
+static void DiagnosticEdgeDetected(eEVENT_FLAGS eEventFlag)
+{
+	sDIAGNOSTIC_EVENT *psDiagnosticEvent = &sDiagnosticPro.sDiagnosticEvent[eEventFlag];
+
+	if(!psDiagnosticEvent->isEdgePending)
+	{
+		psDiagnosticEvent->edgeCycle = CYCLE_COUNTER_GET();
+		psDiagnosticEvent->isEdgePending = true;
+	}
+}
+
+/*******************************************************************************
+ * @fn      DiagnosticFlagRaised
+ * @brief   Event flag raised, call from interrupt
+ * @param	eEventFlag
+ * @return	None
+ ******************************************************************************/
+static void DiagnosticFlagRaised(eEVENT_FLAGS eEventFlag)
+{
+	sDIAGNOSTIC_EVENT *psDiagnosticEvent = &sDiagnosticPro.sDiagnosticEvent[eEventFlag];
+	uint32_t cycle = CYCLE_COUNTER_GET();
+
+	if(psDiagnosticEvent->isEdgePending)
+	{
+		psDiagnosticEvent->isEdgePending = false;
+		DiagnosticRecord(&psDiagnosticEvent->sDiagnosticMetric[DIAGNOSTIC_DEBOUNCE], cycle - psDiagnosticEvent->edgeCycle);
+		// Keep the edge until the handler redraw the screen
+		psDiagnosticEvent->displayEdgeCycle = psDiagnosticEvent->edgeCycle;
+		psDiagnosticEvent->isDisplayEdgePending = true;
+	}
+	if(psDiagnosticEvent->isWakePending)
+	{
+		psDiagnosticEvent->isWakePending = false;
+		DiagnosticRecord(&psDiagnosticEvent->sDiagnosticMetric[DIAGNOSTIC_WAKE], cycle - psDiagnosticEvent->wakeCycle);
+	}
+	// Keep the oldest raise if main loop has not served it yet
+	if(!psDiagnosticEvent->isFlagPending)
+	{
+		psDiagnosticEvent->flagCycle = cycle;
+		psDiagnosticEvent->isFlagPending = true;
+	}
+}
+
+/*******************************************************************************
+ * @fn      DiagnosticHandlerStart
+ * @brief   Event handler is going to be called
+ * @param	eEventFlag
+ * @return	None
+ ******************************************************************************/
+static void DiagnosticHandlerStart(eEVENT_FLAGS eEventFlag)
+{
+	sDIAGNOSTIC_EVENT *psDiagnosticEvent = &sDiagnosticPro.sDiagnosticEvent[eEventFlag];
+	uint32_t cycle = CYCLE_COUNTER_GET();
+
+	__disable_irq();
+	if(psDiagnosticEvent->isFlagPending)
+	{
+		psDiagnosticEvent->isFlagPending = false;
+		DiagnosticRecord(&psDiagnosticEvent->sDiagnosticMetric[DIAGNOSTIC_DISPATCH], cycle - psDiagnosticEvent->flagCycle);
+	}
+	__enable_irq();
+	psDiagnosticEvent->handlerCycle = CYCLE_COUNTER_GET();
+}
+
+/*******************************************************************************
+ * @fn      DiagnosticHandlerEnd
+ * @brief   Event handler returned
+ * @param	eEventFlag
+ * @return	None
+ ******************************************************************************/
+static void DiagnosticHandlerEnd(eEVENT_FLAGS eEventFlag)
+{
+	sDIAGNOSTIC_EVENT *psDiagnosticEvent = &sDiagnosticPro.sDiagnosticEvent[eEventFlag];
+
+	DiagnosticRecord(&psDiagnosticEvent->sDiagnosticMetric[DIAGNOSTIC_HANDLER], CYCLE_COUNTER_GET() - psDiagnosticEvent->handlerCycle);
+}
+
+/*******************************************************************************
+ * @fn      DiagnosticWakeup
+ * @brief   MCU woken up from stop 2 mode, call with interrupt disabled
+ * @param	eEventFlag	Event woke up the MCU, maximumEventFlag for other
+ *			wakeCycle	Cycle counter right after WFI returned
+ * @return	None
+ ******************************************************************************/
+static void DiagnosticWakeup(eEVENT_FLAGS eEventFlag, uint32_t wakeCycle)
+{
+	uint8_t i = 0;
+
+	// Wake up without event, e.g. released before scan, is not measured
+	for(i = 0; i < maximumEventFlag; i++)
+	{
+		sDiagnosticPro.sDiagnosticEvent[i].isWakePending = false;
+	}
+	if(eEventFlag < maximumEventFlag)
+	{
+		sDiagnosticPro.sDiagnosticEvent[eEventFlag].wakeCycle = wakeCycle;
+		sDiagnosticPro.sDiagnosticEvent[eEventFlag].isWakePending = true;
+	}
+}
+
+/*******************************************************************************
+ * @fn      DiagnosticDisplayStart
+ * @brief   Event handler start to serve the key of the last edge, the screen
+ *			it draw is measured until DiagnosticDisplayEnd
+ * @param	eEventFlag
+ *			key
+ * @return	None
+ ******************************************************************************/
+static void DiagnosticDisplayStart(eEVENT_FLAGS eEventFlag, uint8_t key)
+{
+	sDIAGNOSTIC_EVENT *psDiagnosticEvent = &sDiagnosticPro.sDiagnosticEvent[eEventFlag];
+
+	__disable_irq();
+	// Repeat and queued key without own edge are not measured
+	if(psDiagnosticEvent->isDisplayEdgePending)
+	{
+		psDiagnosticEvent->isDisplayEdgePending = false;
+		sDiagnosticPro.displayStartCycle = psDiagnosticEvent->displayEdgeCycle;
+		sDiagnosticPro.eDisplayEventFlag = eEventFlag;
+		sDiagnosticPro.displayKey = key;
+		sDiagnosticPro.isDisplayWritten = false;
+		sDiagnosticPro.isDisplayPending = true;
+	}
+	__enable_irq();
+}
+
+/*******************************************************************************
+ * @fn      DiagnosticDisplayWritten
+ * @brief   One byte is written to LCD, call from LCD driver
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+static void DiagnosticDisplayWritten(void)
+{
+	if(sDiagnosticPro.isDisplayPending)
+	{
+		sDiagnosticPro.displayCycle = CYCLE_COUNTER_GET();
+		sDiagnosticPro.isDisplayWritten = true;
+	}
+}
+
+/*******************************************************************************
+ * @fn      DiagnosticDisplayEnd
+ * @brief   Nothing left to draw, call when main loop or UI task goes idle,
+ *			background redraw is included
+ * @param	screen	Screen shown after the key
+ * @return	None
+ ******************************************************************************/
+static void DiagnosticDisplayEnd(uint16_t screen)
+{
+	uint32_t cycles;
+	uint32_t budgetCycles = (SystemCoreClock / 1000) * DIAGNOSTIC_DISPLAY_BUDGET;
+	sDIAGNOSTIC_METRIC *psDiagnosticMetric;
+	sDIAGNOSTIC_DISPLAY_PAIR *psDiagnosticDisplayPair;
+
+	if(!sDiagnosticPro.isDisplayPending)
+	{
+		return;
+	}
+	sDiagnosticPro.isDisplayPending = false;
+	// Key did not change the screen
+	if(!sDiagnosticPro.isDisplayWritten)
+	{
+		return;
+	}
+	cycles = sDiagnosticPro.displayCycle - sDiagnosticPro.displayStartCycle;
+	psDiagnosticMetric = &sDiagnosticPro.sDiagnosticEvent[sDiagnosticPro.eDisplayEventFlag].sDiagnosticMetric[DIAGNOSTIC_DISPLAY];
+	DiagnosticRecord(psDiagnosticMetric, cycles);
+	if(cycles > budgetCycles)
+	{
+		psDiagnosticMetric->overBudget++;
+	}
+	psDiagnosticDisplayPair = DiagnosticFindDisplayPair(sDiagnosticPro.displayKey, screen);
+	if(psDiagnosticDisplayPair == NULL)
+	{
+		sDiagnosticPro.droppedDisplayPair++;
+		return;
+	}
+	DiagnosticRecord(&psDiagnosticDisplayPair->sDiagnosticMetric, cycles);
+	if(cycles > budgetCycles)
+	{
+		psDiagnosticDisplayPair->sDiagnosticMetric.overBudget++;
+	}
+}
+
+/*******************************************************************************
+ * @fn      DiagnosticGetStatistic
+ * @brief   Get statistic of one metric
+ * @param	eEventFlag
+ *			eDiagnosticMetric
+ *			psDiagnosticStatistic
+ * @return	None
+ ******************************************************************************/
+static void DiagnosticGetStatistic(eEVENT_FLAGS eEventFlag, eDIAGNOSTIC_METRIC eDiagnosticMetric, sDIAGNOSTIC_STATISTIC *psDiagnosticStatistic)
+{
+	sDIAGNOSTIC_METRIC sDiagnosticMetric;
+
+	// Snapshot, debounce metric is updated from interrupt
+	__disable_irq();
+	sDiagnosticMetric = sDiagnosticPro.sDiagnosticEvent[eEventFlag].sDiagnosticMetric[eDiagnosticMetric];
+	__enable_irq();
+	DiagnosticFillStatistic(&sDiagnosticMetric, psDiagnosticStatistic);
+}
+
+/*******************************************************************************
+ * @fn      DiagnosticGetDisplayStatistic
+ * @brief   Get edge to display statistic of one key / screen pair
+ * @param	pair	0 to NUM_OF_DIAGNOSTIC_DISPLAY_PAIR - 1
+ *			key
+ *			screen
+ *			psDiagnosticStatistic
+ * @return	true
+ *			false	Pair is not used
+ ******************************************************************************/
+static bool DiagnosticGetDisplayStatistic(uint8_t pair, uint8_t *key, uint16_t *screen, sDIAGNOSTIC_STATISTIC *psDiagnosticStatistic)
+{
+	sDIAGNOSTIC_DISPLAY_PAIR *psDiagnosticDisplayPair = &sDiagnosticPro.sDiagnosticDisplayPair[pair];
+
+	if(pair >= sDiagnosticPro.usedDisplayPair)
+	{
+		return false;
+	}
+	*key = psDiagnosticDisplayPair->key;
+	*screen = psDiagnosticDisplayPair->screen;
+	DiagnosticFillStatistic(&psDiagnosticDisplayPair->sDiagnosticMetric, psDiagnosticStatistic);
+	return true;
+}
+
+/*******************************************************************************
+ * @fn      DiagnosticPrint
+ * @brief   Print every metric to SWV ITM data console (us)
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+static void DiagnosticPrint(void)
+{
+	uint8_t i = 0;
+	uint8_t j = 0;
+	uint8_t key;
+	uint16_t screen;
+	uint32_t cyclePerMicrosecond = SystemCoreClock / 1000000;
+	sDIAGNOSTIC_STATISTIC sDiagnosticStatistic;
+
+	for(i = 0; i < maximumEventFlag; i++)
+	{
+		for(j = 0; j < maximumDiagnosticMetric; j++)
+		{
+			DiagnosticGetStatistic(i, j, &sDiagnosticStatistic);
+			if(sDiagnosticStatistic.count == 0)
+			{
+				continue;
+			}
+			printf("%s %s: n %lu min %lu avg %lu p50 %lu p99 %lu max %lu us\n",
+					eventFlagName[i], diagnosticMetricName[j],
+					sDiagnosticStatistic.count,
+					sDiagnosticStatistic.minimum / cyclePerMicrosecond,
+					sDiagnosticStatistic.average / cyclePerMicrosecond,
+					sDiagnosticStatistic.percentile50 / cyclePerMicrosecond,
+					sDiagnosticStatistic.percentile99 / cyclePerMicrosecond,
+					sDiagnosticStatistic.maximum / cyclePerMicrosecond);
+		}
+	}
+	// Edge to display per key / screen, budget check
+	for(i = 0; DiagnosticGetDisplayStatistic(i, &key, &screen, &sDiagnosticStatistic); i++)
+	{
+		printf("Key %u screen %u: n %lu p50 %lu p90 %lu p99 %lu max %lu us, over %u ms %lu\n",
+				key, screen,
+				sDiagnosticStatistic.count,
+				sDiagnosticStatistic.percentile50 / cyclePerMicrosecond,
+				sDiagnosticStatistic.percentile90 / cyclePerMicrosecond,
+				sDiagnosticStatistic.percentile99 / cyclePerMicrosecond,
+				sDiagnosticStatistic.maximum / cyclePerMicrosecond,
+				DIAGNOSTIC_DISPLAY_BUDGET,
+				sDiagnosticStatistic.overBudget);
+	}
+	if(sDiagnosticPro.droppedDisplayPair > 0)
+	{
+		printf("Key screen pair dropped: %lu\n", sDiagnosticPro.droppedDisplayPair);
+	}
+}
+
+// Diagnostic function structure
+sDIAGNOSTIC sDiagnostic =
+{
+	DiagnosticInitialize,
+	DiagnosticEdgeDetected,
+	DiagnosticFlagRaised,
+	DiagnosticHandlerStart,
+	DiagnosticHandlerEnd,
+	DiagnosticWakeup,
+	DiagnosticDisplayStart,
+	DiagnosticDisplayWritten,
+	DiagnosticDisplayEnd,
+	DiagnosticGetStatistic,
+	DiagnosticGetDisplayStatistic,
+	DiagnosticPrint,
+};
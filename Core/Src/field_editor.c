@@ -0,0 +1,986 @@
+/*******************************************************************************
+ * Filename:			field_editor.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Typed field editor, edit one field in place on LCD
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "field_editor.h"
+#include "lcd.h"
+#include "menu_list.h"
+#include "predictive_text.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// First editable digit, date keep century "20"
+#define FIELD_DATE_FIRST_DIGIT	2
+#define FIELD_TIME_FIRST_DIGIT	0
+// LCD address is not known after a whole line write
+#define FIELD_LCD_CURSOR_UNKNOWN	0xFF
+
+/*******************************************************************************
+ * LOCAL VARIBLES
+ ******************************************************************************/
+// Multi-tap character cycle of key '0' - '9', each tap show next character
+static const char* const multiTapTable[maximumCharacterSet][10] =
+{
+	// CHARACTER_SET_UPPER
+	{"0 ", "1", "ABC2", "DEF3", "GHI4", "JKL5", "MNO6", "PQRS7", "TUV8", "WXYZ9"},
+	// CHARACTER_SET_ALPHANUMERIC
+	{"0 !\"#$%&'()*+,-./", "1:;<=>?@[\\]^_`{|}~", "abcABC2", "defDEF3", "ghiGHI4", "jklJKL5", "mnoMNO6", "pqrsPQRS7", "tuvTUV8", "wxyzWXYZ9"},
+	// CHARACTER_SET_SYMBOL
+	{" 0", ".,:;1", "!?'\"2", "#$%&3", "()[]4", "{}<>5", "+-*/6", "=_|\\7", "@^~`8", "9"},
+};
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define field editor property structure
+typedef struct
+{
+	const sFIELD *psField;
+	uint8_t tapTimerId;
+	uint8_t line;
+	uint8_t position;
+	uint8_t cursor;
+	// Integer digit typed since open or last step
+	bool isTyping;
+	// Digit typed by a key which is also Up / Down, its held repeat step
+	// the value before the digit or the date / time digit it typed
+	bool isStepPending;
+	uint8_t stepCursor;
+	int32_t stepValue;
+	// Integer and fixed point raw value, enum index
+	int32_t value;
+	// Multi-tap key shown at cursor and not yet accepted, tap count of it
+	char pendingDigit;
+	uint8_t tapCounter;
+	uint8_t eCharacterSet;
+	// Predictive mode, word being typed start at wordStart, trie node of
+	// each key typed so Exit can step back
+	bool isPredictive;
+	uint8_t wordStart;
+	uint8_t keyCounter;
+	uint8_t wordRank;
+	// Digit key whose press took Function C and the rank before it, its
+	// long press restore the rank
+	char rankDigit;
+	uint8_t rankBefore;
+	uint16_t predictiveNode[FIELD_MAX_LENGTH + 1];
+	// Field index of LCD address counter
+	uint8_t lcdCursor;
+	char text[FIELD_MAX_LENGTH + 1];
+	// Character on LCD, only changed character is written
+	char shown[FIELD_MAX_LENGTH];
+}
+sFIELD_EDITOR_PRO;
+static sFIELD_EDITOR_PRO sFieldEditorPro;
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+static char FieldEditorCharacter(uint8_t index);
+static void FieldEditorDraw(void);
+static void FieldEditorFormat(void);
+static int32_t FieldEditorParse(const char *value);
+static uint8_t FieldEditorGetPair(uint8_t index);
+static void FieldEditorSetPair(uint8_t index, uint8_t data);
+static void FieldEditorClampDateTime(void);
+static bool FieldEditorIsEditable(uint8_t index);
+static bool FieldEditorIsStepRepeat(const sKEY_MAP_ENTRY *psKeyMapEntry);
+static eFIELD_RESULT FieldEditorNumberKey(const sKEY_MAP_ENTRY *psKeyMapEntry);
+static eFIELD_RESULT FieldEditorEnumKey(const sKEY_MAP_ENTRY *psKeyMapEntry);
+static eFIELD_RESULT FieldEditorStringKey(const sKEY_MAP_ENTRY *psKeyMapEntry);
+static void FieldEditorAcceptTap(void);
+static eFIELD_RESULT FieldEditorTextKey(const sKEY_MAP_ENTRY *psKeyMapEntry);
+static void FieldEditorShowWord(void);
+static void FieldEditorAcceptWord(void);
+static eFIELD_RESULT FieldEditorPredictiveKey(const sKEY_MAP_ENTRY *psKeyMapEntry);
+static eFIELD_RESULT FieldEditorDateTimeKey(const sKEY_MAP_ENTRY *psKeyMapEntry);
+
+/*******************************************************************************
+ * @fn      FieldEditorCharacter
+ * @brief   Character to show at field index
+ * @paramz  index
+ * @return  Character, ' ' after end of text
+ ******************************************************************************/
+static char FieldEditorCharacter(uint8_t index)
+{
+	if(index >= strlen(sFieldEditorPro.text))
+	{
+		return ' ';
+	}
+	if(sFieldEditorPro.psField->isHidden)
+	{
+		return HIDDEN_SYMBOL;
+	}
+	return sFieldEditorPro.text[index];
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorDraw
+ * @brief   Write changed character of field only, then place cursor
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void FieldEditorDraw(void)
+{
+	uint8_t i = 0;
+	char character;
+
+	for(i = 0; i < FIELD_MAX_LENGTH && (sFieldEditorPro.position + i) < LCD_MAX_DISPLAY_LENGTH; i++)
+	{
+		character = FieldEditorCharacter(i);
+		if(sFieldEditorPro.shown[i] != character)
+		{
+			// Address counter move right after write, set address only when needed
+			if(sFieldEditorPro.lcdCursor == i)
+			{
+				sLcd.WriteCharacter(character);
+			}
+			else
+			{
+				sLcd.WriteCharacterTo(sFieldEditorPro.line, sFieldEditorPro.position + i, character);
+			}
+			sFieldEditorPro.shown[i] = character;
+			sFieldEditorPro.lcdCursor = i + 1;
+		}
+	}
+	if(sFieldEditorPro.psField->eFieldType != FIELD_ENUM && sFieldEditorPro.lcdCursor != sFieldEditorPro.cursor)
+	{
+		sLcd.GoTo(sFieldEditorPro.line, sFieldEditorPro.position + sFieldEditorPro.cursor);
+		sFieldEditorPro.lcdCursor = sFieldEditorPro.cursor;
+	}
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorFormat
+ * @brief   Integer, fixed point and enum value to text
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void FieldEditorFormat(void)
+{
+	const sFIELD *psField = sFieldEditorPro.psField;
+	int32_t scale = 1;
+	int32_t magnitude = (sFieldEditorPro.value < 0) ? -sFieldEditorPro.value : sFieldEditorPro.value;
+	uint8_t i = 0;
+
+	switch(psField->eFieldType)
+	{
+		case FIELD_INTEGER:
+			snprintf(sFieldEditorPro.text, sizeof(sFieldEditorPro.text), "%ld", sFieldEditorPro.value);
+			break;
+		case FIELD_FIXED_POINT:
+			for(i = 0; i < psField->decimal; i++)
+			{
+				scale *= 10;
+			}
+			snprintf(sFieldEditorPro.text, sizeof(sFieldEditorPro.text), "%s%ld.%0*ld", (sFieldEditorPro.value < 0) ? "-" : "",
+					magnitude / scale, psField->decimal, magnitude % scale);
+			break;
+		case FIELD_ENUM:
+			snprintf(sFieldEditorPro.text, sizeof(sFieldEditorPro.text), "%s", psField->GetEnumText(sFieldEditorPro.value));
+			break;
+		default:
+			break;
+	}
+	sFieldEditorPro.cursor = strlen(sFieldEditorPro.text);
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorParse
+ * @brief   Text to integer or fixed point raw value
+ * @paramz  value
+ * @return  Raw value
+ ******************************************************************************/
+static int32_t FieldEditorParse(const char *value)
+{
+	char *end;
+	int32_t data = strtol(value, &end, 10);
+	uint8_t i = 0;
+	bool isFraction = (*end == '.');
+
+	if(sFieldEditorPro.psField->eFieldType != FIELD_FIXED_POINT)
+	{
+		return data;
+	}
+	for(i = 0; i < sFieldEditorPro.psField->decimal; i++)
+	{
+		data *= 10;
+		if(isFraction && end[1 + i] >= '0' && end[1 + i] <= '9')
+		{
+			data += (value[0] == '-') ? -(end[1 + i] - '0') : (end[1 + i] - '0');
+		}
+		else
+		{
+			isFraction = false;
+		}
+	}
+	return data;
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorGetPair
+ * @brief   Two digits of date or time
+ * @paramz  index		Text index of first digit
+ * @return  Two digits value
+ ******************************************************************************/
+static uint8_t FieldEditorGetPair(uint8_t index)
+{
+	return ((sFieldEditorPro.text[index] - '0') * 10) + (sFieldEditorPro.text[index + 1] - '0');
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorSetPair
+ * @brief   Set two digits of date or time
+ * @paramz  index		Text index of first digit
+ * 			data
+ * @return  None
+ ******************************************************************************/
+static void FieldEditorSetPair(uint8_t index, uint8_t data)
+{
+	sFieldEditorPro.text[index] = '0' + (data / 10);
+	sFieldEditorPro.text[index + 1] = '0' + (data % 10);
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorClampDateTime
+ * @brief   Keep every part of date or time in range after a digit change
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void FieldEditorClampDateTime(void)
+{
+	static const uint8_t lastDate[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	uint8_t year;
+	uint8_t month;
+	uint8_t date;
+	uint8_t maximumDate;
+
+	if(sFieldEditorPro.psField->eFieldType == FIELD_DATE)
+	{
+		// 20YY-MM-DD
+		year = FieldEditorGetPair(2);
+		month = FieldEditorGetPair(5);
+		date = FieldEditorGetPair(8);
+		month = (month < 1) ? 1 : (month > 12) ? 12 : month;
+		maximumDate = lastDate[month - 1] + ((month == 2 && (year % 4) == 0) ? 1 : 0);
+		date = (date < 1) ? 1 : (date > maximumDate) ? maximumDate : date;
+		FieldEditorSetPair(5, month);
+		FieldEditorSetPair(8, date);
+	}
+	else
+	{
+		// HH:MM:SS
+		if(FieldEditorGetPair(0) > 23)
+		{
+			FieldEditorSetPair(0, 23);
+		}
+		if(FieldEditorGetPair(3) > 59)
+		{
+			FieldEditorSetPair(3, 59);
+		}
+		if(FieldEditorGetPair(6) > 59)
+		{
+			FieldEditorSetPair(6, 59);
+		}
+	}
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorIsEditable
+ * @brief   Check date or time text index is an editable digit
+ * @paramz  index
+ * @return  True if editable
+ ******************************************************************************/
+static bool FieldEditorIsEditable(uint8_t index)
+{
+	if(sFieldEditorPro.psField->eFieldType == FIELD_DATE && index < FIELD_DATE_FIRST_DIGIT)
+	{
+		return false;
+	}
+	return sFieldEditorPro.text[index] >= '0' && sFieldEditorPro.text[index] <= '9';
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorIsStepRepeat
+ * @brief   Check key is the first held repeat of a digit key which is also
+ * 			Up / Down ('8' / '0' of 4x4 and 4x3). Press type the digit, repeat
+ * 			come without digit and should step what was there before.
+ * @paramz  psKeyMapEntry
+ * @return  True if the typed digit should be stepped instead
+ ******************************************************************************/
+static bool FieldEditorIsStepRepeat(const sKEY_MAP_ENTRY *psKeyMapEntry)
+{
+	bool isStep = (psKeyMapEntry->eKeyFunction == KEY_UP || psKeyMapEntry->eKeyFunction == KEY_DOWN);
+	bool isStepRepeat = isStep && psKeyMapEntry->digit == 0 && sFieldEditorPro.isStepPending;
+
+	// Only the press of such key arm it, any other key cancel it
+	sFieldEditorPro.isStepPending = isStep && psKeyMapEntry->digit != 0;
+	return isStepRepeat;
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorNumberKey
+ * @brief   Integer and fixed point key, digit type in, Up / Down step.
+ * 			Holding '8' / '0' of 4x4 and 4x3 step the value before the digit
+ * @paramz  psKeyMapEntry
+ * @return  Field result
+ ******************************************************************************/
+static eFIELD_RESULT FieldEditorNumberKey(const sKEY_MAP_ENTRY *psKeyMapEntry)
+{
+	const sFIELD *psField = sFieldEditorPro.psField;
+	int32_t limit = (-psField->minimum > psField->maximum) ? -psField->minimum : psField->maximum;
+	int32_t data;
+
+	if(FieldEditorIsStepRepeat(psKeyMapEntry))
+	{
+		sFieldEditorPro.value = sFieldEditorPro.stepValue;
+	}
+	if(psKeyMapEntry->digit != 0)
+	{
+		sFieldEditorPro.stepValue = sFieldEditorPro.value;
+		if(!sFieldEditorPro.isTyping)
+		{
+			sFieldEditorPro.value = 0;
+			sFieldEditorPro.isTyping = true;
+		}
+		data = (sFieldEditorPro.value * 10) + ((sFieldEditorPro.value < 0) ? -(psKeyMapEntry->digit - '0') : (psKeyMapEntry->digit - '0'));
+		// Refuse digit which can never be in range
+		if(data <= limit && -data <= limit)
+		{
+			sFieldEditorPro.value = data;
+		}
+	}
+	else
+	{
+		switch(psKeyMapEntry->eKeyFunction)
+		{
+			case KEY_UP:
+				sFieldEditorPro.value = (sFieldEditorPro.value + psField->step > psField->maximum) ? psField->maximum : sFieldEditorPro.value + psField->step;
+				sFieldEditorPro.isTyping = false;
+				break;
+			case KEY_DOWN:
+				sFieldEditorPro.value = (sFieldEditorPro.value - psField->step < psField->minimum) ? psField->minimum : sFieldEditorPro.value - psField->step;
+				sFieldEditorPro.isTyping = false;
+				break;
+			case KEY_EXIT:
+				if(!sFieldEditorPro.isTyping || sFieldEditorPro.value == 0)
+				{
+					return FIELD_CANCEL;
+				}
+				sFieldEditorPro.value /= 10;
+				break;
+			case KEY_ENTER:
+				if(psField->minimum <= sFieldEditorPro.value && sFieldEditorPro.value <= psField->maximum)
+				{
+					return FIELD_DONE;
+				}
+				sFieldEditorPro.value = (sFieldEditorPro.value < psField->minimum) ? psField->minimum : psField->maximum;
+				sFieldEditorPro.isTyping = false;
+				break;
+			default:
+				break;
+		}
+	}
+	FieldEditorFormat();
+
+	return FIELD_EDITING;
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorEnumKey
+ * @brief   Enum key, Up / Down select
+ * @paramz  psKeyMapEntry
+ * @return  Field result
+ ******************************************************************************/
+static eFIELD_RESULT FieldEditorEnumKey(const sKEY_MAP_ENTRY *psKeyMapEntry)
+{
+	switch(psKeyMapEntry->eKeyFunction)
+	{
+		case KEY_UP:
+			if(sFieldEditorPro.value > 0)
+			{
+				sFieldEditorPro.value--;
+			}
+			break;
+		case KEY_DOWN:
+			if(sFieldEditorPro.value < sFieldEditorPro.psField->maximum - 1)
+			{
+				sFieldEditorPro.value++;
+			}
+			break;
+		case KEY_EXIT:
+			return FIELD_CANCEL;
+		case KEY_ENTER:
+			return FIELD_DONE;
+		default:
+			break;
+	}
+	FieldEditorFormat();
+
+	return FIELD_EDITING;
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorStringKey
+ * @brief   String key, digit append, Exit delete
+ * @paramz  psKeyMapEntry
+ * @return  Field result
+ ******************************************************************************/
+static eFIELD_RESULT FieldEditorStringKey(const sKEY_MAP_ENTRY *psKeyMapEntry)
+{
+	uint8_t length = strlen(sFieldEditorPro.text);
+
+	if(psKeyMapEntry->digit != 0)
+	{
+		if(length < sFieldEditorPro.psField->maximum)
+		{
+			sFieldEditorPro.text[length++] = psKeyMapEntry->digit;
+			sFieldEditorPro.text[length] = 0;
+		}
+	}
+	else if(psKeyMapEntry->eKeyFunction == KEY_EXIT)
+	{
+		if(length == 0)
+		{
+			return FIELD_CANCEL;
+		}
+		sFieldEditorPro.text[--length] = 0;
+	}
+	else if(psKeyMapEntry->eKeyFunction == KEY_ENTER)
+	{
+		return FIELD_DONE;
+	}
+	sFieldEditorPro.cursor = length;
+
+	return FIELD_EDITING;
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorAcceptTap
+ * @brief   Accept pending multi-tap character and move cursor right
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void FieldEditorAcceptTap(void)
+{
+	if(sFieldEditorPro.pendingDigit == 0)
+	{
+		return;
+	}
+	sSoftwareTimer.Stop(sFieldEditorPro.tapTimerId);
+	sFieldEditorPro.pendingDigit = 0;
+	sFieldEditorPro.cursor++;
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorTextKey
+ * @brief   Multi-tap text key, same digit within ALPHABET_BUTTON_DELAY show
+ * 			next character at cursor, other digit accept it first, Function B
+ * 			(long press '1' of 4x3) switch to predictive text
+ * @paramz  psKeyMapEntry
+ * @return  Field result
+ ******************************************************************************/
+static eFIELD_RESULT FieldEditorTextKey(const sKEY_MAP_ENTRY *psKeyMapEntry)
+{
+	const char *pCycle;
+
+	if(sFieldEditorPro.isPredictive)
+	{
+		return FieldEditorPredictiveKey(psKeyMapEntry);
+	}
+	if(psKeyMapEntry->digit != 0)
+	{
+		pCycle = multiTapTable[sFieldEditorPro.eCharacterSet][psKeyMapEntry->digit - '0'];
+		if(sFieldEditorPro.pendingDigit == psKeyMapEntry->digit)
+		{
+			sFieldEditorPro.tapCounter = (sFieldEditorPro.tapCounter + 1) % strlen(pCycle);
+		}
+		else
+		{
+			FieldEditorAcceptTap();
+			if(sFieldEditorPro.cursor >= sFieldEditorPro.psField->maximum)
+			{
+				return FIELD_EDITING;
+			}
+			sFieldEditorPro.pendingDigit = psKeyMapEntry->digit;
+			sFieldEditorPro.tapCounter = 0;
+		}
+		sFieldEditorPro.text[sFieldEditorPro.cursor] = pCycle[sFieldEditorPro.tapCounter];
+		sFieldEditorPro.text[sFieldEditorPro.cursor + 1] = 0;
+		sSoftwareTimer.Start(sFieldEditorPro.tapTimerId, ALPHABET_BUTTON_DELAY);
+		return FIELD_EDITING;
+	}
+	switch(psKeyMapEntry->eKeyFunction)
+	{
+		case KEY_EXIT:
+			// Drop pending character, else delete last character
+			if(sFieldEditorPro.pendingDigit != 0)
+			{
+				sSoftwareTimer.Stop(sFieldEditorPro.tapTimerId);
+				sFieldEditorPro.pendingDigit = 0;
+			}
+			else if(sFieldEditorPro.cursor > 0)
+			{
+				sFieldEditorPro.cursor--;
+			}
+			else
+			{
+				return FIELD_CANCEL;
+			}
+			sFieldEditorPro.text[sFieldEditorPro.cursor] = 0;
+			break;
+		case KEY_ENTER:
+			FieldEditorAcceptTap();
+			return FIELD_DONE;
+		case KEY_FUNCTION_A:
+			FieldEditorAcceptTap();
+			sFieldEditorPro.eCharacterSet = (sFieldEditorPro.eCharacterSet + 1) % maximumCharacterSet;
+			break;
+		case KEY_FUNCTION_B:
+			FieldEditorAcceptTap();
+			sFieldEditorPro.isPredictive = true;
+			sFieldEditorPro.wordStart = sFieldEditorPro.cursor;
+			sFieldEditorPro.keyCounter = 0;
+			sFieldEditorPro.predictiveNode[0] = PREDICTIVE_ROOT;
+			break;
+		default:
+			break;
+	}
+
+	return FIELD_EDITING;
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorShowWord
+ * @brief   Write word of typed keys after wordStart, in capital letter when
+ * 			upper character set
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void FieldEditorShowWord(void)
+{
+	uint16_t node = sFieldEditorPro.predictiveNode[sFieldEditorPro.keyCounter];
+	const char *pWord = sPredictiveText.GetWord(node, sFieldEditorPro.wordRank);
+	char *pText = &sFieldEditorPro.text[sFieldEditorPro.wordStart];
+	uint8_t i = 0;
+
+	// Sequence not yet a word, show its letter in a longer word
+	if(pWord == NULL)
+	{
+		pWord = sPredictiveText.GetCompletion(node);
+	}
+	for(i = 0; i < sFieldEditorPro.keyCounter; i++)
+	{
+		pText[i] = (sFieldEditorPro.eCharacterSet == CHARACTER_SET_UPPER) ? pWord[i] - ('a' - 'A') : pWord[i];
+	}
+	pText[i] = 0;
+	sFieldEditorPro.cursor = sFieldEditorPro.wordStart + i;
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorAcceptWord
+ * @brief   Keep shown word and start next word at cursor
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void FieldEditorAcceptWord(void)
+{
+	sFieldEditorPro.wordStart = sFieldEditorPro.cursor;
+	sFieldEditorPro.keyCounter = 0;
+	sFieldEditorPro.wordRank = 0;
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorPredictiveKey
+ * @brief   Predictive text key, one key per letter, '2' - '9' extend word,
+ * 			'0' accept word and add space, '1' accept word, Function C show
+ * 			next word of same keys, Function B back to multi-tap. Function C
+ * 			is tested before digit, '1' of 4x3 is also Function C.
+ * @paramz  psKeyMapEntry
+ * @return  Field result
+ ******************************************************************************/
+static eFIELD_RESULT FieldEditorPredictiveKey(const sKEY_MAP_ENTRY *psKeyMapEntry)
+{
+	uint16_t node;
+
+	sFieldEditorPro.rankDigit = 0;
+	if(psKeyMapEntry->eKeyFunction == KEY_FUNCTION_C)
+	{
+		if(sFieldEditorPro.keyCounter > 0)
+		{
+			sFieldEditorPro.rankDigit = psKeyMapEntry->digit;
+			sFieldEditorPro.rankBefore = sFieldEditorPro.wordRank;
+			sFieldEditorPro.wordRank++;
+			FieldEditorShowWord();
+		}
+		return FIELD_EDITING;
+	}
+	if(psKeyMapEntry->digit >= '2')
+	{
+		node = sPredictiveText.Next(sFieldEditorPro.predictiveNode[sFieldEditorPro.keyCounter], psKeyMapEntry->digit);
+		// Refuse key start no word in dictionary
+		if(node != PREDICTIVE_NO_NODE && sFieldEditorPro.cursor < sFieldEditorPro.psField->maximum)
+		{
+			sFieldEditorPro.predictiveNode[++sFieldEditorPro.keyCounter] = node;
+			sFieldEditorPro.wordRank = 0;
+			FieldEditorShowWord();
+		}
+		return FIELD_EDITING;
+	}
+	if(psKeyMapEntry->digit != 0)
+	{
+		FieldEditorAcceptWord();
+		if(psKeyMapEntry->digit == '0' && sFieldEditorPro.cursor < sFieldEditorPro.psField->maximum)
+		{
+			sFieldEditorPro.text[sFieldEditorPro.cursor++] = ' ';
+			sFieldEditorPro.text[sFieldEditorPro.cursor] = 0;
+			sFieldEditorPro.wordStart = sFieldEditorPro.cursor;
+		}
+		return FIELD_EDITING;
+	}
+	switch(psKeyMapEntry->eKeyFunction)
+	{
+		case KEY_EXIT:
+			// Drop last key of word, else delete last character
+			if(sFieldEditorPro.keyCounter > 0)
+			{
+				sFieldEditorPro.keyCounter--;
+				sFieldEditorPro.wordRank = 0;
+				FieldEditorShowWord();
+			}
+			else if(sFieldEditorPro.cursor > 0)
+			{
+				sFieldEditorPro.text[--sFieldEditorPro.cursor] = 0;
+				sFieldEditorPro.wordStart = sFieldEditorPro.cursor;
+			}
+			else
+			{
+				return FIELD_CANCEL;
+			}
+			break;
+		case KEY_ENTER:
+			FieldEditorAcceptWord();
+			return FIELD_DONE;
+		case KEY_FUNCTION_A:
+			sFieldEditorPro.eCharacterSet = (sFieldEditorPro.eCharacterSet + 1) % maximumCharacterSet;
+			FieldEditorShowWord();
+			break;
+		case KEY_FUNCTION_B:
+			FieldEditorAcceptWord();
+			sFieldEditorPro.isPredictive = false;
+			break;
+		default:
+			break;
+	}
+
+	return FIELD_EDITING;
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorDateTimeKey
+ * @brief   Date and time key, digit overwrite and move right, Up / Down
+ * 			change digit, Exit move left. Holding '8' / '0' of 4x4 and 4x3
+ * 			type the digit then step it
+ * @paramz  psKeyMapEntry
+ * @return  Field result
+ ******************************************************************************/
+static eFIELD_RESULT FieldEditorDateTimeKey(const sKEY_MAP_ENTRY *psKeyMapEntry)
+{
+	uint8_t cursor = sFieldEditorPro.cursor;
+	char *pDigit;
+
+	if(FieldEditorIsStepRepeat(psKeyMapEntry))
+	{
+		cursor = sFieldEditorPro.stepCursor;
+		sFieldEditorPro.cursor = cursor;
+	}
+	pDigit = &sFieldEditorPro.text[cursor];
+	if(psKeyMapEntry->digit != 0)
+	{
+		*pDigit = psKeyMapEntry->digit;
+		FieldEditorClampDateTime();
+		sFieldEditorPro.stepCursor = cursor;
+		// Move to next digit, stay at last digit
+		for(cursor++; sFieldEditorPro.text[cursor] != 0 && !FieldEditorIsEditable(cursor); cursor++);
+		if(sFieldEditorPro.text[cursor] != 0)
+		{
+			sFieldEditorPro.cursor = cursor;
+		}
+		return FIELD_EDITING;
+	}
+	switch(psKeyMapEntry->eKeyFunction)
+	{
+		case KEY_UP:
+			*pDigit = (*pDigit == '9') ? '0' : *pDigit + 1;
+			FieldEditorClampDateTime();
+			break;
+		case KEY_DOWN:
+			*pDigit = (*pDigit == '0') ? '9' : *pDigit - 1;
+			FieldEditorClampDateTime();
+			break;
+		case KEY_EXIT:
+			// Move to previous digit, cancel at first digit
+			while(cursor > 0)
+			{
+				if(FieldEditorIsEditable(--cursor))
+				{
+					sFieldEditorPro.cursor = cursor;
+					return FIELD_EDITING;
+				}
+			}
+			return FIELD_CANCEL;
+		case KEY_ENTER:
+			return FIELD_DONE;
+		default:
+			break;
+	}
+
+	return FIELD_EDITING;
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+static void FieldEditorInitialize(SOFTWARE_TIMER_CALLBACK tapTimerCallback);
+static void FieldEditorOpen(const sFIELD *psField, uint8_t line, uint8_t position, const char *value);
+static eFIELD_RESULT FieldEditorKey(const sKEY_MAP_ENTRY *psKeyMapEntry);
+static eFIELD_RESULT FieldEditorLongKey(const sKEY_MAP_ENTRY *psKeyMapEntry);
+static void FieldEditorTapTimeout(void);
+static const char* FieldEditorGetText(void);
+static int32_t FieldEditorGetValue(void);
+static void FieldEditorClose(void);
+
+/*******************************************************************************
+ * @fn      FieldEditorInitialize
+ * @brief   Field editor initialize
+ * @param   tapTimerCallback	Called from timer interrupt when multi-tap
+ * 								delay expired, should end in TapTimeout
+ * @return  None
+ ******************************************************************************/
+static void FieldEditorInitialize(SOFTWARE_TIMER_CALLBACK tapTimerCallback)
+{
+	sFieldEditorPro.tapTimerId = sSoftwareTimer.Initialize(NULL, tapTimerCallback, NULL, TIMER_ONCE_TYPE);
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorOpen
+ * @brief   Start edit a field, the whole line is written once here
+ * @param   psField		Field, must stay valid until close
+ * 			line
+ * 			position
+ * 			value		Current text of field
+ * @return  None
+ ******************************************************************************/
+static void FieldEditorOpen(const sFIELD *psField, uint8_t line, uint8_t position, const char *value)
+{
+	uint8_t i = 0;
+	char display[FIELD_MAX_LENGTH + 1];
+
+	sFieldEditorPro.psField = psField;
+	sFieldEditorPro.line = line;
+	sFieldEditorPro.position = position;
+	sFieldEditorPro.isTyping = false;
+	sFieldEditorPro.isStepPending = false;
+	sFieldEditorPro.value = 0;
+	sFieldEditorPro.pendingDigit = 0;
+	sFieldEditorPro.eCharacterSet = psField->eCharacterSet;
+	sFieldEditorPro.isPredictive = false;
+	sFieldEditorPro.rankDigit = 0;
+	switch(psField->eFieldType)
+	{
+		case FIELD_INTEGER:
+		case FIELD_FIXED_POINT:
+			sFieldEditorPro.value = FieldEditorParse(value);
+			if(sFieldEditorPro.value < psField->minimum)
+			{
+				sFieldEditorPro.value = psField->minimum;
+			}
+			else if(sFieldEditorPro.value > psField->maximum)
+			{
+				sFieldEditorPro.value = psField->maximum;
+			}
+			FieldEditorFormat();
+			break;
+		case FIELD_ENUM:
+			for(i = 0; i < psField->maximum; i++)
+			{
+				if(strcmp(psField->GetEnumText(i), value) == 0)
+				{
+					sFieldEditorPro.value = i;
+					break;
+				}
+			}
+			FieldEditorFormat();
+			break;
+		case FIELD_STRING:
+		case FIELD_TEXT:
+			// Masked string is never shown again
+			snprintf(sFieldEditorPro.text, psField->maximum + 1, "%s", psField->isHidden ? "" : value);
+			sFieldEditorPro.cursor = strlen(sFieldEditorPro.text);
+			break;
+		case FIELD_DATE:
+			snprintf(sFieldEditorPro.text, sizeof(sFieldEditorPro.text), "%s", (strlen(value) == 10) ? value : "2000-01-01");
+			FieldEditorClampDateTime();
+			sFieldEditorPro.cursor = FIELD_DATE_FIRST_DIGIT;
+			break;
+		case FIELD_TIME:
+			snprintf(sFieldEditorPro.text, sizeof(sFieldEditorPro.text), "%s", (strlen(value) == 8) ? value : "00:00:00");
+			FieldEditorClampDateTime();
+			sFieldEditorPro.cursor = FIELD_TIME_FIRST_DIGIT;
+			break;
+		default:
+			break;
+	}
+	// Whole line once, then changed character only
+	for(i = 0; i < FIELD_MAX_LENGTH; i++)
+	{
+		sFieldEditorPro.shown[i] = FieldEditorCharacter(i);
+	}
+	snprintf(display, sizeof(display), "%.*s", (int)strlen(sFieldEditorPro.text), sFieldEditorPro.shown);
+	sLcd.WriteString(line, position, display, LCD_ALIGN_LEFT);
+	sFieldEditorPro.lcdCursor = FIELD_LCD_CURSOR_UNKNOWN;
+	if(psField->eFieldType != FIELD_ENUM)
+	{
+		sLcd.SetAttribute(1, CURSOR_ON_TYPE);
+	}
+	FieldEditorDraw();
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorKey
+ * @brief   Field editor receive key, redraw edited field only
+ * @param   psKeyMapEntry
+ * @return  FIELD_EDITING, FIELD_DONE or FIELD_CANCEL
+ ******************************************************************************/
+static eFIELD_RESULT FieldEditorKey(const sKEY_MAP_ENTRY *psKeyMapEntry)
+{
+	eFIELD_RESULT eFieldResult = FIELD_EDITING;
+
+	switch(sFieldEditorPro.psField->eFieldType)
+	{
+		case FIELD_INTEGER:
+		case FIELD_FIXED_POINT:
+			eFieldResult = FieldEditorNumberKey(psKeyMapEntry);
+			break;
+		case FIELD_ENUM:
+			eFieldResult = FieldEditorEnumKey(psKeyMapEntry);
+			break;
+		case FIELD_STRING:
+			eFieldResult = FieldEditorStringKey(psKeyMapEntry);
+			break;
+		case FIELD_TEXT:
+			eFieldResult = FieldEditorTextKey(psKeyMapEntry);
+			break;
+		case FIELD_DATE:
+		case FIELD_TIME:
+			eFieldResult = FieldEditorDateTimeKey(psKeyMapEntry);
+			break;
+		default:
+			break;
+	}
+	if(eFieldResult == FIELD_EDITING)
+	{
+		FieldEditorDraw();
+	}
+
+	return eFieldResult;
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorLongKey
+ * @brief   Field editor receive long press of held key, multi-tap character
+ * 			or next word its press left is undone, then its long press
+ * 			function is taken as a key
+ * @param   psKeyMapEntry	Entry of held key
+ * @return  FIELD_EDITING, FIELD_DONE or FIELD_CANCEL
+ ******************************************************************************/
+static eFIELD_RESULT FieldEditorLongKey(const sKEY_MAP_ENTRY *psKeyMapEntry)
+{
+	sKEY_MAP_ENTRY sKeyMapEntry = {0, psKeyMapEntry->eLongKeyFunction, KEY_NONE};
+
+	if(sFieldEditorPro.pendingDigit != 0 && sFieldEditorPro.pendingDigit == psKeyMapEntry->digit)
+	{
+		sSoftwareTimer.Stop(sFieldEditorPro.tapTimerId);
+		sFieldEditorPro.pendingDigit = 0;
+		sFieldEditorPro.text[sFieldEditorPro.cursor] = 0;
+	}
+	if(sFieldEditorPro.isPredictive && sFieldEditorPro.rankDigit != 0 && sFieldEditorPro.rankDigit == psKeyMapEntry->digit)
+	{
+		sFieldEditorPro.wordRank = sFieldEditorPro.rankBefore;
+		FieldEditorShowWord();
+	}
+	sFieldEditorPro.rankDigit = 0;
+
+	return FieldEditorKey(&sKeyMapEntry);
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorTapTimeout
+ * @brief   Multi-tap delay expired, accept pending character
+ * @param   None
+ * @return  None
+ ******************************************************************************/
+static void FieldEditorTapTimeout(void)
+{
+	if(sFieldEditorPro.pendingDigit == 0)
+	{
+		return;
+	}
+	FieldEditorAcceptTap();
+	FieldEditorDraw();
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorGetText
+ * @brief   Field editor get edited text
+ * @param   None
+ * @return  Text
+ ******************************************************************************/
+static const char* FieldEditorGetText(void)
+{
+	return sFieldEditorPro.text;
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorGetValue
+ * @brief   Field editor get edited value
+ * @param   None
+ * @return  Integer / fixed point raw value or enum index
+ ******************************************************************************/
+static int32_t FieldEditorGetValue(void)
+{
+	return sFieldEditorPro.value;
+}
+
+/*******************************************************************************
+ * @fn      FieldEditorClose
+ * @brief   Field editor close
+ * @param   None
+ * @return  None
+ ******************************************************************************/
+static void FieldEditorClose(void)
+{
+	sSoftwareTimer.Stop(sFieldEditorPro.tapTimerId);
+	sFieldEditorPro.pendingDigit = 0;
+	sLcd.SetAttribute(1, CURSOR_OFF_TYPE);
+}
+
+// Field editor function structure
+sFIELD_EDITOR sFieldEditor =
+{
+	FieldEditorInitialize,
+	FieldEditorOpen,
+	FieldEditorKey,
+	FieldEditorLongKey,
+	FieldEditorTapTimeout,
+	FieldEditorGetText,
+	FieldEditorGetValue,
+	FieldEditorClose,
+};
@@ -0,0 +1,632 @@
+/*******************************************************************************
+ * Filename:			flash_store.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Key value log in last two flash pages
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "flash_store.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// Last two pages of bank 2, code run from bank 1 is not stalled while
+// they are erased or programmed. Linker script leave them out of FLASH.
+#define FLASH_STORE_BANK				FLASH_BANK_2
+#define FLASH_STORE_PAGE_COUNT			2
+#define FLASH_STORE_FIRST_PAGE			((FLASH_BANK_SIZE / FLASH_PAGE_SIZE) - FLASH_STORE_PAGE_COUNT)
+#define FLASH_STORE_ADDRESS(page)		(FLASH_BASE + FLASH_BANK_SIZE + ((FLASH_STORE_FIRST_PAGE + (page)) * FLASH_PAGE_SIZE))
+// Page header double word, "STOR" and compaction sequence
+#define FLASH_STORE_MAGIC				0x524F5453
+#define FLASH_STORE_HEADER_SIZE			8
+// Record is key, length, CRC16 and value padded to double word, key of
+// erased flash mark end of log
+#define FLASH_STORE_RECORD_HEADER		4
+#define FLASH_STORE_RECORD_SIZE(length)	((((length) + FLASH_STORE_RECORD_HEADER + 7) / 8) * 8)
+#define FLASH_STORE_ERASED_KEY			0xFF
+// Compaction write every key and page header
+#define FLASH_STORE_JOB_SIZE			(((FLASH_STORE_KEY_COUNT * FLASH_STORE_RECORD_SIZE(FLASH_STORE_MAX_LENGTH)) / 8) + 1)
+
+/*******************************************************************************
+ * ENUMERATE
+ ******************************************************************************/
+// Flash store state define
+typedef enum
+{
+	FLASH_STORE_IDLE = 0,
+	FLASH_STORE_ERASE,
+	FLASH_STORE_PROGRAM,
+}
+eFLASH_STORE_STATE;
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define flash store property structure
+typedef struct
+{
+	SOFTWARE_TIMER_CALLBACK eventCallback;
+	uint8_t flushTimerId;
+	volatile bool isFlushDue;
+	volatile bool isOperationEnd;
+	volatile bool isOperationError;
+	// Read of a double word with bad ECC raised NMI
+	volatile bool isEccError;
+	uint8_t eFlashStoreState;
+	// Active page 0 / 1, its sequence and first free offset
+	uint8_t activePage;
+	uint32_t sequence;
+	uint16_t writeOffset;
+	// RAM index, offset of latest record of each key in active page, 0 if none
+	uint16_t index[FLASH_STORE_KEY_COUNT];
+	// Latest written value of each key, cached / not yet in flash bit per key
+	uint8_t value[FLASH_STORE_KEY_COUNT][FLASH_STORE_MAX_LENGTH];
+	uint8_t valueLength[FLASH_STORE_KEY_COUNT];
+	uint16_t cachedKeys;
+	uint16_t dirtyKeys;
+	// Double words of flush in progress, one is programmed per end of
+	// operation interrupt. Compaction program page header last.
+	uint64_t job[FLASH_STORE_JOB_SIZE];
+	uint8_t jobCount;
+	uint8_t jobIndex;
+	uint8_t jobPage;
+	uint16_t jobOffset;
+	bool isCompaction;
+	uint16_t jobDirtyKeys;
+	uint16_t jobRecordKeys;
+	uint16_t jobRecordOffset[FLASH_STORE_KEY_COUNT];
+	sFLASH_STORE_STATISTIC sStatistic;
+}
+sFLASH_STORE_PRO;
+static sFLASH_STORE_PRO sFlashStorePro;
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+static uint16_t FlashStoreCrc(const uint8_t *record, uint8_t length);
+static const uint8_t* FlashStoreRecord(uint8_t page, uint16_t offset);
+static uint16_t FlashStoreScan(uint8_t page);
+static void FlashStoreAddRecord(uint8_t key, const uint8_t *data, uint8_t length);
+static void FlashStoreStart(void);
+static void FlashStoreProgram(void);
+static void FlashStoreFinish(void);
+static void FlashStoreAbort(void);
+static void FlashStoreTimerCallback(uint8_t softwareTimerId);
+
+/*******************************************************************************
+ * @fn      FlashStoreCrc
+ * @brief   CRC16 CCITT of record key, length and value
+ * @paramz  record		Record, CRC field is skipped
+ * 			length		Value length
+ * @return  CRC
+ ******************************************************************************/
+static uint16_t FlashStoreCrc(const uint8_t *record, uint8_t length)
+{
+	uint16_t crc = 0xFFFF;
+	uint8_t i = 0;
+	uint8_t bit;
+	uint8_t data;
+
+	for(i = 0; i < FLASH_STORE_RECORD_HEADER + length; i++)
+	{
+		// Skip CRC field
+		if(i == 2 || i == 3)
+		{
+			continue;
+		}
+		data = record[i];
+		crc ^= (uint16_t)data << 8;
+		for(bit = 0; bit < 8; bit++)
+		{
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+		}
+	}
+
+	return crc;
+}
+
+/*******************************************************************************
+ * @fn      FlashStoreRecord
+ * @brief   Record in flash
+ * @paramz  page
+ * 			offset
+ * @return  Record
+ ******************************************************************************/
+static const uint8_t* FlashStoreRecord(uint8_t page, uint16_t offset)
+{
+	return (const uint8_t*)(FLASH_STORE_ADDRESS(page) + offset);
+}
+
+/*******************************************************************************
+ * @fn      FlashStoreScan
+ * @brief   Build RAM index in one pass, later record of a key replace the
+ * 			earlier one, record with bad CRC is skipped, scan stop at double
+ * 			word with bad ECC
+ * @paramz  page
+ * @return  First free offset, FLASH_PAGE_SIZE if log is broken so next flush
+ * 			compact to the other page
+ ******************************************************************************/
+static uint16_t FlashStoreScan(uint8_t page)
+{
+	const uint8_t *record;
+	uint16_t offset = FLASH_STORE_HEADER_SIZE;
+	uint16_t size;
+	uint8_t key;
+	bool isValid;
+
+	while(offset < FLASH_PAGE_SIZE)
+	{
+		record = FlashStoreRecord(page, offset);
+		key = record[0];
+		// Power cut in a double word program leave bad ECC, its read raise
+		// NMI and the word read is not trusted even if it look erased
+		if(sFlashStorePro.isEccError)
+		{
+			return FLASH_PAGE_SIZE;
+		}
+		if(key == FLASH_STORE_ERASED_KEY)
+		{
+			return offset;
+		}
+		size = FLASH_STORE_RECORD_SIZE(record[1]);
+		if(key >= FLASH_STORE_KEY_COUNT || record[1] > FLASH_STORE_MAX_LENGTH || offset + size > FLASH_PAGE_SIZE)
+		{
+			return FLASH_PAGE_SIZE;
+		}
+		isValid = FlashStoreCrc(record, record[1]) == (record[2] | (record[3] << 8));
+		if(sFlashStorePro.isEccError)
+		{
+			return FLASH_PAGE_SIZE;
+		}
+		// Interrupted write leave a record with bad CRC, keep the older one
+		if(isValid)
+		{
+			sFlashStorePro.index[key] = offset;
+		}
+		offset += size;
+	}
+
+	return offset;
+}
+
+/*******************************************************************************
+ * @fn      FlashStoreAddRecord
+ * @brief   Append record to flush job
+ * @paramz  key
+ * 			data
+ * 			length
+ * @return  None
+ ******************************************************************************/
+static void FlashStoreAddRecord(uint8_t key, const uint8_t *data, uint8_t length)
+{
+	uint8_t record[FLASH_STORE_RECORD_SIZE(FLASH_STORE_MAX_LENGTH)];
+	uint8_t size = FLASH_STORE_RECORD_SIZE(length);
+	uint16_t crc;
+
+	memset(record, 0xFF, sizeof(record));
+	record[0] = key;
+	record[1] = length;
+	memcpy(&record[FLASH_STORE_RECORD_HEADER], data, length);
+	crc = FlashStoreCrc(record, length);
+	record[2] = crc & 0xFF;
+	record[3] = crc >> 8;
+	sFlashStorePro.jobRecordKeys |= (0x01 << key);
+	sFlashStorePro.jobRecordOffset[key] = sFlashStorePro.jobOffset + (sFlashStorePro.jobCount * 8);
+	memcpy(&sFlashStorePro.job[sFlashStorePro.jobCount], record, size);
+	sFlashStorePro.jobCount += size / 8;
+}
+
+/*******************************************************************************
+ * @fn      FlashStoreStart
+ * @brief   Start flush, append dirty value to active page, or compact latest
+ * 			value of every key to the other page when it is full
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void FlashStoreStart(void)
+{
+	FLASH_EraseInitTypeDef sEraseInit;
+	const uint8_t *record;
+	uint16_t size = 0;
+	uint8_t key = 0;
+
+	sFlashStorePro.isFlushDue = false;
+	sFlashStorePro.jobCount = 0;
+	sFlashStorePro.jobIndex = 0;
+	sFlashStorePro.jobRecordKeys = 0;
+	sFlashStorePro.jobDirtyKeys = sFlashStorePro.dirtyKeys;
+	sFlashStorePro.dirtyKeys = 0;
+	for(key = 0; key < FLASH_STORE_KEY_COUNT; key++)
+	{
+		if(sFlashStorePro.jobDirtyKeys & (0x01 << key))
+		{
+			size += FLASH_STORE_RECORD_SIZE(sFlashStorePro.valueLength[key]);
+		}
+	}
+	sFlashStorePro.isCompaction = (sFlashStorePro.writeOffset + size > FLASH_PAGE_SIZE);
+	if(!sFlashStorePro.isCompaction)
+	{
+		sFlashStorePro.jobPage = sFlashStorePro.activePage;
+		sFlashStorePro.jobOffset = sFlashStorePro.writeOffset;
+	}
+	else
+	{
+		sFlashStorePro.jobPage = sFlashStorePro.activePage ^ 0x01;
+		sFlashStorePro.jobOffset = FLASH_STORE_HEADER_SIZE;
+	}
+	for(key = 0; key < FLASH_STORE_KEY_COUNT; key++)
+	{
+		if(sFlashStorePro.jobDirtyKeys & (0x01 << key))
+		{
+			FlashStoreAddRecord(key, sFlashStorePro.value[key], sFlashStorePro.valueLength[key]);
+		}
+		else if(sFlashStorePro.isCompaction && sFlashStorePro.index[key] != 0)
+		{
+			// Copy from active page, it is only erased by next compaction
+			record = FlashStoreRecord(sFlashStorePro.activePage, sFlashStorePro.index[key]);
+			FlashStoreAddRecord(key, &record[FLASH_STORE_RECORD_HEADER], record[1]);
+		}
+	}
+
+	HAL_FLASH_Unlock();
+	__HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+	if(!sFlashStorePro.isCompaction)
+	{
+		sFlashStorePro.eFlashStoreState = FLASH_STORE_PROGRAM;
+		FlashStoreProgram();
+		return;
+	}
+	// Page header last, new page is valid only when complete
+	sFlashStorePro.job[sFlashStorePro.jobCount++] = ((uint64_t)(sFlashStorePro.sequence + 1) << 32) | FLASH_STORE_MAGIC;
+	sFlashStorePro.sStatistic.compactionCount++;
+	sEraseInit.TypeErase = FLASH_TYPEERASE_PAGES;
+	sEraseInit.Banks = FLASH_STORE_BANK;
+	sEraseInit.Page = FLASH_STORE_FIRST_PAGE + sFlashStorePro.jobPage;
+	sEraseInit.NbPages = 1;
+	sFlashStorePro.eFlashStoreState = FLASH_STORE_ERASE;
+	if(HAL_FLASHEx_Erase_IT(&sEraseInit) != HAL_OK)
+	{
+		FlashStoreAbort();
+	}
+}
+
+/*******************************************************************************
+ * @fn      FlashStoreProgram
+ * @brief   Program current double word of job, end of operation interrupt
+ * 			tell when it is done
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void FlashStoreProgram(void)
+{
+	uint32_t address = FLASH_STORE_ADDRESS(sFlashStorePro.jobPage);
+
+	if(!sFlashStorePro.isCompaction || sFlashStorePro.jobIndex < sFlashStorePro.jobCount - 1)
+	{
+		address += sFlashStorePro.jobOffset + (sFlashStorePro.jobIndex * 8);
+	}
+	sFlashStorePro.sStatistic.programBytes += 8;
+	if(HAL_FLASH_Program_IT(FLASH_TYPEPROGRAM_DOUBLEWORD, address, sFlashStorePro.job[sFlashStorePro.jobIndex]) != HAL_OK)
+	{
+		FlashStoreAbort();
+	}
+}
+
+/*******************************************************************************
+ * @fn      FlashStoreFinish
+ * @brief   Job programmed, point RAM index to new records
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void FlashStoreFinish(void)
+{
+	uint8_t key = 0;
+
+	HAL_FLASH_Lock();
+	if(sFlashStorePro.isCompaction)
+	{
+		sFlashStorePro.activePage = sFlashStorePro.jobPage;
+		sFlashStorePro.sequence++;
+		memset(sFlashStorePro.index, 0, sizeof(sFlashStorePro.index));
+		// Last double word is page header
+		sFlashStorePro.jobCount--;
+	}
+	sFlashStorePro.writeOffset = sFlashStorePro.jobOffset + (sFlashStorePro.jobCount * 8);
+	for(key = 0; key < FLASH_STORE_KEY_COUNT; key++)
+	{
+		if(sFlashStorePro.jobRecordKeys & (0x01 << key))
+		{
+			sFlashStorePro.index[key] = sFlashStorePro.jobRecordOffset[key];
+		}
+	}
+	sFlashStorePro.eFlashStoreState = FLASH_STORE_IDLE;
+}
+
+/*******************************************************************************
+ * @fn      FlashStoreAbort
+ * @brief   Flash error, keep value dirty and retry after flush delay. Append
+ * 			may leave a broken record, so next flush compact.
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void FlashStoreAbort(void)
+{
+	HAL_FLASH_Lock();
+	if(!sFlashStorePro.isCompaction)
+	{
+		sFlashStorePro.writeOffset = FLASH_PAGE_SIZE;
+	}
+	sFlashStorePro.dirtyKeys |= sFlashStorePro.jobDirtyKeys;
+	sFlashStorePro.sStatistic.errorCount++;
+	sFlashStorePro.eFlashStoreState = FLASH_STORE_IDLE;
+	sSoftwareTimer.Start(sFlashStorePro.flushTimerId, FLASH_STORE_FLUSH_DELAY);
+}
+
+/*******************************************************************************
+ * @fn      FlashStoreTimerCallback
+ * @brief   No write for flush delay, flush outside interrupt
+ * @paramz  softwareTimerId
+ * @return  None
+ ******************************************************************************/
+static void FlashStoreTimerCallback(uint8_t softwareTimerId)
+{
+	sFlashStorePro.isFlushDue = true;
+	sFlashStorePro.eventCallback(softwareTimerId);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+static void FlashStoreInitialize(SOFTWARE_TIMER_CALLBACK eventCallback);
+static uint8_t FlashStoreRead(uint8_t key, void *data, uint8_t size);
+static void FlashStoreWrite(uint8_t key, const void *data, uint8_t length);
+static void FlashStoreProcess(void);
+static void FlashStoreOperationEnd(bool isError);
+static bool FlashStoreIsIdle(void);
+static void FlashStoreEccError(void);
+static void FlashStoreGetStatistic(sFLASH_STORE_STATISTIC *psFlashStoreStatistic);
+static void FlashStorePrint(void);
+
+/*******************************************************************************
+ * @fn      FlashStoreInitialize
+ * @brief   Find active page and build RAM index
+ * @param   eventCallback	Called from interrupt when Process should run
+ * @return  None
+ ******************************************************************************/
+static void FlashStoreInitialize(SOFTWARE_TIMER_CALLBACK eventCallback)
+{
+	uint32_t cycle = CYCLE_COUNTER_GET();
+	const uint32_t *header;
+	bool isValid = false;
+	uint8_t page = 0;
+
+	memset(&sFlashStorePro, 0, sizeof(sFlashStorePro));
+	sFlashStorePro.eventCallback = eventCallback;
+	sFlashStorePro.flushTimerId = sSoftwareTimer.Initialize(NULL, FlashStoreTimerCallback, NULL, TIMER_ONCE_TYPE);
+	// Page with highest sequence, old page stay valid until next compaction
+	for(page = 0; page < FLASH_STORE_PAGE_COUNT; page++)
+	{
+		header = (const uint32_t*)FLASH_STORE_ADDRESS(page);
+		// Header cut by power loss has bad ECC, the page is not formatted
+		sFlashStorePro.isEccError = false;
+		if(header[0] == FLASH_STORE_MAGIC && !sFlashStorePro.isEccError &&
+		   (!isValid || (int32_t)(header[1] - sFlashStorePro.sequence) > 0))
+		{
+			isValid = true;
+			sFlashStorePro.activePage = page;
+			sFlashStorePro.sequence = header[1];
+		}
+	}
+	// Blank flash, first flush format the other page
+	sFlashStorePro.isEccError = false;
+	sFlashStorePro.writeOffset = isValid ? FlashStoreScan(sFlashStorePro.activePage) : FLASH_PAGE_SIZE;
+
+	HAL_NVIC_SetPriority(FLASH_IRQn, 1, 0);
+	HAL_NVIC_EnableIRQ(FLASH_IRQn);
+	sFlashStorePro.sStatistic.loadCycles = CYCLE_COUNTER_GET() - cycle;
+}
+
+/*******************************************************************************
+ * @fn      FlashStoreRead
+ * @brief   Read latest value of key
+ * @param   key
+ * 			data
+ * 			size		Size of data
+ * @return  Byte copied, 0 if key is never written
+ ******************************************************************************/
+static uint8_t FlashStoreRead(uint8_t key, void *data, uint8_t size)
+{
+	const uint8_t *value;
+	uint8_t length;
+
+	if(key >= FLASH_STORE_KEY_COUNT)
+	{
+		return 0;
+	}
+	if(sFlashStorePro.cachedKeys & (0x01 << key))
+	{
+		value = sFlashStorePro.value[key];
+		length = sFlashStorePro.valueLength[key];
+	}
+	else if(sFlashStorePro.index[key] != 0)
+	{
+		value = FlashStoreRecord(sFlashStorePro.activePage, sFlashStorePro.index[key]);
+		length = value[1];
+		value += FLASH_STORE_RECORD_HEADER;
+	}
+	else
+	{
+		return 0;
+	}
+	length = (length < size) ? length : size;
+	memcpy(data, value, length);
+
+	return length;
+}
+
+/*******************************************************************************
+ * @fn      FlashStoreWrite
+ * @brief   Keep value in RAM and return, it is programmed after no write for
+ * 			FLASH_STORE_FLUSH_DELAY, same value is not written again
+ * @param   key
+ * 			data
+ * 			length		Up to FLASH_STORE_MAX_LENGTH
+ * @return  None
+ ******************************************************************************/
+static void FlashStoreWrite(uint8_t key, const void *data, uint8_t length)
+{
+	uint8_t current[FLASH_STORE_MAX_LENGTH];
+
+	if(key >= FLASH_STORE_KEY_COUNT || length > FLASH_STORE_MAX_LENGTH)
+	{
+		return;
+	}
+	if(FlashStoreRead(key, current, sizeof(current)) == length && memcmp(current, data, length) == 0)
+	{
+		return;
+	}
+	memcpy(sFlashStorePro.value[key], data, length);
+	sFlashStorePro.valueLength[key] = length;
+	sFlashStorePro.cachedKeys |= (0x01 << key);
+	sFlashStorePro.dirtyKeys |= (0x01 << key);
+	sFlashStorePro.sStatistic.valueBytes += length;
+	sSoftwareTimer.Start(sFlashStorePro.flushTimerId, FLASH_STORE_FLUSH_DELAY);
+}
+
+/*******************************************************************************
+ * @fn      FlashStoreProcess
+ * @brief   Run flush one step, call from main loop when event callback called
+ * @param   None
+ * @return  None
+ ******************************************************************************/
+static void FlashStoreProcess(void)
+{
+	if(sFlashStorePro.eFlashStoreState != FLASH_STORE_IDLE)
+	{
+		if(!sFlashStorePro.isOperationEnd)
+		{
+			return;
+		}
+		sFlashStorePro.isOperationEnd = false;
+		if(sFlashStorePro.isOperationError)
+		{
+			sFlashStorePro.isOperationError = false;
+			FlashStoreAbort();
+			return;
+		}
+		if(sFlashStorePro.eFlashStoreState == FLASH_STORE_PROGRAM)
+		{
+			sFlashStorePro.jobIndex++;
+		}
+		if(sFlashStorePro.jobIndex < sFlashStorePro.jobCount)
+		{
+			sFlashStorePro.eFlashStoreState = FLASH_STORE_PROGRAM;
+			FlashStoreProgram();
+			return;
+		}
+		FlashStoreFinish();
+	}
+	if(sFlashStorePro.isFlushDue && sFlashStorePro.dirtyKeys != 0)
+	{
+		FlashStoreStart();
+	}
+}
+
+/*******************************************************************************
+ * @fn      FlashStoreOperationEnd
+ * @brief   Flash erase or program ended, call from flash interrupt
+ * @param   isError
+ * @return  None
+ ******************************************************************************/
+static void FlashStoreOperationEnd(bool isError)
+{
+	if(sFlashStorePro.eFlashStoreState == FLASH_STORE_IDLE)
+	{
+		return;
+	}
+	// Error and end of operation may both be reported for one operation
+	if(isError)
+	{
+		sFlashStorePro.isOperationError = true;
+	}
+	sFlashStorePro.isOperationEnd = true;
+	sFlashStorePro.eventCallback(sFlashStorePro.flushTimerId);
+}
+
+/*******************************************************************************
+ * @fn      FlashStoreIsIdle
+ * @brief   Check no erase or program is running, stop mode must wait
+ * @param   None
+ * @return  True if idle
+ ******************************************************************************/
+static bool FlashStoreIsIdle(void)
+{
+	return sFlashStorePro.eFlashStoreState == FLASH_STORE_IDLE;
+}
+
+/*******************************************************************************
+ * @fn      FlashStoreEccError
+ * @brief   Flash read found two ECC error, call from NMI. ECCD is cleared or
+ * 			NMI is raised again, log is broken so next flush compact.
+ * @param   None
+ * @return  None
+ ******************************************************************************/
+static void FlashStoreEccError(void)
+{
+	__HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ECCD);
+	sFlashStorePro.isEccError = true;
+	if(sFlashStorePro.eFlashStoreState == FLASH_STORE_IDLE)
+	{
+		sFlashStorePro.writeOffset = FLASH_PAGE_SIZE;
+	}
+	sFlashStorePro.sStatistic.errorCount++;
+}
+
+/*******************************************************************************
+ * @fn      FlashStoreGetStatistic
+ * @brief   Flash store get statistic
+ * @param   psFlashStoreStatistic
+ * @return  None
+ ******************************************************************************/
+static void FlashStoreGetStatistic(sFLASH_STORE_STATISTIC *psFlashStoreStatistic)
+{
+	*psFlashStoreStatistic = sFlashStorePro.sStatistic;
+}
+
+/*******************************************************************************
+ * @fn      FlashStorePrint
+ * @brief   Print boot load time and write amplification (programmed / value
+ * 			bytes) to SWV ITM data console
+ * @param   None
+ * @return  None
+ ******************************************************************************/
+static void FlashStorePrint(void)
+{
+	sFLASH_STORE_STATISTIC *psStatistic = &sFlashStorePro.sStatistic;
+	uint32_t amplification = (psStatistic->valueBytes != 0) ? (psStatistic->programBytes * 100) / psStatistic->valueBytes : 0;
+
+	printf("Store: load %lu us, write %lu byte, program %lu byte, amplification %lu.%02lu, compaction %u, error %u\n",
+			psStatistic->loadCycles / (SystemCoreClock / 1000000),
+			psStatistic->valueBytes,
+			psStatistic->programBytes,
+			amplification / 100, amplification % 100,
+			psStatistic->compactionCount,
+			psStatistic->errorCount);
+}
+
+// Flash store function structure
+sFLASH_STORE sFlashStore =
+{
+	FlashStoreInitialize,
+	FlashStoreRead,
+	FlashStoreWrite,
+	FlashStoreProcess,
+	FlashStoreOperationEnd,
+	FlashStoreIsIdle,
+	FlashStoreEccError,
+	FlashStoreGetStatistic,
+	FlashStorePrint,
+};
@@ -0,0 +1,505 @@
+/*******************************************************************************
+ * Filename:			kernel.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Fixed priority preemptive kernel function
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "kernel.h"
+
+#if KERNEL_ENABLE
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+#define KERNEL_START_STACK_SIZE		64
+#define KERNEL_INITIAL_XPSR			0x01000000
+// Return to thread mode, use PSP, no floating point frame
+#define KERNEL_INITIAL_EXC_RETURN	0xFFFFFFFD
+
+/*******************************************************************************
+ * ENUMERATE
+ ******************************************************************************/
+// Task state define
+typedef enum
+{
+	TASK_READY = 0,
+	TASK_DELAYED,
+	TASK_WAITING,
+}
+eTASK_STATE;
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define task control block structure, stack pointer must be the first member,
+// PendSV handler access it directly
+typedef struct
+{
+	uint32_t *stackPointer;
+	uint8_t priority;
+	eTASK_STATE eTaskState;
+	uint32_t delay;
+	uint32_t event;
+}
+sKERNEL_TCB;
+
+// Define kernel property structure
+typedef struct
+{
+	uint8_t usedTask;
+	bool isStarted;
+	sKERNEL_TCB sKernelTcb[NUM_OF_KERNEL_TASK];
+	// Context of the code calling KernelStart, saved once and never resumed
+	sKERNEL_TCB sStartTcb;
+	uint32_t startStack[KERNEL_START_STACK_SIZE];
+	uint32_t idleStack[KERNEL_IDLE_STACK_SIZE];
+	KERNEL_IDLE_CALLBACK idleCallback;
+	uint32_t contextSwitchCount;
+	uint64_t totalContextSwitchCycles;
+	uint32_t minimumContextSwitchCycles;
+	uint32_t maximumContextSwitchCycles;
+}
+sKERNEL_PRO;
+static sKERNEL_PRO sKernelPro;
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+// Shared with PendSV handler
+sKERNEL_TCB * volatile kernelCurrentTcb;
+volatile uint32_t kernelSwitchStartCycle;
+volatile uint32_t kernelSwitchEndCycle;
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+static sKERNEL_TCB* KernelGetHighestReadyTask(void);
+static void KernelRequestSwitch(void);
+static void KernelTaskExit(void);
+static void KernelIdleTask(void);
+void KernelSwitchContext(uint32_t startCycle);
+
+/*******************************************************************************
+ * @fn      KernelGetHighestReadyTask
+ * @brief   Find the ready task with highest priority, scan start after
+ *			current task so task of same priority take turn
+ * @param	None
+ * @return	Task control block
+ ******************************************************************************/
+static sKERNEL_TCB* KernelGetHighestReadyTask(void)
+{
+	uint8_t i = 0;
+	uint8_t task;
+	// Start task is not in the table, scan from first task
+	uint8_t current = (kernelCurrentTcb >= sKernelPro.sKernelTcb && kernelCurrentTcb < &sKernelPro.sKernelTcb[sKernelPro.usedTask]) ?
+					  kernelCurrentTcb - sKernelPro.sKernelTcb : sKernelPro.usedTask - 1;
+	sKERNEL_TCB *psKernelTcb = NULL;
+
+	for(i = 1; i <= sKernelPro.usedTask; i++)
+	{
+		task = (current + i) % sKernelPro.usedTask;
+		if(sKernelPro.sKernelTcb[task].eTaskState != TASK_READY)
+		{
+			continue;
+		}
+		if(psKernelTcb == NULL || sKernelPro.sKernelTcb[task].priority > psKernelTcb->priority)
+		{
+			psKernelTcb = &sKernelPro.sKernelTcb[task];
+		}
+	}
+	return psKernelTcb;
+}
+
+/*******************************************************************************
+ * @fn      KernelRequestSwitch
+ * @brief   Pend PendSV if a higher priority task is ready or current task
+ *			is blocked, call inside critical section
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+static void KernelRequestSwitch(void)
+{
+	sKERNEL_TCB *psKernelTcb;
+
+	if(!sKernelPro.isStarted)
+	{
+		return;
+	}
+	psKernelTcb = KernelGetHighestReadyTask();
+	// Task of same priority is not preempted, it yield by Delay(0)
+	if(psKernelTcb != kernelCurrentTcb && (kernelCurrentTcb->eTaskState != TASK_READY || psKernelTcb->priority > kernelCurrentTcb->priority))
+	{
+		SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+	}
+}
+
+/*******************************************************************************
+ * @fn      KernelTaskExit
+ * @brief   Task function must not return, park it forever
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+static void KernelTaskExit(void)
+{
+	for(;;)
+	{
+		sKernel.WaitEvent();
+	}
+}
+
+/*******************************************************************************
+ * @fn      KernelIdleTask
+ * @brief   Run when no other task is ready, low power mode is left to idle
+ * 			callback
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+static void KernelIdleTask(void)
+{
+	for(;;)
+	{
+		if(sKernelPro.idleCallback != NULL)
+		{
+			sKernelPro.idleCallback();
+		}
+		else
+		{
+			HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+		}
+	}
+}
+
+/*******************************************************************************
+ * @fn      KernelSwitchContext
+ * @brief   Select next task, call from PendSV handler with interrupt disabled
+ * @param	startCycle	Cycle counter at PendSV entry
+ * @return	None
+ ******************************************************************************/
+__attribute__((used)) void KernelSwitchContext(uint32_t startCycle)
+{
+	uint32_t cycles;
+
+	// Previous context switch is completed, account it
+	if(sKernelPro.contextSwitchCount > 0)
+	{
+		cycles = kernelSwitchEndCycle - kernelSwitchStartCycle;
+		sKernelPro.totalContextSwitchCycles += cycles;
+		if(cycles < sKernelPro.minimumContextSwitchCycles || sKernelPro.contextSwitchCount == 1)
+		{
+			sKernelPro.minimumContextSwitchCycles = cycles;
+		}
+		if(cycles > sKernelPro.maximumContextSwitchCycles)
+		{
+			sKernelPro.maximumContextSwitchCycles = cycles;
+		}
+	}
+	kernelSwitchStartCycle = startCycle;
+	sKernelPro.contextSwitchCount++;
+	kernelCurrentTcb = KernelGetHighestReadyTask();
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+static void KernelInitialize(KERNEL_IDLE_CALLBACK idleCallback);
+static uint8_t KernelCreateTask(KERNEL_TASK kernelTask, uint8_t priority, uint32_t *stack, uint32_t stackSize);
+static void KernelStart(void);
+static void KernelDelay(uint32_t delay);
+static uint32_t KernelWaitEvent(void);
+static void KernelSignalEvent(uint8_t taskId, uint32_t event);
+static void KernelGetStatistic(sKERNEL_STATISTIC *psKernelStatistic);
+static bool KernelIsIdle(void);
+
+/*******************************************************************************
+ * @fn      KernelInitialize
+ * @brief   Kernel initialize
+ * @param	idleCallback	NULL to sleep in idle task
+ * @return	None
+ ******************************************************************************/
+static void KernelInitialize(KERNEL_IDLE_CALLBACK idleCallback)
+{
+	CYCLE_COUNTER_ENABLE();
+	memset(&sKernelPro, 0, sizeof(sKernelPro));
+	sKernelPro.idleCallback = idleCallback;
+	KernelCreateTask(KernelIdleTask, KERNEL_IDLE_PRIORITY, sKernelPro.idleStack, KERNEL_IDLE_STACK_SIZE);
+}
+
+/*******************************************************************************
+ * @fn      KernelCreateTask
+ * @brief   Create task with its own stack
+ * @param	kernelTask
+ *			priority	Bigger value is higher priority
+ *			stack
+ *			stackSize	Number of word
+ * @return	Task ID
+ ******************************************************************************/
+static uint8_t KernelCreateTask(KERNEL_TASK kernelTask, uint8_t priority, uint32_t *stack, uint32_t stackSize)
+{
+	uint32_t *stackPointer;
+	sKERNEL_TCB *psKernelTcb;
+
+    if(sKernelPro.usedTask == NUM_OF_KERNEL_TASK)
+    {
+    	// Increase "NUM_OF_KERNEL_TASK"
+    	for(;;)
+    	{
+    	}
+    }
+	psKernelTcb = &sKernelPro.sKernelTcb[sKernelPro.usedTask];
+
+	// Stack must be 8 bytes aligned on exception entry
+	stackPointer = (uint32_t*)(((uint32_t)&stack[stackSize]) & ~0x07UL);
+	// Hardware stacked frame: R0-R3, R12, LR, PC, xPSR
+	stackPointer -= 8;
+	memset(stackPointer, 0, 8 * sizeof(uint32_t));
+	stackPointer[5] = (uint32_t)KernelTaskExit;
+	stackPointer[6] = (uint32_t)kernelTask & ~0x01UL;
+	stackPointer[7] = KERNEL_INITIAL_XPSR;
+	// Software stacked frame: R4-R11, EXC_RETURN
+	stackPointer -= 9;
+	memset(stackPointer, 0, 8 * sizeof(uint32_t));
+	stackPointer[8] = KERNEL_INITIAL_EXC_RETURN;
+
+	psKernelTcb->stackPointer = stackPointer;
+	psKernelTcb->priority = priority;
+	psKernelTcb->eTaskState = TASK_READY;
+	psKernelTcb->delay = 0;
+	psKernelTcb->event = 0;
+    sKernelPro.usedTask++;
+    return sKernelPro.usedTask - 1;
+}
+
+/*******************************************************************************
+ * @fn      KernelStart
+ * @brief   Start highest priority task, never return
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+static void KernelStart(void)
+{
+	// Context switch must not preempt any other interrupt
+	NVIC_SetPriority(PendSV_IRQn, (1UL << __NVIC_PRIO_BITS) - 1UL);
+
+	__disable_irq();
+	// First PendSV save current context to a scratch stack and never resume it
+	kernelCurrentTcb = &sKernelPro.sStartTcb;
+	__set_PSP((uint32_t)&sKernelPro.startStack[KERNEL_START_STACK_SIZE]);
+	__set_CONTROL(__get_CONTROL() | CONTROL_SPSEL_Msk);
+	__ISB();
+	sKernelPro.isStarted = true;
+	SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+	__enable_irq();
+	for(;;)
+	{
+	}
+}
+
+/*******************************************************************************
+ * @fn      KernelDelay
+ * @brief   Block current task
+ * @param	delay (ms), 0 to yield to next ready task with same priority
+ * @return	None
+ ******************************************************************************/
+static void KernelDelay(uint32_t delay)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	if(delay > 0)
+	{
+		kernelCurrentTcb->delay = delay;
+		kernelCurrentTcb->eTaskState = TASK_DELAYED;
+	}
+	SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+	__set_PRIMASK(primask);
+}
+
+/*******************************************************************************
+ * @fn      KernelWaitEvent
+ * @brief   Block current task until any event signaled
+ * @param	None
+ * @return	Signaled event
+ ******************************************************************************/
+static uint32_t KernelWaitEvent(void)
+{
+	uint32_t event = 0;
+	uint32_t primask = __get_PRIMASK();
+
+	for(;;)
+	{
+		__disable_irq();
+		if(kernelCurrentTcb->event != 0)
+		{
+			event = kernelCurrentTcb->event;
+			kernelCurrentTcb->event = 0;
+			__set_PRIMASK(primask);
+			return event;
+		}
+		kernelCurrentTcb->eTaskState = TASK_WAITING;
+		SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+		// PendSV switch out here
+		__set_PRIMASK(primask);
+	}
+}
+
+/*******************************************************************************
+ * @fn      KernelSignalEvent
+ * @brief   Signal event to task, can be called from interrupt
+ * @param	taskId
+ *			event
+ * @return	None
+ ******************************************************************************/
+static void KernelSignalEvent(uint8_t taskId, uint32_t event)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	sKernelPro.sKernelTcb[taskId].event |= event;
+	if(sKernelPro.sKernelTcb[taskId].eTaskState == TASK_WAITING)
+	{
+		sKernelPro.sKernelTcb[taskId].eTaskState = TASK_READY;
+		KernelRequestSwitch();
+	}
+	__set_PRIMASK(primask);
+}
+
+/*******************************************************************************
+ * @fn      KernelGetStatistic
+ * @brief   Get context switch statistic
+ * @param	psKernelStatistic
+ * @return	None
+ ******************************************************************************/
+static void KernelGetStatistic(sKERNEL_STATISTIC *psKernelStatistic)
+{
+	uint32_t primask = __get_PRIMASK();
+	uint32_t completed;
+
+	__disable_irq();
+	// Last context switch is accounted on next switch
+	completed = (sKernelPro.contextSwitchCount > 0) ? (sKernelPro.contextSwitchCount - 1) : 0;
+	psKernelStatistic->contextSwitchCount = sKernelPro.contextSwitchCount;
+	psKernelStatistic->minimumContextSwitchCycles = sKernelPro.minimumContextSwitchCycles;
+	psKernelStatistic->maximumContextSwitchCycles = sKernelPro.maximumContextSwitchCycles;
+	psKernelStatistic->averageContextSwitchCycles = (completed > 0) ? (sKernelPro.totalContextSwitchCycles / completed) : 0;
+	__set_PRIMASK(primask);
+}
+
+/*******************************************************************************
+ * @fn      KernelIsIdle
+ * @brief   Check no task is delayed, kernel tick can be stopped
+ * @param	None
+ * @return	True if tick is not needed
+ ******************************************************************************/
+static bool KernelIsIdle(void)
+{
+	uint8_t i = 0;
+
+	for(i = 0; i < sKernelPro.usedTask; i++)
+	{
+		if(sKernelPro.sKernelTcb[i].eTaskState == TASK_DELAYED)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Kernel function structure
+sKERNEL sKernel =
+{
+	KernelInitialize,
+	KernelCreateTask,
+	KernelStart,
+	KernelDelay,
+	KernelWaitEvent,
+	KernelSignalEvent,
+	KernelGetStatistic,
+	KernelIsIdle,
+};
+
+/*******************************************************************************
+ * INTERRUPT CALLBACK
+ ******************************************************************************/
+/*******************************************************************************
+ * @fn      KernelTickInterruptCallback
+ * @brief   Kernel tick interrupt callback, call from SysTick every 1ms
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+void KernelTickInterruptCallback(void)
+{
+	uint8_t i = 0;
+
+	if(!sKernelPro.isStarted)
+	{
+		return;
+	}
+	for(i = 0; i < sKernelPro.usedTask; i++)
+	{
+		if(sKernelPro.sKernelTcb[i].eTaskState == TASK_DELAYED)
+		{
+			sKernelPro.sKernelTcb[i].delay--;
+			if(sKernelPro.sKernelTcb[i].delay == 0)
+			{
+				sKernelPro.sKernelTcb[i].eTaskState = TASK_READY;
+			}
+		}
+	}
+	KernelRequestSwitch();
+}
+
+/*******************************************************************************
+ * @fn      PendSV_Handler
+ * @brief   Context switch, save R4-R11 and S16-S31 only when the task used
+ *			FPU (lazy stacking leave the frame type in EXC_RETURN bit 4)
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+__attribute__((naked)) void PendSV_Handler(void)
+{
+	__asm volatile
+	(
+		"	cpsid	i						\n"
+		// Cycle counter at entry
+		"	ldr		r12, =0xE0001004		\n"
+		"	ldr		r12, [r12]				\n"
+		// Save current context
+		"	mrs		r0, psp					\n"
+		"	isb								\n"
+		"	ldr		r3, =kernelCurrentTcb	\n"
+		"	ldr		r2, [r3]				\n"
+		"	tst		r14, #0x10				\n"
+		"	it		eq						\n"
+		"	vstmdbeq r0!, {s16-s31}			\n"
+		"	stmdb	r0!, {r4-r11, r14}		\n"
+		"	str		r0, [r2]				\n"
+		// Select next task
+		"	mov		r0, r12					\n"
+		"	push	{r3, r14}				\n"
+		"	bl		KernelSwitchContext		\n"
+		"	pop		{r3, r14}				\n"
+		// Restore next context
+		"	ldr		r1, [r3]				\n"
+		"	ldr		r0, [r1]				\n"
+		"	ldmia	r0!, {r4-r11, r14}		\n"
+		"	tst		r14, #0x10				\n"
+		"	it		eq						\n"
+		"	vldmiaeq r0!, {s16-s31}			\n"
+		"	msr		psp, r0					\n"
+		"	isb								\n"
+		// Cycle counter at exit
+		"	ldr		r1, =0xE0001004			\n"
+		"	ldr		r1, [r1]				\n"
+		"	ldr		r2, =kernelSwitchEndCycle	\n"
+		"	str		r1, [r2]				\n"
+		"	cpsie	i						\n"
+		"	bx		r14						\n"
+		"	.ltorg							\n"
+	);
+}
+
+#endif /* KERNEL_ENABLE */
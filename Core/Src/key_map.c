@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * Filename:			key_map.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Keypad layout to logical key function
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "key_map.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+#define KEY(digit, eKeyFunction)	{digit, eKeyFunction, KEY_NONE}
+#define KEY_LONG(digit, eKeyFunction, eLongKeyFunction)	{digit, eKeyFunction, eLongKeyFunction}
+
+/*******************************************************************************
+ * LOCAL VARIBLES
+ ******************************************************************************/
+// Layout is selected by keypad size, index is the matrix button bit number
+// (row * NUM_OF_MATRIX_BUTTON_COLUMN) + column
+#if (NUM_OF_MATRIX_BUTTON_ROW == 4) && (NUM_OF_MATRIX_BUTTON_COLUMN == 4)
+//  1   2   3   A
+//  4   5   6   B
+//  7   8^  9   C
+//  *<  0v  #>  D
+static const sKEY_MAP_ENTRY keyMap[NUM_OF_MATRIX_BUTTON] =
+{
+	KEY('1', KEY_NONE), KEY('2', KEY_NONE), KEY('3', KEY_NONE), KEY(0, KEY_FUNCTION_A),
+	KEY('4', KEY_NONE), KEY('5', KEY_NONE), KEY('6', KEY_NONE), KEY(0, KEY_FUNCTION_B),
+	KEY('7', KEY_NONE), KEY('8', KEY_UP), KEY('9', KEY_NONE), KEY(0, KEY_FUNCTION_C),
+	KEY(0, KEY_EXIT), KEY('0', KEY_DOWN), KEY(0, KEY_ENTER), KEY(0, KEY_FUNCTION_D),
+};
+#elif (NUM_OF_MATRIX_BUTTON_ROW == 4) && (NUM_OF_MATRIX_BUTTON_COLUMN == 3)
+//  1C  2   3		No function key, '1' is Function C (next word) in
+//  4   5   6		predictive text and long press of '1' is Function B
+//  7   8^  9		(multi-tap / predictive text)
+//  *<  0v  #>
+static const sKEY_MAP_ENTRY keyMap[NUM_OF_MATRIX_BUTTON] =
+{
+	KEY_LONG('1', KEY_FUNCTION_C, KEY_FUNCTION_B), KEY('2', KEY_NONE), KEY('3', KEY_NONE),
+	KEY('4', KEY_NONE), KEY('5', KEY_NONE), KEY('6', KEY_NONE),
+	KEY('7', KEY_NONE), KEY('8', KEY_UP), KEY('9', KEY_NONE),
+	KEY(0, KEY_EXIT), KEY('0', KEY_DOWN), KEY(0, KEY_ENTER),
+};
+#elif (NUM_OF_MATRIX_BUTTON_ROW == 5) && (NUM_OF_MATRIX_BUTTON_COLUMN == 4)
+//  A   B   C   D
+//  1   2   3   ^
+//  4   5   6   v
+//  7   8   9   <
+//  *   0   #   >
+static const sKEY_MAP_ENTRY keyMap[NUM_OF_MATRIX_BUTTON] =
+{
+	KEY(0, KEY_FUNCTION_A), KEY(0, KEY_FUNCTION_B), KEY(0, KEY_FUNCTION_C), KEY(0, KEY_FUNCTION_D),
+	KEY('1', KEY_NONE), KEY('2', KEY_NONE), KEY('3', KEY_NONE), KEY(0, KEY_UP),
+	KEY('4', KEY_NONE), KEY('5', KEY_NONE), KEY('6', KEY_NONE), KEY(0, KEY_DOWN),
+	KEY('7', KEY_NONE), KEY('8', KEY_NONE), KEY('9', KEY_NONE), KEY(0, KEY_EXIT),
+	KEY(0, KEY_NONE), KEY('0', KEY_NONE), KEY(0, KEY_NONE), KEY(0, KEY_ENTER),
+};
+#else
+#error "No key map for this keypad size, add one to key_map.c"
+#endif
+
+// Returned for no key or more than one key
+static const sKEY_MAP_ENTRY noKey = KEY(0, KEY_NONE);
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+static const sKEY_MAP_ENTRY* KeyMapGet(uint32_t pressedButton);
+
+/*******************************************************************************
+ * @fn      KeyMapGet
+ * @brief   Get logical key of pressed button
+ * @param	pressedButton	One bit per matrix button
+ * @return	Key map entry
+ ******************************************************************************/
+static const sKEY_MAP_ENTRY* KeyMapGet(uint32_t pressedButton)
+{
+	// Chord is not mapped
+	if(pressedButton == 0 || (pressedButton & (pressedButton - 1)) != 0 || pressedButton >= (0x01UL << NUM_OF_MATRIX_BUTTON))
+	{
+		return &noKey;
+	}
+	return &keyMap[__builtin_ctz(pressedButton)];
+}
+
+// Key map function structure
+sKEY_MAP sKeyMap =
+{
+	KeyMapGet,
+};
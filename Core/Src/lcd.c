@@ -11,6 +11,7 @@
 #include "lcd.h"
 #include "gpio.h"
 #include "software_timer.h"
+#include "diagnostic.h"
 
 /*******************************************************************************
  * CONSTANTS
@@ -156,7 +157,7 @@ static bool LcdDisplayOnOff(void);
 static bool LcdFunctionSet(void);
 static bool LcdSetCGRAMAddress(uint8_t address);
 static bool LcdCheckLineAndPosition(uint8_t line, uint8_t position);
-static bool LcdCheckDisplayData(uint8_t line, uint8_t position, char* data);
+static bool LcdCheckDisplayData(uint8_t line, uint8_t position, const char* data);
 static bool LcdSetLogoChar(void);
 
 /*******************************************************************************
@@ -243,6 +244,9 @@ static bool LcdSend(GPIO_PinState lcdRs, GPIO_PinState lcdRw, uint8_t data)
     // Wait 200ns
     LcdTimerStart(2);
 
+    // Byte is latched by LCD
+    sDiagnostic.DisplayWritten();
+
     return true;
 }
 
@@ -450,10 +454,11 @@ static bool LcdSetAttribute(uint8_t noOfAttribute, ...);
 static bool LcdClearDisplay(void);
 static bool LcdReturnHome(void);
 static bool LcdGoTo(uint8_t line, uint8_t position);
-static bool LcdWriteString(uint8_t line, uint8_t position, char* data, eLCD_ALIGN eLcdAlign);
+static bool LcdWriteString(uint8_t line, uint8_t position, const char* data, eLCD_ALIGN eLcdAlign);
 static bool LcdWriteCharacter(uint8_t data);
 static bool LcdWriteCharacterTo(uint8_t line, uint8_t position, uint8_t data);
 static bool LcdShiftCursorDisplay(eLCD_SHIFT eLcdShift);
+static bool LcdSetCharacter(uint8_t character, const uint8_t *pattern);
 
 /*******************************************************************************
  * @fn      LcdCheckDisplayData
@@ -464,7 +469,7 @@ static bool LcdShiftCursorDisplay(eLCD_SHIFT eLcdShift);
  * @return  true
  *          false
  ******************************************************************************/
-static bool LcdCheckDisplayData(uint8_t line, uint8_t position, char* data)
+static bool LcdCheckDisplayData(uint8_t line, uint8_t position, const char* data)
 {
 	bool result = false;
 	uint8_t i = 0;
@@ -929,7 +934,7 @@ static bool LcdGoTo(uint8_t line, uint8_t position)
  * @return  true
  *          false
  ******************************************************************************/
-static bool LcdWriteString(uint8_t line, uint8_t position, char* data, eLCD_ALIGN eLcdAlign)
+static bool LcdWriteString(uint8_t line, uint8_t position, const char* data, eLCD_ALIGN eLcdAlign)
 {
 	bool result = false;
 	uint8_t i = 0;
@@ -1072,6 +1077,34 @@ static bool LcdShiftCursorDisplay(eLCD_SHIFT eLcdShift)
 	}
 }
 
+/*******************************************************************************
+ * @fn      LcdSetCharacter
+ * @brief   Lcd redefine one CGRAM character, character already on screen
+ * 			change without rewrite, set position again before next write
+ * @param   character	0 - 7
+ * 			pattern		8 rows, bit 4 is left most pixel
+ * @return  true
+ *          false
+ ******************************************************************************/
+static bool LcdSetCharacter(uint8_t character, const uint8_t *pattern)
+{
+	uint8_t i = 0;
+
+	if(character >= 8 || !LcdSetCGRAMAddress(character * 8))
+	{
+		return false;
+	}
+	for(i = 0; i < 8; i++)
+	{
+		if(!LcdWriteCharacter(pattern[i]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 // Lcd function structure
 sLCD sLcd =
 {
@@ -1084,6 +1117,7 @@ sLCD sLcd =
 	LcdWriteCharacter,
 	LcdWriteCharacterTo,
 	LcdShiftCursorDisplay,
+	LcdSetCharacter,
 };
 
 /*******************************************************************************
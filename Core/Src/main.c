@@ -89,7 +89,6 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
-  MX_TIM6_Init();
   MX_TIM7_Init();
   MX_RTC_Init();
   /* USER CODE BEGIN 2 */
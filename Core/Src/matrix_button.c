@@ -12,6 +12,11 @@
 #include "gpio.h"
 #include "software_timer.h"
 
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+#define NUM_OF_EXTI_LINE					16
+
 /*******************************************************************************
  * PUBLIC VARIABLES
  ******************************************************************************/
@@ -23,14 +28,72 @@
 /*******************************************************************************
  * STRUCTURE
  ******************************************************************************/
-// Define software timer property structure
+// Define matrix button keypad structure
 typedef struct
 {
-    uint8_t debounceTimerId[NUM_OF_MATRIX_BUTTON_ROW];
-    sMATRIX_BUTTON_PIN sMatrixButtonColumnPin[NUM_OF_MATRIX_BUTTON_COLUMN];
-    sMATRIX_BUTTON_PIN sMatrixButtonRowPin[NUM_OF_MATRIX_BUTTON_ROW];
+    const sMATRIX_BUTTON_CONFIG *psMatrixButtonConfig;
     MATRIX_BUTTON_CALLBACK matrixButtonCallback;
+    uint8_t keypadId;
+    uint8_t debounceTimerId;
     uint32_t buttonPattern;
+    uint32_t rowExtiMask;
+    bool isScanning;
+    uint8_t scanColumn;
+    uint8_t releaseScanCounter;
+    uint32_t scanPattern;
+    uint16_t keyState;
+    uint16_t pressEdge;
+    uint16_t releaseEdge;
+    sKEY_EVENT sKeyEvent[NUM_OF_KEY_EVENT];
+    volatile uint8_t keyEventHead;
+    volatile uint8_t keyEventTail;
+    uint32_t droppedKeyEvent;
+    // Last pressed key, the only one generate long press and repeat
+    uint8_t holdKey;
+    bool isLongPressSent;
+    uint16_t repeatCount;
+    uint16_t repeatInterval;
+    uint32_t pressTimestamp;
+    uint32_t repeatTimestamp;
+    uint16_t longPressDelaySetting;
+    uint16_t repeatDelaySetting;
+    uint16_t repeatIntervalSetting;
+    uint16_t repeatMinimumIntervalSetting;
+#if MATRIX_BUTTON_SCAN_MODE != MATRIX_BUTTON_EXTI_MODE
+    uint8_t integrator[NUM_OF_MATRIX_BUTTON];
+    uint8_t debounceScan[NUM_OF_MATRIX_BUTTON];
+    uint32_t ghostCount;
+#endif
+}
+sMATRIX_BUTTON_KEYPAD;
+
+// Define matrix button property structure
+typedef struct
+{
+    sMATRIX_BUTTON_KEYPAD sKeypad[NUM_OF_MATRIX_BUTTON_KEYPAD];
+    uint8_t usedKeypad;
+    // Keypad owns each row EXTI line, NUM_OF_MATRIX_BUTTON_KEYPAD for none
+    uint8_t extiLineKeypad[NUM_OF_EXTI_LINE];
+    // One scan timer shared by all keypad, one keypad per tick
+    uint8_t scanTimerId;
+    uint8_t scanKeypad;
+    // Scan is handed over to row interrupt for stop 2 mode
+    bool isLowPower;
+#if MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_DMA_MODE
+    TIM_HandleTypeDef scanTimerHandle;
+    DMA_HandleTypeDef columnDmaHandle[MATRIX_BUTTON_DMA_COLUMN_PORT];
+    DMA_HandleTypeDef rowDmaHandle[MATRIX_BUTTON_DMA_ROW_PORT];
+    GPIO_TypeDef *columnPort[MATRIX_BUTTON_DMA_COLUMN_PORT];
+    GPIO_TypeDef *rowPort[MATRIX_BUTTON_DMA_ROW_PORT];
+    uint8_t rowPortIndex[NUM_OF_MATRIX_BUTTON_ROW];
+    uint32_t columnMask[MATRIX_BUTTON_DMA_COLUMN_PORT];
+    // Column output of the paused step
+    uint32_t columnOutput[MATRIX_BUTTON_DMA_COLUMN_PORT];
+    // BSRR value of each step
+    uint32_t columnPattern[MATRIX_BUTTON_DMA_COLUMN_PORT][NUM_OF_MATRIX_BUTTON_COLUMN];
+    // IDR sample of each step, two halves
+    uint16_t rowSample[MATRIX_BUTTON_DMA_ROW_PORT][2 * MATRIX_BUTTON_DMA_SCAN * NUM_OF_MATRIX_BUTTON_COLUMN];
+#endif
 }
 sMATRIX_BUTTON_PRO;
 static sMATRIX_BUTTON_PRO sMatrixButtonPro;
@@ -38,143 +101,847 @@ static sMATRIX_BUTTON_PRO sMatrixButtonPro;
 /*******************************************************************************
  * LOCAL FUNCTIONS
  ******************************************************************************/
-void CheckPressedButton(uint8_t row);
+static void WriteAllColumn(sMATRIX_BUTTON_KEYPAD *psKeypad, GPIO_PinState pinState);
+static void PushKeyEvent(sMATRIX_BUTTON_KEYPAD *psKeypad, uint8_t key, eKEY_EVENT_TYPE eKeyEventType, uint16_t repeatCount);
+static void UpdateKeyState(sMATRIX_BUTTON_KEYPAD *psKeypad, uint16_t keyState);
+static void ProcessHold(sMATRIX_BUTTON_KEYPAD *psKeypad);
+static void StartScan(sMATRIX_BUTTON_KEYPAD *psKeypad);
+static void StopScan(sMATRIX_BUTTON_KEYPAD *psKeypad);
+static void StepScan(sMATRIX_BUTTON_KEYPAD *psKeypad);
+#if MATRIX_BUTTON_SCAN_MODE != MATRIX_BUTTON_EXTI_MODE
+static uint16_t ScanMatrix(sMATRIX_BUTTON_KEYPAD *psKeypad);
+static bool IsGhosted(uint16_t rawState);
+static uint16_t DebounceKey(sMATRIX_BUTTON_KEYPAD *psKeypad, uint16_t rawState);
+static void ProcessRawState(sMATRIX_BUTTON_KEYPAD *psKeypad, uint16_t rawState);
+static bool IsKeyIdle(sMATRIX_BUTTON_KEYPAD *psKeypad);
+static void WakeScan(sMATRIX_BUTTON_KEYPAD *psKeypad);
+#endif
+#if MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_DMA_MODE
+static uint8_t AddPort(GPIO_TypeDef **portList, uint8_t maximumPort, GPIO_TypeDef *gpio);
+static void InitializeDmaScan(sMATRIX_BUTTON_KEYPAD *psKeypad);
+static void ProcessRowSample(uint16_t firstSample);
+static void RowSampleHalfCallback(DMA_HandleTypeDef *hdma);
+static void RowSampleCompleteCallback(DMA_HandleTypeDef *hdma);
+#endif
 
 /*******************************************************************************
- * @fn      CheckPressedButton
- * @brief   Check pressed button
- * @paramz  row
+ * @fn      WriteAllColumn
+ * @brief   Drive all column pin
+ * @paramz  psKeypad
+ *			pinState
  * @return  None
  ******************************************************************************/
-void CheckPressedButton(uint8_t row)
+static void WriteAllColumn(sMATRIX_BUTTON_KEYPAD *psKeypad, GPIO_PinState pinState)
 {
 	uint8_t i = 0;
 
-	// Set all column to high level
 	for(i = 0; i < NUM_OF_MATRIX_BUTTON_COLUMN; i++)
 	{
-		HAL_GPIO_WritePin(sMatrixButtonPro.sMatrixButtonColumnPin[i].gpio, sMatrixButtonPro.sMatrixButtonColumnPin[i].pin, GPIO_PIN_SET);
+		HAL_GPIO_WritePin(psKeypad->psMatrixButtonConfig->sColumnPin[i].gpio, psKeypad->psMatrixButtonConfig->sColumnPin[i].pin, pinState);
 	}
-	// Waiting row pin go back to high level
-	while(HAL_GPIO_ReadPin(sMatrixButtonPro.sMatrixButtonRowPin[row].gpio, sMatrixButtonPro.sMatrixButtonRowPin[row].pin) == GPIO_PIN_RESET)
+}
+
+/*******************************************************************************
+ * @fn      UpdateKeyState
+ * @brief   Update stable key state and accumulate press / release edge
+ * @paramz  psKeypad
+ *			keyState
+ * @return  None
+ ******************************************************************************/
+static void UpdateKeyState(sMATRIX_BUTTON_KEYPAD *psKeypad, uint16_t keyState)
+{
+	uint8_t i = 0;
+	uint16_t pressEdge = keyState & ~psKeypad->keyState;
+	uint16_t releaseEdge = psKeypad->keyState & ~keyState;
+
+	psKeypad->pressEdge |= pressEdge;
+	psKeypad->releaseEdge |= releaseEdge;
+	psKeypad->buttonPattern |= pressEdge;
+	psKeypad->keyState = keyState;
+
+	for(i = 0; i < NUM_OF_MATRIX_BUTTON; i++)
 	{
+		if(releaseEdge & (0x01 << i))
+		{
+			PushKeyEvent(psKeypad, i, KEY_RELEASE, 0);
+			if(psKeypad->holdKey == i)
+			{
+				psKeypad->holdKey = NUM_OF_MATRIX_BUTTON;
+			}
+		}
 	}
+	for(i = 0; i < NUM_OF_MATRIX_BUTTON; i++)
+	{
+		if(pressEdge & (0x01 << i))
+		{
+			PushKeyEvent(psKeypad, i, KEY_PRESS, 0);
+			psKeypad->holdKey = i;
+			psKeypad->isLongPressSent = false;
+			psKeypad->repeatCount = 0;
+			psKeypad->repeatInterval = psKeypad->repeatIntervalSetting;
+			psKeypad->pressTimestamp = HAL_GetTick();
+			psKeypad->repeatTimestamp = psKeypad->pressTimestamp + psKeypad->repeatDelaySetting;
+		}
+	}
+}
 
-	for(i = 0; i < NUM_OF_MATRIX_BUTTON_COLUMN; i++)
+/*******************************************************************************
+ * @fn      PushKeyEvent
+ * @brief   Add key event to queue of the keypad and notify
+ * @paramz  psKeypad
+ *			key
+ *			eKeyEventType
+ *			repeatCount
+ * @return  None
+ ******************************************************************************/
+static void PushKeyEvent(sMATRIX_BUTTON_KEYPAD *psKeypad, uint8_t key, eKEY_EVENT_TYPE eKeyEventType, uint16_t repeatCount)
+{
+	uint8_t nextHead = (psKeypad->keyEventHead + 1) % NUM_OF_KEY_EVENT;
+
+	if(nextHead == psKeypad->keyEventTail)
+	{
+		// Queue full, keep the older events
+		psKeypad->droppedKeyEvent++;
+		return;
+	}
+	psKeypad->sKeyEvent[psKeypad->keyEventHead].key = key;
+	psKeypad->sKeyEvent[psKeypad->keyEventHead].eKeyEventType = eKeyEventType;
+	psKeypad->sKeyEvent[psKeypad->keyEventHead].repeatCount = repeatCount;
+	psKeypad->sKeyEvent[psKeypad->keyEventHead].timestamp = HAL_GetTick();
+	psKeypad->keyEventHead = nextHead;
+    if(psKeypad->matrixButtonCallback)
+    {
+        psKeypad->matrixButtonCallback(psKeypad->keypadId);
+    }
+}
+
+/*******************************************************************************
+ * @fn      ProcessHold
+ * @brief   Generate long press and accelerating repeat of held key
+ * @paramz  psKeypad
+ * @return  None
+ ******************************************************************************/
+static void ProcessHold(sMATRIX_BUTTON_KEYPAD *psKeypad)
+{
+	uint32_t tick = HAL_GetTick();
+
+	if(psKeypad->holdKey >= NUM_OF_MATRIX_BUTTON)
+	{
+		return;
+	}
+	if(!psKeypad->isLongPressSent && (tick - psKeypad->pressTimestamp) >= psKeypad->longPressDelaySetting)
+	{
+		psKeypad->isLongPressSent = true;
+		PushKeyEvent(psKeypad, psKeypad->holdKey, KEY_LONG_PRESS, 0);
+	}
+	if((int32_t)(tick - psKeypad->repeatTimestamp) >= 0)
+	{
+		psKeypad->repeatCount++;
+		PushKeyEvent(psKeypad, psKeypad->holdKey, KEY_REPEAT, psKeypad->repeatCount);
+		// Accelerate
+		psKeypad->repeatInterval -= psKeypad->repeatInterval >> 3;
+		if(psKeypad->repeatInterval < psKeypad->repeatMinimumIntervalSetting)
+		{
+			psKeypad->repeatInterval = psKeypad->repeatMinimumIntervalSetting;
+		}
+		psKeypad->repeatTimestamp = tick + psKeypad->repeatInterval;
+	}
+}
+
+/*******************************************************************************
+ * @fn      StartScan
+ * @brief   Mask row interrupt and start to scan one column per step, the scan
+ *			timer is started by the first scanning keypad
+ * @paramz  psKeypad
+ * @return  None
+ ******************************************************************************/
+static void StartScan(sMATRIX_BUTTON_KEYPAD *psKeypad)
+{
+	uint8_t i = 0;
+	bool isTimerRunning = false;
+
+	for(i = 0; i < sMatrixButtonPro.usedKeypad; i++)
 	{
-		HAL_GPIO_WritePin(sMatrixButtonPro.sMatrixButtonColumnPin[i].gpio, sMatrixButtonPro.sMatrixButtonColumnPin[i].pin, GPIO_PIN_RESET);
-		if(HAL_GPIO_ReadPin(sMatrixButtonPro.sMatrixButtonRowPin[row].gpio, sMatrixButtonPro.sMatrixButtonRowPin[row].pin) == GPIO_PIN_RESET)
+		isTimerRunning |= sMatrixButtonPro.sKeypad[i].isScanning;
+	}
+	// Column toggling during scan generate row edges
+	EXTI->IMR1 &= ~psKeypad->rowExtiMask;
+	psKeypad->isScanning = true;
+	psKeypad->releaseScanCounter = 0;
+	psKeypad->scanPattern = 0;
+	psKeypad->scanColumn = 0;
+	WriteAllColumn(psKeypad, GPIO_PIN_SET);
+	HAL_GPIO_WritePin(psKeypad->psMatrixButtonConfig->sColumnPin[0].gpio, psKeypad->psMatrixButtonConfig->sColumnPin[0].pin, GPIO_PIN_RESET);
+	if(!isTimerRunning)
+	{
+		sSoftwareTimer.Start(sMatrixButtonPro.scanTimerId, MATRIX_BUTTON_SCAN_PERIOD);
+	}
+}
+
+/*******************************************************************************
+ * @fn      StopScan
+ * @brief   All button released, wait for next row interrupt, the scan timer
+ *			is stopped by the last scanning keypad
+ * @paramz  psKeypad
+ * @return  None
+ ******************************************************************************/
+static void StopScan(sMATRIX_BUTTON_KEYPAD *psKeypad)
+{
+	uint8_t i = 0;
+	bool isTimerNeeded = false;
+
+	UpdateKeyState(psKeypad, 0);
+	WriteAllColumn(psKeypad, GPIO_PIN_RESET);
+	psKeypad->isScanning = false;
+	// Clear interrupt flag to avoid go in external interrupt again
+	__HAL_GPIO_EXTI_CLEAR_IT(psKeypad->rowExtiMask);
+	EXTI->IMR1 |= psKeypad->rowExtiMask;
+	for(i = 0; i < sMatrixButtonPro.usedKeypad; i++)
+	{
+		isTimerNeeded |= sMatrixButtonPro.sKeypad[i].isScanning;
+	}
+	if(!isTimerNeeded)
+	{
+		sSoftwareTimer.Stop(sMatrixButtonPro.scanTimerId);
+	}
+}
+
+/*******************************************************************************
+ * @fn      StepScan
+ * @brief   Sample rows of the column driven on previous step, then drive
+ *			next column. Never wait for the button to be released.
+ * @paramz  psKeypad
+ * @return  None
+ ******************************************************************************/
+static void StepScan(sMATRIX_BUTTON_KEYPAD *psKeypad)
+{
+	uint8_t i = 0;
+	uint8_t column = psKeypad->scanColumn;
+	const sMATRIX_BUTTON_CONFIG *psMatrixButtonConfig = psKeypad->psMatrixButtonConfig;
+
+	for(i = 0; i < NUM_OF_MATRIX_BUTTON_ROW; i++)
+	{
+		if(HAL_GPIO_ReadPin(psMatrixButtonConfig->sRowPin[i].gpio, psMatrixButtonConfig->sRowPin[i].pin) == GPIO_PIN_RESET)
 		{
-			sMatrixButtonPro.buttonPattern |= (0x01 << ((NUM_OF_MATRIX_BUTTON_COLUMN * row) + i));
+			psKeypad->scanPattern |= (0x01 << ((NUM_OF_MATRIX_BUTTON_COLUMN * i) + column));
 		}
-		HAL_GPIO_WritePin(sMatrixButtonPro.sMatrixButtonColumnPin[i].gpio, sMatrixButtonPro.sMatrixButtonColumnPin[i].pin, GPIO_PIN_SET);
-		// Waiting row pin go back to high level
-		while(HAL_GPIO_ReadPin(sMatrixButtonPro.sMatrixButtonRowPin[row].gpio, sMatrixButtonPro.sMatrixButtonRowPin[row].pin) == GPIO_PIN_RESET)
+	}
+	HAL_GPIO_WritePin(psMatrixButtonConfig->sColumnPin[column].gpio, psMatrixButtonConfig->sColumnPin[column].pin, GPIO_PIN_SET);
+
+	column++;
+	// Full matrix scanned
+	if(column == NUM_OF_MATRIX_BUTTON_COLUMN)
+	{
+		column = 0;
+		if(psKeypad->scanPattern != 0)
 		{
+			psKeypad->releaseScanCounter = 0;
+			UpdateKeyState(psKeypad, psKeypad->scanPattern);
+			ProcessHold(psKeypad);
 		}
+		else if(++psKeypad->releaseScanCounter >= MATRIX_BUTTON_RELEASE_SCAN)
+		{
+			StopScan(psKeypad);
+			return;
+		}
+		psKeypad->scanPattern = 0;
 	}
+	psKeypad->scanColumn = column;
+	HAL_GPIO_WritePin(psMatrixButtonConfig->sColumnPin[column].gpio, psMatrixButtonConfig->sColumnPin[column].pin, GPIO_PIN_RESET);
+}
+
+#if MATRIX_BUTTON_SCAN_MODE != MATRIX_BUTTON_EXTI_MODE
+/*******************************************************************************
+ * @fn      ScanMatrix
+ * @brief   Scan all column in one go
+ * @paramz  psKeypad
+ * @return  Raw key state, bit = (row * NUM_OF_MATRIX_BUTTON_COLUMN) + column
+ ******************************************************************************/
+static uint16_t ScanMatrix(sMATRIX_BUTTON_KEYPAD *psKeypad)
+{
+	uint8_t i = 0;
+	uint8_t j = 0;
+	uint16_t rawState = 0;
+	uint32_t cycle;
+	const sMATRIX_BUTTON_CONFIG *psMatrixButtonConfig = psKeypad->psMatrixButtonConfig;
 
-	// Set all column to low level
 	for(i = 0; i < NUM_OF_MATRIX_BUTTON_COLUMN; i++)
 	{
-		HAL_GPIO_WritePin(sMatrixButtonPro.sMatrixButtonColumnPin[i].gpio, sMatrixButtonPro.sMatrixButtonColumnPin[i].pin, GPIO_PIN_RESET);
+		HAL_GPIO_WritePin(psMatrixButtonConfig->sColumnPin[i].gpio, psMatrixButtonConfig->sColumnPin[i].pin, GPIO_PIN_RESET);
+		// Bounded wait for row pull up to settle, not for the user
+		cycle = CYCLE_COUNTER_GET();
+		while((CYCLE_COUNTER_GET() - cycle) < MATRIX_BUTTON_SETTLE_CYCLES)
+		{
+		}
+		for(j = 0; j < NUM_OF_MATRIX_BUTTON_ROW; j++)
+		{
+			if(HAL_GPIO_ReadPin(psMatrixButtonConfig->sRowPin[j].gpio, psMatrixButtonConfig->sRowPin[j].pin) == GPIO_PIN_RESET)
+			{
+				rawState |= (0x01 << ((NUM_OF_MATRIX_BUTTON_COLUMN * j) + i));
+			}
+		}
+		HAL_GPIO_WritePin(psMatrixButtonConfig->sColumnPin[i].gpio, psMatrixButtonConfig->sColumnPin[i].pin, GPIO_PIN_SET);
 	}
+	return rawState;
+}
+
+/*******************************************************************************
+ * @fn      IsGhosted
+ * @brief   Matrix without diode can not tell three pressed key at corners of
+ *			a rectangle from four, any two rows share two columns is ambiguous
+ * @paramz  rawState
+ * @return  true
+ *			false
+ ******************************************************************************/
+static bool IsGhosted(uint16_t rawState)
+{
+	uint8_t i = 0;
+	uint8_t j = 0;
+	uint8_t mask = (0x01 << NUM_OF_MATRIX_BUTTON_COLUMN) - 1;
+	uint8_t common;
 
-	// Clear interrupt flag to avoid go in external interrupt again
 	for(i = 0; i < NUM_OF_MATRIX_BUTTON_ROW; i++)
 	{
-		__HAL_GPIO_EXTI_CLEAR_IT(sMatrixButtonPro.sMatrixButtonRowPin[i].pin);
+		for(j = i + 1; j < NUM_OF_MATRIX_BUTTON_ROW; j++)
+		{
+			common = (rawState >> (NUM_OF_MATRIX_BUTTON_COLUMN * i)) & (rawState >> (NUM_OF_MATRIX_BUTTON_COLUMN * j)) & mask;
+			// More than one bit set
+			if((common & (common - 1)) != 0)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/*******************************************************************************
+ * @fn      DebounceKey
+ * @brief   Per key integrator, state change after debounceScan agreeing scan
+ * @paramz  psKeypad
+ *			rawState
+ * @return  Stable key state
+ ******************************************************************************/
+static uint16_t DebounceKey(sMATRIX_BUTTON_KEYPAD *psKeypad, uint16_t rawState)
+{
+	uint8_t i = 0;
+	uint16_t keyState = psKeypad->keyState;
+
+	for(i = 0; i < NUM_OF_MATRIX_BUTTON; i++)
+	{
+		if(rawState & (0x01 << i))
+		{
+			if(psKeypad->integrator[i] < psKeypad->debounceScan[i])
+			{
+				psKeypad->integrator[i]++;
+			}
+			if(psKeypad->integrator[i] >= psKeypad->debounceScan[i])
+			{
+				keyState |= (0x01 << i);
+			}
+		}
+		else
+		{
+			if(psKeypad->integrator[i] > 0)
+			{
+				psKeypad->integrator[i]--;
+			}
+			if(psKeypad->integrator[i] == 0)
+			{
+				keyState &= ~(0x01 << i);
+			}
+		}
+	}
+	return keyState;
+}
+
+/*******************************************************************************
+ * @fn      ProcessRawState
+ * @brief   Debounce one full scan unless it is ambiguous
+ * @paramz  psKeypad
+ *			rawState
+ * @return  None
+ ******************************************************************************/
+static void ProcessRawState(sMATRIX_BUTTON_KEYPAD *psKeypad, uint16_t rawState)
+{
+	// Hold current state until the ambiguous combination is gone
+	if(IsGhosted(rawState))
+	{
+		psKeypad->ghostCount++;
+	}
+	else
+	{
+		UpdateKeyState(psKeypad, DebounceKey(psKeypad, rawState));
+	}
+}
+
+/*******************************************************************************
+ * @fn      IsKeyIdle
+ * @brief   Check no key is held or being debounced
+ * @paramz  psKeypad
+ * @return  true
+ *			false
+ ******************************************************************************/
+static bool IsKeyIdle(sMATRIX_BUTTON_KEYPAD *psKeypad)
+{
+	uint8_t i = 0;
+
+	if(psKeypad->keyState != 0)
+	{
+		return false;
+	}
+	for(i = 0; i < NUM_OF_MATRIX_BUTTON; i++)
+	{
+		if(psKeypad->integrator[i] != 0)
+		{
+			return false;
+		}
 	}
+	return true;
 }
 
+/*******************************************************************************
+ * @fn      WakeScan
+ * @brief   Scan the key woke up the MCU, the row edge already proved the
+ *			press so it is reported without waiting for debounce scans,
+ *			a short tap is not lost while clock is restored
+ * @paramz  psKeypad
+ * @return  None
+ ******************************************************************************/
+static void WakeScan(sMATRIX_BUTTON_KEYPAD *psKeypad)
+{
+	uint8_t i = 0;
+	uint16_t rawState = ScanMatrix(psKeypad);
+
+	if(rawState == 0 || IsGhosted(rawState))
+	{
+		// Released already or ambiguous, normal scan take over
+		return;
+	}
+	for(i = 0; i < NUM_OF_MATRIX_BUTTON; i++)
+	{
+		if(rawState & (0x01 << i))
+		{
+			psKeypad->integrator[i] = psKeypad->debounceScan[i];
+		}
+	}
+	UpdateKeyState(psKeypad, psKeypad->keyState | rawState);
+}
+#endif
+
+#if MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_DMA_MODE
+/*******************************************************************************
+ * @fn      AddPort
+ * @brief   Add GPIO port to list if it is not there
+ * @paramz  portList
+ *			maximumPort
+ *			gpio
+ * @return  Index in port list
+ ******************************************************************************/
+static uint8_t AddPort(GPIO_TypeDef **portList, uint8_t maximumPort, GPIO_TypeDef *gpio)
+{
+	uint8_t i = 0;
+
+	for(i = 0; i < maximumPort; i++)
+	{
+		if(portList[i] == gpio)
+		{
+			return i;
+		}
+		if(portList[i] == NULL)
+		{
+			portList[i] = gpio;
+			return i;
+		}
+	}
+	// Too many GPIO port for DMA channels, increase
+	// "MATRIX_BUTTON_DMA_COLUMN_PORT" / "MATRIX_BUTTON_DMA_ROW_PORT" and
+	// assign more TIM1 DMA request
+	for(;;)
+	{
+	}
+}
+
+/*******************************************************************************
+ * @fn      InitializeDmaScan
+ * @brief   TIM1 update and compare events trigger DMA1 (request 7):
+ *			UP  -> channel 6, column port 0 BSRR at step start
+ *			CC1 -> channel 2, column port 1 BSRR at step start
+ *			CC2 -> channel 3, row port 0 IDR before step end
+ *			CC3 -> channel 7, row port 1 IDR before step end
+ *			CC4 -> channel 4, row port 2 IDR before step end, interrupt
+ * @paramz  psKeypad
+ * @return  None
+ ******************************************************************************/
+static void InitializeDmaScan(sMATRIX_BUTTON_KEYPAD *psKeypad)
+{
+	uint8_t i = 0;
+	uint8_t j = 0;
+	uint8_t port;
+	uint32_t *columnMask = sMatrixButtonPro.columnMask;
+	const sMATRIX_BUTTON_CONFIG *psMatrixButtonConfig = psKeypad->psMatrixButtonConfig;
+	TIM_OC_InitTypeDef sConfigOC = {0};
+	DMA_Channel_TypeDef * const columnChannel[MATRIX_BUTTON_DMA_COLUMN_PORT] = {DMA1_Channel6, DMA1_Channel2};
+	DMA_Channel_TypeDef * const rowChannel[MATRIX_BUTTON_DMA_ROW_PORT] = {DMA1_Channel3, DMA1_Channel7, DMA1_Channel4};
+	const uint32_t rowCompareChannel[MATRIX_BUTTON_DMA_ROW_PORT] = {TIM_CHANNEL_2, TIM_CHANNEL_3, TIM_CHANNEL_4};
+
+	// Group pins by port, unused DMA channel repeat port 0
+	for(i = 0; i < NUM_OF_MATRIX_BUTTON_COLUMN; i++)
+	{
+		port = AddPort(sMatrixButtonPro.columnPort, MATRIX_BUTTON_DMA_COLUMN_PORT, psMatrixButtonConfig->sColumnPin[i].gpio);
+		columnMask[port] |= psMatrixButtonConfig->sColumnPin[i].pin;
+	}
+	for(i = 0; i < NUM_OF_MATRIX_BUTTON_ROW; i++)
+	{
+		sMatrixButtonPro.rowPortIndex[i] = AddPort(sMatrixButtonPro.rowPort, MATRIX_BUTTON_DMA_ROW_PORT, psMatrixButtonConfig->sRowPin[i].gpio);
+	}
+	for(i = 1; i < MATRIX_BUTTON_DMA_COLUMN_PORT; i++)
+	{
+		if(sMatrixButtonPro.columnPort[i] == NULL)
+		{
+			sMatrixButtonPro.columnPort[i] = sMatrixButtonPro.columnPort[0];
+			columnMask[i] = columnMask[0];
+		}
+	}
+	for(i = 1; i < MATRIX_BUTTON_DMA_ROW_PORT; i++)
+	{
+		if(sMatrixButtonPro.rowPort[i] == NULL)
+		{
+			sMatrixButtonPro.rowPort[i] = sMatrixButtonPro.rowPort[0];
+		}
+	}
+
+	// Step n drive column n low and the others high. Update event happens at
+	// the end of a step, so port 0 table start from step 1.
+	for(i = 0; i < MATRIX_BUTTON_DMA_COLUMN_PORT; i++)
+	{
+		for(j = 0; j < NUM_OF_MATRIX_BUTTON_COLUMN; j++)
+		{
+			uint8_t step = (i == 0) ? ((j + 1) % NUM_OF_MATRIX_BUTTON_COLUMN) : j;
+			uint32_t lowPin = (psMatrixButtonConfig->sColumnPin[step].gpio == sMatrixButtonPro.columnPort[i]) ? psMatrixButtonConfig->sColumnPin[step].pin : 0;
+
+			sMatrixButtonPro.columnPattern[i][j] = (columnMask[i] & ~lowPin) | (lowPin << 16);
+		}
+	}
+	// Drive step 0 before first update event
+	WriteAllColumn(psKeypad, GPIO_PIN_SET);
+	HAL_GPIO_WritePin(psMatrixButtonConfig->sColumnPin[0].gpio, psMatrixButtonConfig->sColumnPin[0].pin, GPIO_PIN_RESET);
+
+	__HAL_RCC_DMA1_CLK_ENABLE();
+	__HAL_RCC_TIM1_CLK_ENABLE();
+
+	for(i = 0; i < MATRIX_BUTTON_DMA_COLUMN_PORT; i++)
+	{
+		sMatrixButtonPro.columnDmaHandle[i].Instance = columnChannel[i];
+		sMatrixButtonPro.columnDmaHandle[i].Init.Request = DMA_REQUEST_7;
+		sMatrixButtonPro.columnDmaHandle[i].Init.Direction = DMA_MEMORY_TO_PERIPH;
+		sMatrixButtonPro.columnDmaHandle[i].Init.PeriphInc = DMA_PINC_DISABLE;
+		sMatrixButtonPro.columnDmaHandle[i].Init.MemInc = DMA_MINC_ENABLE;
+		sMatrixButtonPro.columnDmaHandle[i].Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+		sMatrixButtonPro.columnDmaHandle[i].Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+		sMatrixButtonPro.columnDmaHandle[i].Init.Mode = DMA_CIRCULAR;
+		sMatrixButtonPro.columnDmaHandle[i].Init.Priority = DMA_PRIORITY_HIGH;
+		if(HAL_DMA_Init(&sMatrixButtonPro.columnDmaHandle[i]) != HAL_OK)
+		{
+			Error_Handler();
+		}
+		HAL_DMA_Start(&sMatrixButtonPro.columnDmaHandle[i], (uint32_t)sMatrixButtonPro.columnPattern[i], (uint32_t)&sMatrixButtonPro.columnPort[i]->BSRR, NUM_OF_MATRIX_BUTTON_COLUMN);
+	}
+	for(i = 0; i < MATRIX_BUTTON_DMA_ROW_PORT; i++)
+	{
+		sMatrixButtonPro.rowDmaHandle[i].Instance = rowChannel[i];
+		sMatrixButtonPro.rowDmaHandle[i].Init.Request = DMA_REQUEST_7;
+		sMatrixButtonPro.rowDmaHandle[i].Init.Direction = DMA_PERIPH_TO_MEMORY;
+		sMatrixButtonPro.rowDmaHandle[i].Init.PeriphInc = DMA_PINC_DISABLE;
+		sMatrixButtonPro.rowDmaHandle[i].Init.MemInc = DMA_MINC_ENABLE;
+		sMatrixButtonPro.rowDmaHandle[i].Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+		sMatrixButtonPro.rowDmaHandle[i].Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+		sMatrixButtonPro.rowDmaHandle[i].Init.Mode = DMA_CIRCULAR;
+		sMatrixButtonPro.rowDmaHandle[i].Init.Priority = DMA_PRIORITY_HIGH;
+		if(HAL_DMA_Init(&sMatrixButtonPro.rowDmaHandle[i]) != HAL_OK)
+		{
+			Error_Handler();
+		}
+	}
+	for(i = 0; i < MATRIX_BUTTON_DMA_ROW_PORT - 1; i++)
+	{
+		HAL_DMA_Start(&sMatrixButtonPro.rowDmaHandle[i], (uint32_t)&sMatrixButtonPro.rowPort[i]->IDR, (uint32_t)sMatrixButtonPro.rowSample[i], 2 * MATRIX_BUTTON_DMA_SCAN * NUM_OF_MATRIX_BUTTON_COLUMN);
+	}
+	// Last row sample of a step, process buffer on half and complete
+	sMatrixButtonPro.rowDmaHandle[i].XferHalfCpltCallback = RowSampleHalfCallback;
+	sMatrixButtonPro.rowDmaHandle[i].XferCpltCallback = RowSampleCompleteCallback;
+	HAL_NVIC_SetPriority(DMA1_Channel4_IRQn, 1, 0);
+	HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+	HAL_DMA_Start_IT(&sMatrixButtonPro.rowDmaHandle[i], (uint32_t)&sMatrixButtonPro.rowPort[i]->IDR, (uint32_t)sMatrixButtonPro.rowSample[i], 2 * MATRIX_BUTTON_DMA_SCAN * NUM_OF_MATRIX_BUTTON_COLUMN);
+
+	// 1us timer tick
+	sMatrixButtonPro.scanTimerHandle.Instance = TIM1;
+	sMatrixButtonPro.scanTimerHandle.Init.Prescaler = (SystemCoreClock / 1000000) - 1;
+	sMatrixButtonPro.scanTimerHandle.Init.CounterMode = TIM_COUNTERMODE_UP;
+	sMatrixButtonPro.scanTimerHandle.Init.Period = MATRIX_BUTTON_DMA_STEP_PERIOD - 1;
+	sMatrixButtonPro.scanTimerHandle.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+	sMatrixButtonPro.scanTimerHandle.Init.RepetitionCounter = 0;
+	sMatrixButtonPro.scanTimerHandle.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+	if(HAL_TIM_OC_Init(&sMatrixButtonPro.scanTimerHandle) != HAL_OK)
+	{
+		Error_Handler();
+	}
+	sConfigOC.OCMode = TIM_OCMODE_TIMING;
+	sConfigOC.Pulse = 1;
+	HAL_TIM_OC_ConfigChannel(&sMatrixButtonPro.scanTimerHandle, &sConfigOC, TIM_CHANNEL_1);
+	// Sample rows after settle, just before next step
+	for(i = 0; i < MATRIX_BUTTON_DMA_ROW_PORT; i++)
+	{
+		sConfigOC.Pulse = MATRIX_BUTTON_DMA_STEP_PERIOD - MATRIX_BUTTON_DMA_ROW_PORT - 1 + i;
+		HAL_TIM_OC_ConfigChannel(&sMatrixButtonPro.scanTimerHandle, &sConfigOC, rowCompareChannel[i]);
+	}
+	__HAL_TIM_ENABLE_DMA(&sMatrixButtonPro.scanTimerHandle, TIM_DMA_UPDATE | TIM_DMA_CC1 | TIM_DMA_CC2 | TIM_DMA_CC3 | TIM_DMA_CC4);
+	__HAL_TIM_ENABLE(&sMatrixButtonPro.scanTimerHandle);
+}
+
+/*******************************************************************************
+ * @fn      ProcessRowSample
+ * @brief   Convert one half buffer of row sample to key state, DMA scan
+ *			serve the first keypad only
+ * @paramz  firstSample
+ * @return  None
+ ******************************************************************************/
+static void ProcessRowSample(uint16_t firstSample)
+{
+	uint8_t i = 0;
+	uint8_t j = 0;
+	uint8_t k = 0;
+	uint16_t sample;
+	uint16_t rawState;
+	sMATRIX_BUTTON_KEYPAD *psKeypad = &sMatrixButtonPro.sKeypad[0];
+
+	for(i = 0; i < MATRIX_BUTTON_DMA_SCAN; i++)
+	{
+		rawState = 0;
+		for(j = 0; j < NUM_OF_MATRIX_BUTTON_COLUMN; j++)
+		{
+			sample = firstSample + (i * NUM_OF_MATRIX_BUTTON_COLUMN) + j;
+			for(k = 0; k < NUM_OF_MATRIX_BUTTON_ROW; k++)
+			{
+				if((sMatrixButtonPro.rowSample[sMatrixButtonPro.rowPortIndex[k]][sample] & psKeypad->psMatrixButtonConfig->sRowPin[k].pin) == 0)
+				{
+					rawState |= (0x01 << ((NUM_OF_MATRIX_BUTTON_COLUMN * k) + j));
+				}
+			}
+		}
+		ProcessRawState(psKeypad, rawState);
+	}
+	ProcessHold(psKeypad);
+}
+
+/*******************************************************************************
+ * @fn      RowSampleHalfCallback
+ * @brief   First half of row sample is ready
+ * @paramz  hdma
+ * @return  None
+ ******************************************************************************/
+static void RowSampleHalfCallback(DMA_HandleTypeDef *hdma)
+{
+	ProcessRowSample(0);
+}
+
+/*******************************************************************************
+ * @fn      RowSampleCompleteCallback
+ * @brief   Second half of row sample is ready
+ * @paramz  hdma
+ * @return  None
+ ******************************************************************************/
+static void RowSampleCompleteCallback(DMA_HandleTypeDef *hdma)
+{
+	ProcessRowSample(MATRIX_BUTTON_DMA_SCAN * NUM_OF_MATRIX_BUTTON_COLUMN);
+}
+#endif
+
 /*******************************************************************************
  * CALLBACK FUNCTIONS
  ******************************************************************************/
 void DebounceTimerCallback(uint8_t softwareTimerId);
+void ScanTimerCallback(uint8_t softwareTimerId);
+#if MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_PERIODIC_MODE
+void PeriodicScanTimerCallback(uint8_t softwareTimerId);
+#endif
 
 /*******************************************************************************
  * @fn      DebounceTimerCallback
- * @brief   Debounce timer callback
+ * @brief   Debounce timer callback, scan if any row of the keypad is low
  * @paramz  softwareTimerId
  * @return  None
  ******************************************************************************/
 void DebounceTimerCallback(uint8_t softwareTimerId)
 {
     uint8_t i = 0;
+    uint8_t j = 0;
+    sMATRIX_BUTTON_KEYPAD *psKeypad;
 
-    for(i = 0; i < NUM_OF_MATRIX_BUTTON_ROW; i++)
+    for(i = 0; i < sMatrixButtonPro.usedKeypad; i++)
     {
-        // Found the matrix button row
-        if(sMatrixButtonPro.debounceTimerId[i] == softwareTimerId)
+        psKeypad = &sMatrixButtonPro.sKeypad[i];
+        // Found the keypad
+        if(psKeypad->debounceTimerId != softwareTimerId)
+        {
+        	continue;
+        }
+        for(j = 0; j < NUM_OF_MATRIX_BUTTON_ROW && !psKeypad->isScanning; j++)
         {
-    		if(HAL_GPIO_ReadPin(sMatrixButtonPro.sMatrixButtonRowPin[i].gpio, sMatrixButtonPro.sMatrixButtonRowPin[i].pin) == GPIO_PIN_RESET)
+    		if(HAL_GPIO_ReadPin(psKeypad->psMatrixButtonConfig->sRowPin[j].gpio, psKeypad->psMatrixButtonConfig->sRowPin[j].pin) == GPIO_PIN_RESET)
     		{
-                CheckPressedButton(i);
-                if(sMatrixButtonPro.matrixButtonCallback)
-                {
-                    sMatrixButtonPro.matrixButtonCallback();
-                }
+    			StartScan(psKeypad);
     		}
-            break;
         }
+        break;
     }
 }
 
+/*******************************************************************************
+ * @fn      ScanTimerCallback
+ * @brief   Step the next scanning keypad in turn, one column per tick, tick
+ *			cost does not grow with number of keypad
+ * @paramz  softwareTimerId
+ * @return  None
+ ******************************************************************************/
+void ScanTimerCallback(uint8_t softwareTimerId)
+{
+	uint8_t i = 0;
+	uint8_t keypad;
+
+	for(i = 1; i <= sMatrixButtonPro.usedKeypad; i++)
+	{
+		keypad = (sMatrixButtonPro.scanKeypad + i) % sMatrixButtonPro.usedKeypad;
+		if(sMatrixButtonPro.sKeypad[keypad].isScanning)
+		{
+			sMatrixButtonPro.scanKeypad = keypad;
+			StepScan(&sMatrixButtonPro.sKeypad[keypad]);
+			break;
+		}
+	}
+}
+
+#if MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_PERIODIC_MODE
+/*******************************************************************************
+ * @fn      PeriodicScanTimerCallback
+ * @brief   Scan full matrix of one keypad per tick in turn and debounce
+ *			every key, tick cost does not grow with number of keypad
+ * @paramz  softwareTimerId
+ * @return  None
+ ******************************************************************************/
+void PeriodicScanTimerCallback(uint8_t softwareTimerId)
+{
+	sMATRIX_BUTTON_KEYPAD *psKeypad;
+
+	sMatrixButtonPro.scanKeypad = (sMatrixButtonPro.scanKeypad + 1) % sMatrixButtonPro.usedKeypad;
+	psKeypad = &sMatrixButtonPro.sKeypad[sMatrixButtonPro.scanKeypad];
+	ProcessRawState(psKeypad, ScanMatrix(psKeypad));
+	ProcessHold(psKeypad);
+}
+#endif
+
 /*******************************************************************************
  * LOCAL FUNCTIONS
  ******************************************************************************/
-static void MatrixButtonInitialize(MATRIX_BUTTON_CALLBACK matrixButtonCallback, ...);
-static uint32_t MatrixButtonGetPressedButton(void);
+static uint8_t MatrixButtonInitialize(const sMATRIX_BUTTON_CONFIG *psMatrixButtonConfig, MATRIX_BUTTON_CALLBACK matrixButtonCallback);
+static uint32_t MatrixButtonGetPressedButton(uint8_t keypadId);
+static bool MatrixButtonStartDebounce(uint16_t gpioPin);
+static uint16_t MatrixButtonGetKeyState(uint8_t keypadId);
+static void MatrixButtonGetKeyEdge(uint8_t keypadId, uint16_t *pressEdge, uint16_t *releaseEdge);
+static void MatrixButtonSetDebounce(uint8_t keypadId, uint8_t key, uint8_t debounceScan);
+static bool MatrixButtonGetKeyEvent(uint8_t keypadId, sKEY_EVENT *psKeyEvent);
+static void MatrixButtonSetRepeat(uint8_t keypadId, uint16_t longPressDelay, uint16_t repeatDelay, uint16_t repeatInterval, uint16_t repeatMinimumInterval);
+static bool MatrixButtonEnterLowPower(void);
+static bool MatrixButtonExitLowPower(void);
 
 /*******************************************************************************
  * @fn      MatrixButtonInitialize
- * @brief   Matrix button initialize
- * @param   matrixButtonCallback
- * 			MATRIX_BUTTON_COLUMN_1_GPIO_Port
- * 			MATRIX_BUTTON_COLUMN_1_Pin
- * 			MATRIX_BUTTON_COLUMN_2_GPIO_Port
- * 			MATRIX_BUTTON_COLUMN_2_Pin
- * 			*
- * 			*
- * 			*
- * 			MATRIX_BUTTON_ROW_1_GPIO_Port
- * 			MATRIX_BUTTON_ROW_1_Pin
- * 			MATRIX_BUTTON_ROW_2_GPIO_Port
- * 			MATRIX_BUTTON_ROW_2_Pin
- * 			*
- * 			*
- * 			*
- * @return  None
- ******************************************************************************/
-static void MatrixButtonInitialize(MATRIX_BUTTON_CALLBACK matrixButtonCallback, ...)
+ * @brief   Matrix button initialize one keypad
+ * @param   psMatrixButtonConfig	Pin table, must stay valid
+ * 			matrixButtonCallback
+ * @return  Keypad ID
+ ******************************************************************************/
+static uint8_t MatrixButtonInitialize(const sMATRIX_BUTTON_CONFIG *psMatrixButtonConfig, MATRIX_BUTTON_CALLBACK matrixButtonCallback)
 {
     uint8_t i = 0;
-    va_list argumentPointer;
+    uint8_t line;
+    sMATRIX_BUTTON_KEYPAD *psKeypad;
 
-    sMatrixButtonPro.buttonPattern = 0;
-
-    va_start(argumentPointer, matrixButtonCallback);
-    for(i = 0; i < NUM_OF_MATRIX_BUTTON_COLUMN; i++)
+    if(sMatrixButtonPro.usedKeypad == 0)
     {
-        sMatrixButtonPro.sMatrixButtonColumnPin[i].gpio = va_arg(argumentPointer, GPIO_TypeDef*);
-        sMatrixButtonPro.sMatrixButtonColumnPin[i].pin = va_arg(argumentPointer, uint32_t);
+        for(i = 0; i < NUM_OF_EXTI_LINE; i++)
+        {
+        	sMatrixButtonPro.extiLineKeypad[i] = NUM_OF_MATRIX_BUTTON_KEYPAD;
+        }
+        sMatrixButtonPro.scanKeypad = 0;
+        sMatrixButtonPro.isLowPower = false;
+#if MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_PERIODIC_MODE
+        sMatrixButtonPro.scanTimerId = sSoftwareTimer.Initialize(NULL, PeriodicScanTimerCallback, NULL, TIMER_PERIODIC_TYPE);
+#elif MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_EXTI_MODE
+        sMatrixButtonPro.scanTimerId = sSoftwareTimer.Initialize(NULL, ScanTimerCallback, NULL, TIMER_PERIODIC_TYPE);
+#endif
     }
+    // Not enough keypad, increase "NUM_OF_MATRIX_BUTTON_KEYPAD"
+    if(sMatrixButtonPro.usedKeypad >= NUM_OF_MATRIX_BUTTON_KEYPAD)
+    {
+        for(;;)
+        {
+        }
+    }
+    psKeypad = &sMatrixButtonPro.sKeypad[sMatrixButtonPro.usedKeypad];
+    memset(psKeypad, 0, sizeof(sMATRIX_BUTTON_KEYPAD));
+    psKeypad->psMatrixButtonConfig = psMatrixButtonConfig;
+    psKeypad->matrixButtonCallback = matrixButtonCallback;
+    psKeypad->keypadId = sMatrixButtonPro.usedKeypad;
+    psKeypad->holdKey = NUM_OF_MATRIX_BUTTON;
+    psKeypad->longPressDelaySetting = KEY_LONG_PRESS_DELAY;
+    psKeypad->repeatDelaySetting = KEY_REPEAT_DELAY;
+    psKeypad->repeatIntervalSetting = KEY_REPEAT_INTERVAL;
+    psKeypad->repeatMinimumIntervalSetting = KEY_REPEAT_MINIMUM_INTERVAL;
+    psKeypad->debounceTimerId = sSoftwareTimer.Initialize(NULL, DebounceTimerCallback, NULL, TIMER_ONCE_TYPE);
 
     for(i = 0; i < NUM_OF_MATRIX_BUTTON_ROW; i++)
     {
-        sMatrixButtonPro.sMatrixButtonRowPin[i].gpio = va_arg(argumentPointer, GPIO_TypeDef*);
-        sMatrixButtonPro.sMatrixButtonRowPin[i].pin = va_arg(argumentPointer, uint32_t);
-        sMatrixButtonPro.debounceTimerId[i] = sSoftwareTimer.Initialize(NULL, DebounceTimerCallback, NULL, TIMER_ONCE_TYPE);
+        line = __builtin_ctz(psMatrixButtonConfig->sRowPin[i].pin);
+        // Row EXTI line is used by other keypad, row pins of all keypads
+        // must have different pin number
+        if(sMatrixButtonPro.extiLineKeypad[line] != NUM_OF_MATRIX_BUTTON_KEYPAD)
+        {
+            for(;;)
+            {
+            }
+        }
+        sMatrixButtonPro.extiLineKeypad[line] = psKeypad->keypadId;
+        psKeypad->rowExtiMask |= psMatrixButtonConfig->sRowPin[i].pin;
     }
-    sMatrixButtonPro.matrixButtonCallback = matrixButtonCallback;
+    sMatrixButtonPro.usedKeypad++;
 
-    va_end(argumentPointer);
+#if MATRIX_BUTTON_SCAN_MODE != MATRIX_BUTTON_EXTI_MODE
+    for(i = 0; i < NUM_OF_MATRIX_BUTTON; i++)
+    {
+    	psKeypad->debounceScan[i] = (psMatrixButtonConfig->debounceScan > 0) ? psMatrixButtonConfig->debounceScan : MATRIX_BUTTON_DEBOUNCE_SCAN;
+    }
+    // Row interrupt is only used to wake up from stop 2 mode, columns are
+    // driven only while scanning
+    EXTI->IMR1 &= ~psKeypad->rowExtiMask;
+    WriteAllColumn(psKeypad, GPIO_PIN_SET);
+    CYCLE_COUNTER_ENABLE();
+#endif
+#if MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_DMA_MODE
+    InitializeDmaScan(psKeypad);
+#elif MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_PERIODIC_MODE
+    if(psKeypad->keypadId == 0)
+    {
+        sSoftwareTimer.Start(sMatrixButtonPro.scanTimerId, MATRIX_BUTTON_SCAN_PERIOD);
+    }
+#endif
+    return psKeypad->keypadId;
 }
 
 /*******************************************************************************
  * @fn      MatrixButtonGetPressedButton
  * @brief   Matrix button get press button
- * @param   None
+ * @param   keypadId
  * @return  buttonPattern
  ******************************************************************************/
 //0b00000000
@@ -186,23 +953,242 @@ static void MatrixButtonInitialize(MATRIX_BUTTON_CALLBACK matrixButtonCallback,
 //  *    3rd button
 //  *
 //  8th button
-static uint32_t MatrixButtonGetPressedButton(void)
+static uint32_t MatrixButtonGetPressedButton(uint8_t keypadId)
 {
-	uint32_t buttonPattern = sMatrixButtonPro.buttonPattern;
+	uint32_t buttonPattern = sMatrixButtonPro.sKeypad[keypadId].buttonPattern;
 
-	sMatrixButtonPro.buttonPattern = 0;
+	sMatrixButtonPro.sKeypad[keypadId].buttonPattern = 0;
 	return buttonPattern;
 }
 
 /*******************************************************************************
  * @fn      MatrixButtonStartDebounce
- * @brief   Matrix button start debounce
- * @param   row
+ * @brief   Matrix button start debounce of the keypad own the row, call from
+ *			EXTI callback
+ * @param   gpioPin
+ * @return  true	Pin is a keypad row
+ *			false
+ ******************************************************************************/
+static bool MatrixButtonStartDebounce(uint16_t gpioPin)
+{
+	uint8_t keypad;
+
+	if(gpioPin == 0)
+	{
+		return false;
+	}
+	keypad = sMatrixButtonPro.extiLineKeypad[__builtin_ctz(gpioPin)];
+	if(keypad >= NUM_OF_MATRIX_BUTTON_KEYPAD)
+	{
+		return false;
+	}
+#if MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_EXTI_MODE
+	sSoftwareTimer.Start(sMatrixButtonPro.sKeypad[keypad].debounceTimerId, DEBOUNCE_DELAY);
+#endif
+	return true;
+}
+
+/*******************************************************************************
+ * @fn      MatrixButtonGetKeyState
+ * @brief   Matrix button get stable key state
+ * @param   keypadId
+ * @return  Key state, bit set when the key is held
+ ******************************************************************************/
+static uint16_t MatrixButtonGetKeyState(uint8_t keypadId)
+{
+	return sMatrixButtonPro.sKeypad[keypadId].keyState;
+}
+
+/*******************************************************************************
+ * @fn      MatrixButtonGetKeyEdge
+ * @brief   Matrix button get and clear key edge since last call
+ * @param   keypadId
+ *			pressEdge
+ *			releaseEdge
  * @return  None
  ******************************************************************************/
-static void MatrixButtonStartDebounce(uint8_t row)
+static void MatrixButtonGetKeyEdge(uint8_t keypadId, uint16_t *pressEdge, uint16_t *releaseEdge)
+{
+	sMATRIX_BUTTON_KEYPAD *psKeypad = &sMatrixButtonPro.sKeypad[keypadId];
+
+	__disable_irq();
+	*pressEdge = psKeypad->pressEdge;
+	*releaseEdge = psKeypad->releaseEdge;
+	psKeypad->pressEdge = 0;
+	psKeypad->releaseEdge = 0;
+	__enable_irq();
+}
+
+/*******************************************************************************
+ * @fn      MatrixButtonSetDebounce
+ * @brief   Matrix button set debounce latency of one key, periodic and DMA
+ *			mode only, latency = debounceScan * full scan period
+ * @param   keypadId
+ *			key
+ *			debounceScan
+ * @return  None
+ ******************************************************************************/
+static void MatrixButtonSetDebounce(uint8_t keypadId, uint8_t key, uint8_t debounceScan)
+{
+#if MATRIX_BUTTON_SCAN_MODE != MATRIX_BUTTON_EXTI_MODE
+	if(key < NUM_OF_MATRIX_BUTTON && debounceScan > 0)
+	{
+		sMatrixButtonPro.sKeypad[keypadId].debounceScan[key] = debounceScan;
+	}
+#endif
+}
+
+/*******************************************************************************
+ * @fn      MatrixButtonGetKeyEvent
+ * @brief   Matrix button take oldest key event from queue of the keypad
+ * @param   keypadId
+ *			psKeyEvent
+ * @return  true	Event is taken
+ *			false	Queue is empty
+ ******************************************************************************/
+static bool MatrixButtonGetKeyEvent(uint8_t keypadId, sKEY_EVENT *psKeyEvent)
 {
-	sSoftwareTimer.Start(sMatrixButtonPro.debounceTimerId[row], DEBOUNCE_DELAY);
+	sMATRIX_BUTTON_KEYPAD *psKeypad = &sMatrixButtonPro.sKeypad[keypadId];
+
+	if(psKeypad->keyEventTail == psKeypad->keyEventHead)
+	{
+		return false;
+	}
+	*psKeyEvent = psKeypad->sKeyEvent[psKeypad->keyEventTail];
+	psKeypad->keyEventTail = (psKeypad->keyEventTail + 1) % NUM_OF_KEY_EVENT;
+	return true;
+}
+
+/*******************************************************************************
+ * @fn      MatrixButtonSetRepeat
+ * @brief   Matrix button set hold timing (ms), take effect on next press
+ * @param   keypadId
+ *			longPressDelay
+ *			repeatDelay				Press to first repeat
+ *			repeatInterval			First repeat interval
+ *			repeatMinimumInterval	Fastest repeat interval
+ * @return  None
+ ******************************************************************************/
+static void MatrixButtonSetRepeat(uint8_t keypadId, uint16_t longPressDelay, uint16_t repeatDelay, uint16_t repeatInterval, uint16_t repeatMinimumInterval)
+{
+	sMATRIX_BUTTON_KEYPAD *psKeypad = &sMatrixButtonPro.sKeypad[keypadId];
+
+	__disable_irq();
+	psKeypad->longPressDelaySetting = longPressDelay;
+	psKeypad->repeatDelaySetting = repeatDelay;
+	psKeypad->repeatIntervalSetting = repeatInterval;
+	psKeypad->repeatMinimumIntervalSetting = (repeatMinimumInterval > 0) ? repeatMinimumInterval : 1;
+	__enable_irq();
+}
+
+/*******************************************************************************
+ * @fn      MatrixButtonEnterLowPower
+ * @brief   Matrix button hand over to row interrupt before stop 2 mode, call
+ *			with interrupt disabled. All columns are driven low so any key
+ *			press wake up the MCU through row EXTI.
+ * @param   None
+ * @return  true	Ready for stop 2 mode
+ *			false	Key is held or being scanned, stay awake
+ ******************************************************************************/
+static bool MatrixButtonEnterLowPower(void)
+{
+	uint8_t i = 0;
+#if MATRIX_BUTTON_SCAN_MODE != MATRIX_BUTTON_EXTI_MODE
+	sMATRIX_BUTTON_KEYPAD *psKeypad;
+#endif
+
+	for(i = 0; i < sMatrixButtonPro.usedKeypad; i++)
+	{
+#if MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_EXTI_MODE
+		// Columns are low and row interrupt is armed whenever not scanning
+		if(sMatrixButtonPro.sKeypad[i].isScanning)
+#else
+		if(!IsKeyIdle(&sMatrixButtonPro.sKeypad[i]))
+#endif
+		{
+			return false;
+		}
+	}
+#if MATRIX_BUTTON_SCAN_MODE != MATRIX_BUTTON_EXTI_MODE
+#if MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_DMA_MODE
+	// Pause in the middle of a step, DMA channels keep their position
+	sMatrixButtonPro.scanTimerHandle.Instance->CR1 &= ~TIM_CR1_CEN;
+	for(i = 0; i < MATRIX_BUTTON_DMA_COLUMN_PORT; i++)
+	{
+		sMatrixButtonPro.columnOutput[i] = sMatrixButtonPro.columnPort[i]->ODR & sMatrixButtonPro.columnMask[i];
+	}
+#else
+	sSoftwareTimer.Stop(sMatrixButtonPro.scanTimerId);
+#endif
+	for(i = 0; i < sMatrixButtonPro.usedKeypad; i++)
+	{
+		psKeypad = &sMatrixButtonPro.sKeypad[i];
+		memset(psKeypad->integrator, 0, sizeof(psKeypad->integrator));
+		WriteAllColumn(psKeypad, GPIO_PIN_RESET);
+		__HAL_GPIO_EXTI_CLEAR_IT(psKeypad->rowExtiMask);
+		EXTI->IMR1 |= psKeypad->rowExtiMask;
+	}
+#endif
+	sMatrixButtonPro.isLowPower = true;
+	return true;
+}
+
+/*******************************************************************************
+ * @fn      MatrixButtonExitLowPower
+ * @brief   Matrix button resume scan after clock restored, call with
+ *			interrupt disabled. The key woke up the MCU is scanned at once.
+ * @param   None
+ * @return  true	Woken up by key press
+ *			false
+ ******************************************************************************/
+static bool MatrixButtonExitLowPower(void)
+{
+	uint8_t i = 0;
+	bool isKeyWake = false;
+	sMATRIX_BUTTON_KEYPAD *psKeypad;
+
+	if(!sMatrixButtonPro.isLowPower)
+	{
+		return false;
+	}
+	sMatrixButtonPro.isLowPower = false;
+	for(i = 0; i < sMatrixButtonPro.usedKeypad; i++)
+	{
+		psKeypad = &sMatrixButtonPro.sKeypad[i];
+		if((EXTI->PR1 & psKeypad->rowExtiMask) == 0)
+		{
+#if MATRIX_BUTTON_SCAN_MODE != MATRIX_BUTTON_EXTI_MODE
+			EXTI->IMR1 &= ~psKeypad->rowExtiMask;
+			WriteAllColumn(psKeypad, GPIO_PIN_SET);
+#endif
+			continue;
+		}
+		isKeyWake = true;
+#if MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_EXTI_MODE
+		// Skip debounce delay, scan only report a key seen on a full scan. Row
+		// interrupt still run after and find the scan in progress.
+		if(!psKeypad->isScanning)
+		{
+			StartScan(psKeypad);
+		}
+#else
+		EXTI->IMR1 &= ~psKeypad->rowExtiMask;
+		__HAL_GPIO_EXTI_CLEAR_IT(psKeypad->rowExtiMask);
+		WriteAllColumn(psKeypad, GPIO_PIN_SET);
+		WakeScan(psKeypad);
+#endif
+	}
+#if MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_DMA_MODE
+	// Restore column output of the paused step
+	for(i = 0; i < MATRIX_BUTTON_DMA_COLUMN_PORT; i++)
+	{
+		sMatrixButtonPro.columnPort[i]->BSRR = sMatrixButtonPro.columnOutput[i] | ((sMatrixButtonPro.columnMask[i] & ~sMatrixButtonPro.columnOutput[i]) << 16);
+	}
+	sMatrixButtonPro.scanTimerHandle.Instance->CR1 |= TIM_CR1_CEN;
+#elif MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_PERIODIC_MODE
+	sSoftwareTimer.Start(sMatrixButtonPro.scanTimerId, MATRIX_BUTTON_SCAN_PERIOD);
+#endif
+	return isKeyWake;
 }
 
 // MAtrix button function structure
@@ -211,4 +1197,27 @@ sMATRIX_BUTTON sMatrixButton =
 	MatrixButtonInitialize,
 	MatrixButtonGetPressedButton,
 	MatrixButtonStartDebounce,
+	MatrixButtonGetKeyState,
+	MatrixButtonGetKeyEdge,
+	MatrixButtonSetDebounce,
+	MatrixButtonGetKeyEvent,
+	MatrixButtonSetRepeat,
+	MatrixButtonEnterLowPower,
+	MatrixButtonExitLowPower,
 };
+
+/*******************************************************************************
+ * INTERRUPT CALLBACK
+ ******************************************************************************/
+/*******************************************************************************
+ * @fn      MatrixButtonDmaInterruptCallback
+ * @brief   Row sample DMA interrupt callback, DMA mode only
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+void MatrixButtonDmaInterruptCallback(void)
+{
+#if MATRIX_BUTTON_SCAN_MODE == MATRIX_BUTTON_DMA_MODE
+	HAL_DMA_IRQHandler(&sMatrixButtonPro.rowDmaHandle[MATRIX_BUTTON_DMA_ROW_PORT - 1]);
+#endif
+}
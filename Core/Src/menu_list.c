@@ -10,12 +10,34 @@
  ******************************************************************************/
 #include "menu_list.h"
 #include "lcd.h"
-#include "software_timer.h"
 #include "rtc.h"
+#include "coroutine.h"
+#include "diagnostic.h"
+#include "key_map.h"
+#include "field_editor.h"
+#include "flash_store.h"
+#include "report.h"
+#include "temperature_sensor.h"
+#include "power_manager.h"
+#include "menu_tree.h"
 
 /*******************************************************************************
  * CONSTANTS
  ******************************************************************************/
+// Shortcut path typed on date time screen, one digit per level
+#define MENU_SHORTCUT_MAX_DEPTH		6
+// Recent used menu kept for '0' on date time screen
+#define MENU_RECENT_COUNT			4
+// Title list scrollbar at last column, one CGRAM character per line
+// (PLUG_LOGO and USB_LOGO are not used by menu)
+#define MENU_SCROLLBAR_CHARACTER	PLUG_LOGO
+#define MENU_SCROLLBAR_THUMB		0b00001110
+#define MENU_VIEWPORT_TITLE_LENGTH	(LCD_MAX_DISPLAY_LENGTH - 2)
+// Report list length, newest first
+#define MENU_DAILY_REPORT_COUNT		365
+#define MENU_WEEKLY_REPORT_COUNT	52
+#define MENU_MONTHLY_REPORT_COUNT	12
+#define MENU_SECOND_PER_DAY			86400
 
 /*******************************************************************************
  * PUBLIC VARIABLES
@@ -24,32 +46,116 @@
 /*******************************************************************************
  * LOCAL VARIBLES
  ******************************************************************************/
+// Diagnostic view pages, Up / Down to select, power manager page has no event
+// flag
+static const struct
+{
+	eEVENT_FLAGS eEventFlag;
+	eDIAGNOSTIC_METRIC eDiagnosticMetric;
+	ePOWER_MODE ePowerMode;
+	char title[TITLE_MAX_LENGTH];
+}
+diagnosticPage[] =
+{
+	{matrixButtonEventFlag, DIAGNOSTIC_DEBOUNCE, maximumPowerMode, "Key Debounce"},
+	{matrixButtonEventFlag, DIAGNOSTIC_DISPATCH, maximumPowerMode, "Key Dispatch"},
+	{matrixButtonEventFlag, DIAGNOSTIC_HANDLER, maximumPowerMode, "Key Handler"},
+	{matrixButtonEventFlag, DIAGNOSTIC_WAKE, maximumPowerMode, "Key Wake"},
+	{matrixButtonEventFlag, DIAGNOSTIC_DISPLAY, maximumPowerMode, "Key Display"},
+	{rtcOneSecondEventFlag, DIAGNOSTIC_DISPATCH, maximumPowerMode, "RTC Dispatch"},
+	{rtcOneSecondEventFlag, DIAGNOSTIC_HANDLER, maximumPowerMode, "RTC Handler"},
+	{maximumEventFlag, maximumDiagnosticMetric, POWER_RUN_MODE, "Run Time/Current"},
+	{maximumEventFlag, maximumDiagnosticMetric, POWER_SLEEP_MODE, "Sleep Wake/Time"},
+	{maximumEventFlag, maximumDiagnosticMetric, POWER_STOP2_MODE, "Stop2 Wake/Time"},
+};
 
 /*******************************************************************************
  * ENUMERATE
  ******************************************************************************/
-// Menu level define
-typedef enum
-{
-    LEVEL1 = 0,
-    LEVEL2,
-    LEVEL3,
-    LEVEL4,
-    LEVEL5,
- }
-eMENU_LEVEL;
-
 // Menu type define
 typedef enum
 {
     TITLE = 0,
-    NUMBER,
-    ALPHABET,
-    OPTION,
+    EDITOR,
     INFO,
+    VIRTUAL,
  }
 eMENU_TYPE;
 
+// Menu action define
+typedef enum
+{
+	DATE_TIME_ACTION = 0,
+	EDITOR_ACTION,
+	TITLE_ACTION,
+	INFO_ACTION,
+	DIAGNOSTIC_ACTION,
+	VIRTUAL_ACTION,
+	TEMPERATURE_ACTION,
+	maximumMenuAction,
+}
+eMENU_ACTION;
+
+// Menu validator define
+typedef enum
+{
+	VALIDATE_NONE = 0,
+	VALIDATE_RANGE,
+	VALIDATE_LENGTH,
+	VALIDATE_PASSWORD,
+	VALIDATE_MATCH,
+}
+eMENU_VALIDATOR;
+
+// Flash store key define, stored value is found by key so never reorder
+typedef enum
+{
+	STORE_USER_NAME = 0,
+	STORE_SERIAL_NUMBER,
+	STORE_TEMPERATURE,
+	STORE_BACKLIGHT,
+	STORE_PASSWORD,
+	maximumStoreKey,
+	STORE_NONE = 0xFF,
+}
+eMENU_STORE_KEY;
+
+// Menu ID define, one per menu tree line, 16 bits link
+typedef enum
+{
+#define MENU_ID(id, parent, child, previous, next, title, action, type, hidden, maxLength, value)	id,
+	MENU_TREE(MENU_ID)
+#undef MENU_ID
+	maximumMenu,
+	MENU_NONE = maximumMenu,
+}
+eMENU_ID;
+
+// Menu link as constant, named <id>_PARENT / _CHILD / _PREVIOUS / _NEXT,
+// only used to check menu tree at build time
+enum
+{
+#define MENU_LINK_ID(id, parent, child, previous, next, title, action, type, hidden, maxLength, value) \
+	id##_PARENT = parent, id##_CHILD = child, id##_PREVIOUS = previous, id##_NEXT = next,
+	MENU_TREE(MENU_LINK_ID)
+#undef MENU_LINK_ID
+	MENU_NONE_PARENT = MENU_NONE,
+	MENU_NONE_CHILD = MENU_NONE,
+	MENU_NONE_PREVIOUS = MENU_NONE,
+	MENU_NONE_NEXT = MENU_NONE,
+};
+
+// Hand written link must agree both way, a broken link stop the build
+// instead of corrupting navigation. next(previous(n)) == n, sibling share a
+// parent, parent(child(n)) == n and only the first sibling is a child.
+#define MENU_LINK_CHECK(id, parent, child, previous, next, title, action, type, hidden, maxLength, value) \
+	_Static_assert((next == MENU_NONE) || ((int)next##_PREVIOUS == id && (int)next##_PARENT == parent), #id " next link broken"); \
+	_Static_assert((previous == MENU_NONE) || ((int)previous##_NEXT == id), #id " previous link broken"); \
+	_Static_assert((child == MENU_NONE) || ((int)child##_PARENT == id && (int)child##_PREVIOUS == MENU_NONE), #id " child link broken"); \
+	_Static_assert((previous != MENU_NONE) || (parent == MENU_NONE) || ((int)parent##_CHILD == id), #id " first sibling is not child of parent");
+MENU_TREE(MENU_LINK_CHECK)
+#undef MENU_LINK_CHECK
+
 /*******************************************************************************
  * STRUCTURE
  ******************************************************************************/
@@ -69,1039 +175,1354 @@ uMENU_ATTRIBUTE;
 // Menu action function.
 typedef void (*MENU_ACTION)(void);
 
-// Define menu structure
+// Menu commit function, return false to reject the value
+typedef bool (*MENU_COMMIT)(const char *value);
+
+// Virtual menu entry count
+typedef uint16_t (*MENU_COUNT)(void);
+
+// Virtual menu entry title, TITLE_MAX_LENGTH buffer
+typedef void (*MENU_ENTRY_TITLE)(uint16_t index, char *title);
+
+// Virtual menu opened entry, one LCD line per call, TITLE_MAX_LENGTH buffer
+typedef void (*MENU_ENTRY_OPEN)(uint16_t index, uint8_t line, char *string);
+
+// Define menu provider structure, one per virtual menu list
+typedef struct
+{
+	MENU_COUNT GetCount;
+	MENU_ENTRY_TITLE GetTitle;
+	MENU_ENTRY_OPEN Open;
+}
+sMENU_PROVIDER;
+
+// Define menu field structure, one per editable value
+typedef struct
+{
+	const char *prompt;
+	uint8_t eFieldType;
+	uint8_t eMenuValidator;
+	uint8_t minimum;
+	uint8_t maximum;
+	uint8_t step;
+	uint16_t nextMenu;
+	MENU_COMMIT commit;
+	uint8_t eMenuStoreKey;
+}
+sMENU_FIELD;
+
+// Define menu structure, menu tree is constant and stay in flash. Links
+// are menu ID and title is offset in title pool, 14 bytes per menu.
 struct sMENU
 {
-	eMENU_LEVEL eMenuLevel;
-	uint8_t index;
-	char title[TITLE_MAX_LENGTH];
-	MENU_ACTION menuAction;
+	uint16_t title;
+	uint16_t parent;
+	uint16_t child;
+	uint16_t previous;
+	uint16_t next;
 	uMENU_ATTRIBUTE uMenuAttribute;
-	struct sMENU *pNext;
-	struct sMENU *pPrevious;
-	struct sMENU *pParent;
-	struct sMENU *pChild;
+	uint8_t eMenuAction;
+	uint8_t eMenuValue;
 };
 
+// Define menu title pool structure, one member per menu so offsetof give
+// the title offset at compile time
+typedef struct
+{
+#define MENU_TITLE_MEMBER(id, parent, child, previous, next, title, action, type, hidden, maxLength, value)	char id[sizeof(title)];
+	MENU_TREE(MENU_TITLE_MEMBER)
+#undef MENU_TITLE_MEMBER
+}
+sMENU_TITLE_POOL;
+
 // Define menu list property structure
 typedef struct
 {
-	uint8_t usedMenu;
-	uint8_t keyinCounter;
-	uint8_t alphabetRepeatCounter;
-	uint32_t previousPressedButton;
-	uint8_t AlphabetButtonTimerId;
-	struct sMENU *pCurrentMenu;
-	struct sMENU *pOptionMenu;
-	struct sMENU sMenu[NUM_OF_MENU_LIST];
+	uint8_t dateTimeCoroutineId;
+	const struct sMENU *pCurrentMenu;
+	// Field of current menu while editor is open
+	sFIELD sField;
+	// Key in value and selected option of each editable menu
+	char value[maximumMenuValue][TITLE_MAX_LENGTH];
 	char password[7];
-	bool leapYear;
-	uint8_t lastDate;
-	uint8_t dateTimeIndex;
-	uint8_t passwordIndex;
-	uint8_t firstMenuIndex;
-	uint8_t yearIndex;
-	uint8_t monthIndex;
-	uint8_t dateIndex;
-	uint8_t hourIndex;
-	uint8_t minuteIndex;
-	uint8_t secondIndex;
-	uint8_t weekDayIndex;
-	uint8_t oldPasswordIndex;
-	uint8_t newPasswordIndex;
-	uint8_t confirmPasswordIndex;
+	uint8_t diagnosticPage;
+	// Shortcut path index built once, children of menu i are pathChild[pathStart[i]]
+	// to pathChild[pathStart[i + 1] - 1] in next link order
+	uint16_t pathStart[maximumMenu + 1];
+	uint16_t pathChild[maximumMenu];
+	// Shortcut digit typed on date time screen
+	char shortcut[MENU_SHORTCUT_MAX_DEPTH];
+	uint8_t shortcutDepth;
+	// Recent used menu, most recent first, MENU_NONE if empty
+	uint16_t recentMenu[MENU_RECENT_COUNT];
+	bool isRecentShown;
+	uint8_t recentIndex;
+	// Shortcut target behind password, opened after password accepted
+	uint16_t pendingMenu;
+	// Title list window, first menu shown and what is on LCD. Other screen
+	// rewrite whole line, so viewport is redrawn after it.
+	uint16_t viewportTop;
+	bool isViewportShown;
+	char viewport[LCD_MAX_LINE][LCD_MAX_DISPLAY_LENGTH];
+	uint8_t scrollbar[LCD_MAX_LINE][8];
+	// Virtual menu being browsed, its selected entry and window, nothing
+	// is kept per entry
+	uint16_t virtualMenu;
+	uint16_t virtualIndex;
+	uint16_t virtualTop;
+	bool isVirtualOpen;
 }
 sMENU_PRO;
 static sMENU_PRO sMenuPro;
 
+// All menu titles back to back
+static const sMENU_TITLE_POOL menuTitlePool =
+{
+#define MENU_TITLE_STRING(id, parent, child, previous, next, title, action, type, hidden, maxLength, value)	title,
+	MENU_TREE(MENU_TITLE_STRING)
+#undef MENU_TITLE_STRING
+};
+
+// Menu tree, action jump table and field table, defined after action functions
+static const struct sMENU menuTree[maximumMenu];
+static const MENU_ACTION menuActionTable[maximumMenuAction];
+static const sMENU_FIELD menuField[maximumMenuValue];
+static const sMENU_PROVIDER menuProvider[maximumMenuProvider];
+
+// Menu ID to menu, NULL for MENU_NONE
+#define MENU_LINK(id)		(((id) == MENU_NONE) ? NULL : &menuTree[(id)])
+// Menu to menu ID
+#define MENU_INDEX(psMenu)	((uint16_t)((psMenu) - menuTree))
+// Menu title in title pool
+#define MENU_TITLE(psMenu)	((const char*)&menuTitlePool + (psMenu)->title)
+
 /*******************************************************************************
  * LOCAL FUNCTIONS
  ******************************************************************************/
-static uint8_t MenuListAddMenu(eMENU_LEVEL eMenuLevel, char* title, MENU_ACTION menuAction, eMENU_TYPE eMenuType, bool isHidden, uint8_t keyinMaxLength);
-static void MenuListPrepareKeyin(void);
-static bool MenuListCheckDataValid(uint32_t minimumData, uint32_t data, uint32_t maximumData, struct sMENU *nextCurrentMenu);
+static bool MenuListValidate(const sMENU_FIELD *psMenuField, const char *value);
 static void MenuListProcessData(void);
 static void MenuListNavigationButton(uint32_t pressedButton);
-static void MenuListNumberButton(uint32_t pressedButton);
-static void MenuListAlphabetButton(uint32_t pressedButton);
-static void MenuListOptionButton(uint32_t pressedButton);
+static void MenuListEditorButton(eFIELD_RESULT eFieldResult);
+static const char* MenuListOptionText(uint8_t index);
+static bool MenuListIsDateTimeShown(void);
+static void MenuListBuildPathIndex(void);
+static uint16_t MenuListResolvePath(void);
+static const char* MenuListShortcutTitle(uint16_t menu);
+static void MenuListAddRecent(uint16_t menu);
+static void MenuListShortcutShow(void);
+static void MenuListJump(uint16_t menu);
+static bool MenuListShortcutButton(uint32_t pressedButton);
+static void MenuListShow(void);
+static void MenuListViewportWrite(uint8_t line, const char *data);
+static void MenuListViewportLine(uint8_t line, const char *title, bool isSelected, bool isScrolled);
+static void MenuListScrollbar(uint16_t index, uint16_t count);
+static void MenuListVirtualButton(eKEY_FUNCTION eKeyFunction);
 
 /*******************************************************************************
- * @fn      MenuListAddMenu
- * @brief   Add menu to menu list
- * @param   eMenuLevel
- *			title
- *			menuAction
- *			eMenuType
- *			isHidden
- *			keyinMaxLength
- * @return  index
+ * @fn      MenuListValidate
+ * @brief   Check key in data or selected option against field validator
+ * @paramz  psMenuField
+ * 			value
+ * @return  True if valid
  ******************************************************************************/
-static uint8_t MenuListAddMenu(eMENU_LEVEL eMenuLevel, char* title, MENU_ACTION menuAction, eMENU_TYPE eMenuType, bool isHidden, uint8_t keyinMaxLength)
+static bool MenuListValidate(const sMENU_FIELD *psMenuField, const char *value)
 {
-	int8_t i = 0;
-	int8_t levelDifferent = 0;
-	struct sMENU *psMenu;
+	uint32_t data;
 
-    if(sMenuPro.usedMenu == NUM_OF_MENU_LIST)
-    {
-    	// Increase "NUM_OF_MENU_LIST"
-    	for(;;)
-    	{
-    	}
-    }
-	sMenuPro.sMenu[sMenuPro.usedMenu].eMenuLevel = eMenuLevel;
-	sMenuPro.sMenu[sMenuPro.usedMenu].index = sMenuPro.usedMenu;
-	sprintf(sMenuPro.sMenu[sMenuPro.usedMenu].title, "%s", title);
-	sMenuPro.sMenu[sMenuPro.usedMenu].menuAction = menuAction;
-	sMenuPro.sMenu[sMenuPro.usedMenu].uMenuAttribute.eMenuType = eMenuType;
-	sMenuPro.sMenu[sMenuPro.usedMenu].uMenuAttribute.isHidden = isHidden;
-	sMenuPro.sMenu[sMenuPro.usedMenu].uMenuAttribute.keyinMaxLength = keyinMaxLength;
-
-	if(sMenuPro.usedMenu > 0)
-	{
-		levelDifferent = sMenuPro.sMenu[sMenuPro.usedMenu - 1].eMenuLevel - sMenuPro.sMenu[sMenuPro.usedMenu].eMenuLevel;
-		switch(levelDifferent)
-		{
-			// Current menu is previous menu's child
-			case -1:
-				sMenuPro.sMenu[sMenuPro.usedMenu - 1].pChild = &sMenuPro.sMenu[sMenuPro.usedMenu];
-				sMenuPro.sMenu[sMenuPro.usedMenu].pParent = &sMenuPro.sMenu[sMenuPro.usedMenu - 1];
-				break;
-			// Current menu is previous menu's next
-			case 0:
-				sMenuPro.sMenu[sMenuPro.usedMenu - 1].pNext = &sMenuPro.sMenu[sMenuPro.usedMenu];
-				sMenuPro.sMenu[sMenuPro.usedMenu].pPrevious = &sMenuPro.sMenu[sMenuPro.usedMenu - 1];
-				sMenuPro.sMenu[sMenuPro.usedMenu].pParent = sMenuPro.sMenu[sMenuPro.usedMenu - 1].pParent;
-				break;
-			default:
-				if(levelDifferent < 0)
-				{
-					break;
-				}
-				psMenu = &sMenuPro.sMenu[sMenuPro.usedMenu - 1];
-				for(i = 0; i < levelDifferent; i++)
-				{
-					psMenu = psMenu->pParent;
-				}
-				psMenu->pNext = &sMenuPro.sMenu[sMenuPro.usedMenu];
-				sMenuPro.sMenu[sMenuPro.usedMenu].pPrevious = psMenu;
-				sMenuPro.sMenu[sMenuPro.usedMenu].pParent = psMenu->pParent;
-				break;
-		}
+	switch(psMenuField->eMenuValidator)
+	{
+		case VALIDATE_RANGE:
+			if(value[0] == 0)
+			{
+				return false;
+			}
+			data = strtoul(value, NULL, 10);
+			return (psMenuField->minimum <= data) && (data <= psMenuField->maximum);
+		case VALIDATE_LENGTH:
+			data = strlen(value);
+			return (psMenuField->minimum <= data) && (data <= psMenuField->maximum);
+		case VALIDATE_PASSWORD:
+			return strcmp(sMenuPro.password, value) == 0;
+		case VALIDATE_MATCH:
+			return strcmp(sMenuPro.value[psMenuField->minimum], value) == 0;
+		default:
+			return true;
 	}
-	sMenuPro.usedMenu++;
-	return sMenuPro.usedMenu - 1;
 }
 
 /*******************************************************************************
- * @fn      MenuListPrepareKeyin
- * @brief   Prepare user key in data
+ * @fn      MenuListProcessData
+ * @brief   Process user key in data
  * @paramz  None
  * @return  None
  ******************************************************************************/
-static void MenuListPrepareKeyin(void)
+static void MenuListProcessData(void)
 {
-	sLcd.WriteString(1, 0, "                ", LCD_ALIGN_LEFT);
-	sMenuPro.keyinCounter = 0;
-	sMenuPro.alphabetRepeatCounter = 0;
-	sMenuPro.previousPressedButton = 0;
-	sLcd.GoTo(1, 0);
-	sLcd.SetAttribute(1, CURSOR_ON_TYPE);
+	const sMENU_FIELD *psMenuField = &menuField[sMenuPro.pCurrentMenu->eMenuValue];
+	char *value = sMenuPro.value[sMenuPro.pCurrentMenu->eMenuValue];
+
+	snprintf(value, TITLE_MAX_LENGTH, "%s", sFieldEditor.GetText());
+	if(!MenuListValidate(psMenuField, value) ||
+	   (psMenuField->commit != NULL && !psMenuField->commit(value)))
+	{
+		// Start again with empty value
+		value[0] = 0;
+		MenuListShow();
+		return;
+	}
+	if(psMenuField->eMenuStoreKey != STORE_NONE)
+	{
+		// Programmed later, never wait for flash here
+		sFlashStore.Write(psMenuField->eMenuStoreKey, value, strlen(value));
+	}
+	sFieldEditor.Close();
+	if(sMenuPro.pendingMenu != MENU_NONE)
+	{
+		// Password of a shortcut accepted
+		sMenuPro.pCurrentMenu = &menuTree[sMenuPro.pendingMenu];
+		sMenuPro.pendingMenu = MENU_NONE;
+	}
+	else if(psMenuField->nextMenu != MENU_NONE)
+	{
+		sMenuPro.pCurrentMenu = &menuTree[psMenuField->nextMenu];
+	}
+	else
+	{
+		sMenuPro.pCurrentMenu = MENU_LINK(sMenuPro.pCurrentMenu->parent);
+		MenuListAddRecent(MENU_INDEX(sMenuPro.pCurrentMenu));
+	}
+	MenuListShow();
 }
 
 /*******************************************************************************
- * @fn      MenuListCheckDataValid
- * @brief   Check key in data valid or not
- * @paramz  minimumData
- * 			data
- * 			maximumData
- * 			nextCurrentMenu
+ * @fn      MenuListNavigationButton
+ * @brief   Menu list navigation button
+ * @paramz  pressedButton
  * @return  None
  ******************************************************************************/
-static bool MenuListCheckDataValid(uint32_t minimumData, uint32_t data, uint32_t maximumData, struct sMENU *nextCurrentMenu)
+static void MenuListNavigationButton(uint32_t pressedButton)
 {
-	if((minimumData <= data) && (data <= maximumData))
+	const struct sMENU *pNewMenu = NULL;
+
+	switch(sKeyMap.Get(pressedButton)->eKeyFunction)
 	{
-		sLcd.SetAttribute(1, CURSOR_OFF_TYPE);
-		sMenuPro.pCurrentMenu = nextCurrentMenu;
-		sMenuPro.pCurrentMenu->menuAction();
-		return true;
+		case KEY_UP:
+			if(sMenuPro.pCurrentMenu->previous != MENU_NONE)
+			{
+				pNewMenu = MENU_LINK(sMenuPro.pCurrentMenu->previous);
+			}
+			break;
+		case KEY_DOWN:
+			if(sMenuPro.pCurrentMenu->next != MENU_NONE)
+			{
+				pNewMenu = MENU_LINK(sMenuPro.pCurrentMenu->next);
+			}
+			break;
+		case KEY_EXIT:
+			if(sMenuPro.pCurrentMenu->parent != MENU_NONE)
+			{
+				pNewMenu = MENU_LINK(sMenuPro.pCurrentMenu->parent);
+			}
+			break;
+		case KEY_ENTER:
+			if(sMenuPro.pCurrentMenu->child != MENU_NONE)
+			{
+				pNewMenu = MENU_LINK(sMenuPro.pCurrentMenu->child);
+			}
+			break;
+		default:
+			break;
 	}
-	else
+	if(pNewMenu != NULL)
 	{
-		return false;
+		sMenuPro.pCurrentMenu = pNewMenu;
+		MenuListShow();
 	}
 }
 
 /*******************************************************************************
- * @fn      MenuListProcessData
- * @brief   Process user key in data
- * @paramz  None
+ * @fn      MenuListEditorButton
+ * @brief   Menu list editor button, field editor draw the field
+ * @paramz  eFieldResult	Field editor result of the key
  * @return  None
  ******************************************************************************/
-static void MenuListProcessData(void)
+static void MenuListEditorButton(eFIELD_RESULT eFieldResult)
 {
-	bool result = true;
-	uint32_t data;
-	static RTC_DateTypeDef sDate;
-	static RTC_TimeTypeDef sTime;
+	switch(eFieldResult)
+	{
+		case FIELD_DONE:
+			MenuListProcessData();
+			break;
+		case FIELD_CANCEL:
+			sFieldEditor.Close();
+			sMenuPro.pendingMenu = MENU_NONE;
+			sMenuPro.pCurrentMenu = MENU_LINK(sMenuPro.pCurrentMenu->parent);
+			MenuListShow();
+			break;
+		default:
+			break;
+	}
+}
 
-	if(sMenuPro.pCurrentMenu->uMenuAttribute.eMenuType == NUMBER ||
-	   sMenuPro.pCurrentMenu->uMenuAttribute.eMenuType == ALPHABET)
+/*******************************************************************************
+ * @fn      MenuListOptionText
+ * @brief   Option title of current menu, options are children of the menu
+ * @paramz  index
+ * @return  Option title
+ ******************************************************************************/
+static const char* MenuListOptionText(uint8_t index)
+{
+	const struct sMENU *psMenu = MENU_LINK(sMenuPro.pCurrentMenu->child);
+
+	while(index-- > 0 && psMenu->next != MENU_NONE)
 	{
-		sMenuPro.pCurrentMenu->title[sMenuPro.keyinCounter] = 0;
+		psMenu = MENU_LINK(psMenu->next);
 	}
-	if(sMenuPro.pCurrentMenu->index == sMenuPro.passwordIndex)
+	return MENU_TITLE(psMenu);
+}
+
+/*******************************************************************************
+ * @fn      MenuListInfoButton
+ * @brief   Menu list info button
+ * @paramz  pressedButton
+ * @return  None
+ ******************************************************************************/
+static void MenuListInfoButton(uint32_t pressedButton)
+{
+	eKEY_FUNCTION eKeyFunction = sKeyMap.Get(pressedButton)->eKeyFunction;
+
+	if(eKeyFunction == KEY_EXIT)
+	{
+		sMenuPro.pCurrentMenu = MENU_LINK(sMenuPro.pCurrentMenu->parent);
+		MenuListShow();
+	}
+	else if(MENU_INDEX(sMenuPro.pCurrentMenu) == MENU_DIAGNOSTIC_VALUE)
 	{
-		// Password correct
-		if(strcmp(sMenuPro.password, sMenuPro.pCurrentMenu->title) == 0)
+		if(eKeyFunction == KEY_UP)
 		{
-			sLcd.SetAttribute(1, CURSOR_OFF_TYPE);
-			sMenuPro.pCurrentMenu = &sMenuPro.sMenu[sMenuPro.firstMenuIndex];
-			sMenuPro.pCurrentMenu->menuAction();
-			return;
+			sMenuPro.diagnosticPage = (sMenuPro.diagnosticPage + (sizeof(diagnosticPage) / sizeof(diagnosticPage[0])) - 1) % (sizeof(diagnosticPage) / sizeof(diagnosticPage[0]));
+			MenuListShow();
 		}
-		// Password wrong
-		else
+		else if(eKeyFunction == KEY_DOWN)
 		{
-			result = false;
+			sMenuPro.diagnosticPage = (sMenuPro.diagnosticPage + 1) % (sizeof(diagnosticPage) / sizeof(diagnosticPage[0]));
+			MenuListShow();
 		}
 	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.yearIndex)
+}
+
+/*******************************************************************************
+ * @fn      MenuListVirtualButton
+ * @brief   Virtual menu button, Up / Down select entry also while opened,
+ * 			Enter open it, Exit close it or leave the list
+ * @paramz  eKeyFunction
+ * @return  None
+ ******************************************************************************/
+static void MenuListVirtualButton(eKEY_FUNCTION eKeyFunction)
+{
+	uint16_t count = menuProvider[sMenuPro.pCurrentMenu->eMenuValue].GetCount();
+
+	switch(eKeyFunction)
 	{
-		if(sMenuPro.keyinCounter > 0)
-		{
-			sscanf(sMenuPro.pCurrentMenu->title, "%ld", &data);
-			sDate.Year = data;
-			if((sDate.Year % 4) != 0)
+		case KEY_UP:
+			if(sMenuPro.virtualIndex == 0)
+			{
+				return;
+			}
+			sMenuPro.virtualIndex--;
+			break;
+		case KEY_DOWN:
+			if(sMenuPro.virtualIndex + 1 >= count)
+			{
+				return;
+			}
+			sMenuPro.virtualIndex++;
+			break;
+		case KEY_ENTER:
+			if(sMenuPro.isVirtualOpen || count == 0)
+			{
+				return;
+			}
+			sMenuPro.isVirtualOpen = true;
+			break;
+		case KEY_EXIT:
+			if(sMenuPro.isVirtualOpen)
 			{
-				sMenuPro.leapYear = false;
+				sMenuPro.isVirtualOpen = false;
 			}
 			else
 			{
-				sMenuPro.leapYear = true;
+				sMenuPro.virtualMenu = MENU_NONE;
+				sMenuPro.pCurrentMenu = MENU_LINK(sMenuPro.pCurrentMenu->parent);
 			}
-			sLcd.SetAttribute(1, CURSOR_OFF_TYPE);
-			sMenuPro.pCurrentMenu = sMenuPro.pCurrentMenu->pNext;
-			sMenuPro.pCurrentMenu->menuAction();
+			break;
+		default:
 			return;
-		}
-		else
-		{
-			result = false;
-		}
 	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.monthIndex)
+	MenuListShow();
+}
+
+/*******************************************************************************
+ * @fn      MenuListIsDateTimeShown
+ * @brief   Check date time screen is shown, not shortcut or recent list
+ * @paramz  None
+ * @return  True if date and time should be drawn
+ ******************************************************************************/
+static bool MenuListIsDateTimeShown(void)
+{
+	return MENU_INDEX(sMenuPro.pCurrentMenu) == MENU_DATE_TIME && sMenuPro.shortcutDepth == 0 && !sMenuPro.isRecentShown;
+}
+
+/*******************************************************************************
+ * @fn      MenuListBuildPathIndex
+ * @brief   List children of every menu in order once, so shortcut digit n is
+ * 			one table read instead of n next links
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void MenuListBuildPathIndex(void)
+{
+	const struct sMENU *psMenu;
+	uint16_t id = 0;
+	uint16_t index = 0;
+
+	for(id = 0; id < maximumMenu; id++)
 	{
-		sscanf(sMenuPro.pCurrentMenu->title, "%ld", &data);
-		sDate.Month = data;
-		if(MenuListCheckDataValid(1, sDate.Month, 12, sMenuPro.pCurrentMenu->pNext))
+		sMenuPro.pathStart[id] = index;
+		for(psMenu = MENU_LINK(menuTree[id].child); psMenu != NULL; psMenu = MENU_LINK(psMenu->next))
 		{
-			switch(sDate.Month)
-			{
-				case 1:
-				case 3:
-				case 5:
-				case 7:
-				case 8:
-				case 10:
-				case 12:
-					sMenuPro.lastDate = 31;
-					break;
-				case 4:
-				case 6:
-				case 9:
-				case 11:
-					sMenuPro.lastDate = 30;
-					break;
-				case 2:
-					if(sMenuPro.leapYear == false)
-					{
-						sMenuPro.lastDate = 28;
-					}
-					else
-					{
-						sMenuPro.lastDate = 29;
-					}
-					break;
-			}
-			return;
-		}
-		else
-		{
-			result = false;
+			sMenuPro.pathChild[index++] = MENU_INDEX(psMenu);
 		}
 	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.dateIndex)
+	sMenuPro.pathStart[maximumMenu] = index;
+}
+
+/*******************************************************************************
+ * @fn      MenuListResolvePath
+ * @brief   Menu of typed shortcut, digit n is n-th child, one table read per
+ * 			digit. Path stop at editor, its children are options
+ * @paramz  None
+ * @return  Menu ID, MENU_NONE if path lead to no menu
+ ******************************************************************************/
+static uint16_t MenuListResolvePath(void)
+{
+	uint16_t menu = MENU_DATE_TIME;
+	uint8_t depth = 0;
+	uint8_t index;
+
+	for(depth = 0; depth < sMenuPro.shortcutDepth; depth++)
 	{
-		sscanf(sMenuPro.pCurrentMenu->title, "%ld", &data);
-		sDate.Date = data;
-		if(MenuListCheckDataValid(1, sDate.Date, sMenuPro.lastDate, sMenuPro.pCurrentMenu->pNext))
-		{
-			return;
-		}
-		else
+		index = sMenuPro.shortcut[depth] - '1';
+		if(menuTree[menu].uMenuAttribute.eMenuType == EDITOR ||
+		   index >= sMenuPro.pathStart[menu + 1] - sMenuPro.pathStart[menu])
 		{
-			result = false;
+			return MENU_NONE;
 		}
+		menu = sMenuPro.pathChild[sMenuPro.pathStart[menu] + index];
 	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.hourIndex)
+
+	return menu;
+}
+
+/*******************************************************************************
+ * @fn      MenuListShortcutTitle
+ * @brief   Name of shortcut or recent menu, editor has no title so use its
+ * 			prompt or its parent title
+ * @paramz  menu
+ * @return  Title
+ ******************************************************************************/
+static const char* MenuListShortcutTitle(uint16_t menu)
+{
+	const struct sMENU *psMenu = &menuTree[menu];
+
+	if(MENU_TITLE(psMenu)[0] != 0)
 	{
-		sscanf(sMenuPro.pCurrentMenu->title, "%ld", &data);
-		sTime.Hours = data;
-		if(MenuListCheckDataValid(0, sTime.Hours, 23, sMenuPro.pCurrentMenu->pNext))
-		{
-			return;
-		}
-		else
-		{
-			result = false;
-		}
+		return MENU_TITLE(psMenu);
 	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.minuteIndex)
+	if(psMenu->uMenuAttribute.eMenuType == EDITOR && menuField[psMenu->eMenuValue].prompt != NULL)
 	{
-		sscanf(sMenuPro.pCurrentMenu->title, "%ld", &data);
-		sTime.Minutes = data;
-		if(MenuListCheckDataValid(0, sTime.Minutes, 59, sMenuPro.pCurrentMenu->pNext))
-		{
-			return;
-		}
-		else
-		{
-			result = false;
-		}
+		return menuField[psMenu->eMenuValue].prompt;
+	}
+	return MENU_TITLE(MENU_LINK(psMenu->parent));
+}
+
+/*******************************************************************************
+ * @fn      MenuListAddRecent
+ * @brief   Move menu to front of recent list
+ * @paramz  menu
+ * @return  None
+ ******************************************************************************/
+static void MenuListAddRecent(uint16_t menu)
+{
+	uint8_t i = 0;
+
+	if(menu == MENU_NONE || menu == MENU_DATE_TIME)
+	{
+		return;
 	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.secondIndex)
+	// Drop old entry of same menu, else the last one
+	for(i = 0; i < MENU_RECENT_COUNT - 1 && sMenuPro.recentMenu[i] != menu; i++);
+	for(; i > 0; i--)
 	{
-		sscanf(sMenuPro.pCurrentMenu->title, "%ld", &data);
-		sTime.Seconds = data;
-		if(MenuListCheckDataValid(0, sTime.Seconds, 59, sMenuPro.pCurrentMenu->pNext))
-		{
-			return;
-		}
-		else
-		{
-			result = false;
-		}
+		sMenuPro.recentMenu[i] = sMenuPro.recentMenu[i - 1];
 	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.weekDayIndex)
+	sMenuPro.recentMenu[0] = menu;
+}
+
+/*******************************************************************************
+ * @fn      MenuListShortcutShow
+ * @brief   Show typed shortcut and its menu, or selected recent menu
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void MenuListShortcutShow(void)
+{
+	char string[LCD_MAX_LENGTH + 1];
+	uint8_t length = 0;
+	uint8_t count = 0;
+	uint8_t i = 0;
+
+	if(sMenuPro.isRecentShown)
 	{
-		if(strcmp(sMenuPro.pCurrentMenu->title, "Monday") == 0)
-		{
-			sDate.WeekDay = RTC_WEEKDAY_MONDAY;
-		}
-		else if(strcmp(sMenuPro.pCurrentMenu->title, "Tuesday") == 0)
-		{
-			sDate.WeekDay = RTC_WEEKDAY_TUESDAY;
-		}
-		else if(strcmp(sMenuPro.pCurrentMenu->title, "Wednesday") == 0)
-		{
-			sDate.WeekDay = RTC_WEEKDAY_WEDNESDAY;
-		}
-		else if(strcmp(sMenuPro.pCurrentMenu->title, "Thursday") == 0)
+		for(count = 0; count < MENU_RECENT_COUNT && sMenuPro.recentMenu[count] != MENU_NONE; count++);
+		sprintf(string, "Recent %d/%d", sMenuPro.recentIndex + 1, count);
+		sLcd.WriteString(0, 0, string, LCD_ALIGN_LEFT);
+		sLcd.WriteString(1, 1, MenuListShortcutTitle(sMenuPro.recentMenu[sMenuPro.recentIndex]), LCD_ALIGN_LEFT);
+		return;
+	}
+	length = sprintf(string, "Go ");
+	for(i = 0; i < sMenuPro.shortcutDepth; i++)
+	{
+		length += sprintf(&string[length], (i == 0) ? "%c" : "-%c", sMenuPro.shortcut[i]);
+	}
+	sLcd.WriteString(0, 0, string, LCD_ALIGN_LEFT);
+	sLcd.WriteString(1, 1, MenuListShortcutTitle(MenuListResolvePath()), LCD_ALIGN_LEFT);
+}
+
+/*******************************************************************************
+ * @fn      MenuListJump
+ * @brief   Open shortcut or recent menu, menu after password ask password
+ * 			first
+ * @paramz  menu
+ * @return  None
+ ******************************************************************************/
+static void MenuListJump(uint16_t menu)
+{
+	uint16_t topMenu = menu;
+
+	sMenuPro.shortcutDepth = 0;
+	sMenuPro.isRecentShown = false;
+	MenuListAddRecent(menu);
+	while(menuTree[topMenu].parent != MENU_DATE_TIME && menuTree[topMenu].parent != MENU_NONE)
+	{
+		topMenu = menuTree[topMenu].parent;
+	}
+	if(topMenu == menuField[VALUE_PASSWORD].nextMenu)
+	{
+		sMenuPro.pendingMenu = menu;
+		menu = MENU_PASSWORD;
+	}
+	sMenuPro.pCurrentMenu = &menuTree[menu];
+	MenuListShow();
+}
+
+/*******************************************************************************
+ * @fn      MenuListShortcutButton
+ * @brief   Date time screen button, digit 1 - 9 type shortcut path and jump at
+ * 			leaf or Enter, '0' show recent list, '0' again next recent, digit
+ * 			or Enter open it, Exit step back
+ * @paramz  pressedButton
+ * @return  True if button is used, else it is a navigation button
+ ******************************************************************************/
+static bool MenuListShortcutButton(uint32_t pressedButton)
+{
+	const sKEY_MAP_ENTRY *psKeyMapEntry = sKeyMap.Get(pressedButton);
+	uint16_t menu;
+	uint8_t index;
+
+	if(sMenuPro.isRecentShown)
+	{
+		index = psKeyMapEntry->digit - '1';
+		if(psKeyMapEntry->digit == '0')
 		{
-			sDate.WeekDay = RTC_WEEKDAY_THURSDAY;
+			sMenuPro.recentIndex++;
+			if(sMenuPro.recentIndex >= MENU_RECENT_COUNT || sMenuPro.recentMenu[sMenuPro.recentIndex] == MENU_NONE)
+			{
+				sMenuPro.recentIndex = 0;
+			}
+			MenuListShortcutShow();
 		}
-		else if(strcmp(sMenuPro.pCurrentMenu->title, "Friday") == 0)
+		else if(psKeyMapEntry->digit != 0 && index < MENU_RECENT_COUNT && sMenuPro.recentMenu[index] != MENU_NONE)
 		{
-			sDate.WeekDay = RTC_WEEKDAY_FRIDAY;
+			MenuListJump(sMenuPro.recentMenu[index]);
 		}
-		else if(strcmp(sMenuPro.pCurrentMenu->title, "Saturday") == 0)
+		else if(psKeyMapEntry->eKeyFunction == KEY_ENTER)
 		{
-			sDate.WeekDay = RTC_WEEKDAY_SATURDAY;
+			MenuListJump(sMenuPro.recentMenu[sMenuPro.recentIndex]);
 		}
-		else if(strcmp(sMenuPro.pCurrentMenu->title, "Sunday") == 0)
+		else if(psKeyMapEntry->eKeyFunction == KEY_EXIT)
 		{
-			sDate.WeekDay = RTC_WEEKDAY_SUNDAY;
+			sMenuPro.isRecentShown = false;
+			MenuListShow();
 		}
-		RtcSetDateTime(&sDate, &sTime);
+		return true;
 	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.oldPasswordIndex)
+	if(psKeyMapEntry->digit == '0')
 	{
-		if(strcmp(sMenuPro.password, sMenuPro.pCurrentMenu->title) == 0)
-		{
-			MenuListCheckDataValid(0, 0, 0, sMenuPro.pCurrentMenu->pNext);
-			return;
-		}
-		else
+		if(sMenuPro.shortcutDepth == 0 && sMenuPro.recentMenu[0] != MENU_NONE)
 		{
-			result = false;
+			sMenuPro.isRecentShown = true;
+			sMenuPro.recentIndex = 0;
+			MenuListShortcutShow();
 		}
+		return true;
 	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.newPasswordIndex)
+	if(psKeyMapEntry->digit != 0)
 	{
-		if(sMenuPro.keyinCounter == 6)
+		if(sMenuPro.shortcutDepth >= MENU_SHORTCUT_MAX_DEPTH)
 		{
-			MenuListCheckDataValid(0, 0, 0, sMenuPro.pCurrentMenu->pNext);
-			return;
+			return true;
 		}
-		else
+		sMenuPro.shortcut[sMenuPro.shortcutDepth++] = psKeyMapEntry->digit;
+		menu = MenuListResolvePath();
+		if(menu == MENU_NONE)
 		{
-			return;
+			// Refuse digit lead to no menu
+			sMenuPro.shortcutDepth--;
 		}
-	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.confirmPasswordIndex)
-	{
-		if(strcmp(sMenuPro.pCurrentMenu->title, sMenuPro.sMenu[sMenuPro.newPasswordIndex].title) == 0)
+		else if(menuTree[menu].child == MENU_NONE || menuTree[menu].uMenuAttribute.eMenuType == EDITOR)
 		{
-			sprintf(sMenuPro.password, "%s", sMenuPro.pCurrentMenu->title);
+			MenuListJump(menu);
+			return true;
 		}
-		else
+		if(sMenuPro.shortcutDepth > 0)
 		{
-			result = false;
+			MenuListShortcutShow();
 		}
+		return true;
 	}
-
-	if(result)
+	if(sMenuPro.shortcutDepth == 0)
 	{
-		sLcd.SetAttribute(1, CURSOR_OFF_TYPE);
-		sMenuPro.pCurrentMenu = sMenuPro.pCurrentMenu->pParent;
-		sMenuPro.pCurrentMenu->menuAction();
+		return false;
 	}
-	else
+	switch(psKeyMapEntry->eKeyFunction)
 	{
-		MenuListPrepareKeyin();
-	}
-}
-
-/*******************************************************************************
- * @fn      MenuListNavigationButton
- * @brief   Menu list navigation button
- * @paramz  pressedButton
- * @return  None
- ******************************************************************************/
-static void MenuListNavigationButton(uint32_t pressedButton)
-{
-	struct sMENU *pNewMenu = NULL;
-
-	switch(pressedButton)
-	{
-		// Up
-		case 0x00000200:
-			if(sMenuPro.pCurrentMenu->pPrevious != NULL)
-			{
-				pNewMenu = sMenuPro.pCurrentMenu->pPrevious;
-			}
+		case KEY_ENTER:
+			MenuListJump(MenuListResolvePath());
 			break;
-		// Down
-		case 0x00002000:
-			if(sMenuPro.pCurrentMenu->pNext != NULL)
+		case KEY_EXIT:
+			if(--sMenuPro.shortcutDepth > 0)
 			{
-				pNewMenu = sMenuPro.pCurrentMenu->pNext;
+				MenuListShortcutShow();
 			}
-			break;
-		// Exit / Left
-		case 0x00001000:
-			if(sMenuPro.pCurrentMenu->pParent != NULL)
-			{
-				pNewMenu = sMenuPro.pCurrentMenu->pParent;
-			}
-			break;
-		// Enter / Right
-		case 0x00004000:
-			if(sMenuPro.pCurrentMenu->pChild != NULL)
+			else
 			{
-				pNewMenu = sMenuPro.pCurrentMenu->pChild;
+				MenuListShow();
 			}
 			break;
 		default:
 			break;
 	}
-	if(pNewMenu != NULL)
+	return true;
+}
+
+/*******************************************************************************
+ * @fn      MenuListShow
+ * @brief   Run action of current menu to show it
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void MenuListShow(void)
+{
+	if(sMenuPro.pCurrentMenu->eMenuAction != TITLE_ACTION && sMenuPro.pCurrentMenu->eMenuAction != VIRTUAL_ACTION)
 	{
-		sMenuPro.pCurrentMenu = pNewMenu;
-		sMenuPro.pCurrentMenu->menuAction();
+		sMenuPro.isViewportShown = false;
 	}
+	menuActionTable[sMenuPro.pCurrentMenu->eMenuAction]();
 }
 
 /*******************************************************************************
- * @fn      MenuListNumberButton
- * @brief   Menu list number button
- * @paramz  pressedButton
+ * @fn      MenuListViewportWrite
+ * @brief   Write one line of title list, only changed character when LCD
+ * 			still show the viewport
+ * @paramz  line
+ * 			data		LCD_MAX_DISPLAY_LENGTH characters
  * @return  None
  ******************************************************************************/
-static void MenuListNumberButton(uint32_t pressedButton)
+static void MenuListViewportWrite(uint8_t line, const char *data)
 {
-	char userKeyin = 0;
+	char *pShown = sMenuPro.viewport[line];
+	bool isAddressed = false;
+	uint8_t i = 0;
 
-	switch(pressedButton)
-	{
-		// 1
-		case 0x00000001:
-			userKeyin = '1';
-			break;
-		// 2
-		case 0x00000002:
-			userKeyin = '2';
-			break;
-		// 3
-		case 0x00000004:
-			userKeyin = '3';
-			break;
-		// 4
-		case 0x00000010:
-			userKeyin = '4';
-			break;
-		// 5
-		case 0x00000020:
-			userKeyin = '5';
-			break;
-		// 6
-		case 0x00000040:
-			userKeyin = '6';
-			break;
-		// 7
-		case 0x00000100:
-			userKeyin = '7';
-			break;
-		// 8
-		case 0x00000200:
-			userKeyin = '8';
-			break;
-		// 9
-		case 0x00000400:
-			userKeyin = '9';
-			break;
-		// 0
-		case 0x00002000:
-			userKeyin = '0';
-			break;
-		// Exit / Left
-		case 0x00001000:
-			if(sMenuPro.keyinCounter > 0)
-			{
-				sLcd.ShiftCursorDisplay(SHIFT_CURSOR_LEFT);
-				sLcd.WriteCharacter(' ');
-				sLcd.ShiftCursorDisplay(SHIFT_CURSOR_LEFT);
-				sMenuPro.keyinCounter--;
-			}
-			else
-			{
-				sLcd.SetAttribute(1, CURSOR_OFF_TYPE);
-				sMenuPro.pCurrentMenu = sMenuPro.pCurrentMenu->pParent;
-				sMenuPro.pCurrentMenu->menuAction();
-				return;
-			}
-			break;
-		// Enter / Right
-		case 0x00004000:
-			MenuListProcessData();
-			return;
-	}
-	// Check maximum length
-	if(sMenuPro.keyinCounter >= sMenuPro.pCurrentMenu->uMenuAttribute.keyinMaxLength)
+	if(!sMenuPro.isViewportShown)
 	{
+		sLcd.WriteString(line, 0, data, LCD_ALIGN_LEFT);
+		memcpy(pShown, data, LCD_MAX_DISPLAY_LENGTH);
 		return;
 	}
-	sMenuPro.pCurrentMenu->title[sMenuPro.keyinCounter] = userKeyin;
-	if(userKeyin != 0)
+	for(i = 0; i < LCD_MAX_DISPLAY_LENGTH; i++)
 	{
-		if(!sMenuPro.pCurrentMenu->uMenuAttribute.isHidden)
+		if(pShown[i] == data[i])
+		{
+			isAddressed = false;
+			continue;
+		}
+		// Address counter move right after write, set address once per run
+		if(isAddressed)
 		{
-			sLcd.WriteCharacter(userKeyin);
+			sLcd.WriteCharacter(data[i]);
 		}
 		else
 		{
-			sLcd.WriteCharacter(HIDDEN_SYMBOL);
+			sLcd.WriteCharacterTo(line, i, data[i]);
+			isAddressed = true;
 		}
-		sMenuPro.keyinCounter++;
+		pShown[i] = data[i];
 	}
 }
 
 /*******************************************************************************
- * @fn      MenuListAlphabetButton
- * @brief   Menu list alphabet button
- * @paramz  pressedButton
+ * @fn      MenuListViewportLine
+ * @brief   Compose one line of title list and write it
+ * @paramz  line
+ * 			title		NULL for empty line
+ * 			isSelected	Show marker
+ * 			isScrolled	Show scrollbar at last column
  * @return  None
  ******************************************************************************/
-static void MenuListAlphabetButton(uint32_t pressedButton)
+static void MenuListViewportLine(uint8_t line, const char *title, bool isSelected, bool isScrolled)
 {
-	char userKeyin = 0;
+	char data[LCD_MAX_DISPLAY_LENGTH + 1];
 
-	if(sMenuPro.previousPressedButton == pressedButton)
+	memset(data, ' ', LCD_MAX_DISPLAY_LENGTH);
+	data[LCD_MAX_DISPLAY_LENGTH] = 0;
+	if(title != NULL)
 	{
-		sMenuPro.alphabetRepeatCounter++;
+		data[0] = isSelected ? INDICATE_CURRENT_MENU_SYMBOL : ' ';
+		memcpy(&data[1], title, strnlen(title, MENU_VIEWPORT_TITLE_LENGTH));
 	}
-	else
+	if(isScrolled)
 	{
-		sMenuPro.alphabetRepeatCounter = 0;
+		data[LCD_MAX_DISPLAY_LENGTH - 1] = MENU_SCROLLBAR_CHARACTER + line;
 	}
+	MenuListViewportWrite(line, data);
+}
+
+/*******************************************************************************
+ * @fn      MenuListScrollbar
+ * @brief   Draw scrollbar thumb into its CGRAM characters, character on
+ * 			screen follow without rewrite
+ * @paramz  index		Sibling index of first shown menu
+ * 			count		Sibling count
+ * @return  None
+ ******************************************************************************/
+static void MenuListScrollbar(uint16_t index, uint16_t count)
+{
+	uint8_t pattern[LCD_MAX_LINE][8];
+	uint8_t height = (8 * LCD_MAX_LINE * LCD_MAX_LINE) / count;
+	uint8_t offset;
+	uint8_t row = 0;
 
-	switch(pressedButton)
+	height = (height < 2) ? 2 : height;
+	offset = ((uint32_t)(8 * LCD_MAX_LINE - height) * index) / (count - LCD_MAX_LINE);
+	for(row = 0; row < 8 * LCD_MAX_LINE; row++)
 	{
-		// 1
-		case 0x00000001:
-			sMenuPro.alphabetRepeatCounter %= 18;
-			if(sMenuPro.alphabetRepeatCounter < 1)
-			{
-				userKeyin = '1';
-			}
-			else if(sMenuPro.alphabetRepeatCounter < 8)
-			{
-				userKeyin = '9' + sMenuPro.alphabetRepeatCounter;
-			}
-			else if(sMenuPro.alphabetRepeatCounter < 14)
-			{
-				userKeyin = 'S' + sMenuPro.alphabetRepeatCounter;
-			}
-			else if(sMenuPro.alphabetRepeatCounter < 18)
-			{
-				userKeyin = 'm' + sMenuPro.alphabetRepeatCounter;
-			}
-			break;
-		// 2(abcABC2)
-		case 0x00000002:
-			sMenuPro.alphabetRepeatCounter %= 7;
-			if(sMenuPro.alphabetRepeatCounter < 3)
-			{
-				userKeyin = 'a' + sMenuPro.alphabetRepeatCounter;
-			}
-			else if(sMenuPro.alphabetRepeatCounter < 6)
-			{
-				userKeyin = '>' + sMenuPro.alphabetRepeatCounter;
-			}
-			else
-			{
-				userKeyin = '2';
-			}
-			break;
-		// 3(defDEF3)
-		case 0x00000004:
-			sMenuPro.alphabetRepeatCounter %= 7;
-			if(sMenuPro.alphabetRepeatCounter < 3)
-			{
-				userKeyin = 'd' + sMenuPro.alphabetRepeatCounter;
-			}
-			else if(sMenuPro.alphabetRepeatCounter < 6)
-			{
-				userKeyin = 'A' + sMenuPro.alphabetRepeatCounter;
-			}
-			else
-			{
-				userKeyin = '3';
-			}
-			break;
-		// 4(ghiGHI4)
-		case 0x00000010:
-			sMenuPro.alphabetRepeatCounter %= 7;
-			if(sMenuPro.alphabetRepeatCounter < 3)
-			{
-				userKeyin = 'g' + sMenuPro.alphabetRepeatCounter;
-			}
-			else if(sMenuPro.alphabetRepeatCounter < 6)
-			{
-				userKeyin = 'D' + sMenuPro.alphabetRepeatCounter;
-			}
-			else
-			{
-				userKeyin = '4';
-			}
-			break;
-		// 5(jklJKL5)
-		case 0x00000020:
-			sMenuPro.alphabetRepeatCounter %= 7;
-			if(sMenuPro.alphabetRepeatCounter < 3)
-			{
-				userKeyin = 'j' + sMenuPro.alphabetRepeatCounter;
-			}
-			else if(sMenuPro.alphabetRepeatCounter < 6)
-			{
-				userKeyin = 'G' + sMenuPro.alphabetRepeatCounter;
-			}
-			else
-			{
-				userKeyin = '5';
-			}
-			break;
-		// 6(mnoMNO6)
-		case 0x00000040:
-			sMenuPro.alphabetRepeatCounter %= 7;
-			if(sMenuPro.alphabetRepeatCounter < 3)
-			{
-				userKeyin = 'm' + sMenuPro.alphabetRepeatCounter;
-			}
-			else if(sMenuPro.alphabetRepeatCounter < 6)
-			{
-				userKeyin = 'J' + sMenuPro.alphabetRepeatCounter;
-			}
-			else
-			{
-				userKeyin = '6';
-			}
-			break;
-		// 7(pqrsPQRS7)
-		case 0x00000100:
-			sMenuPro.alphabetRepeatCounter %= 9;
-			if(sMenuPro.alphabetRepeatCounter < 4)
-			{
-				userKeyin = 'p' + sMenuPro.alphabetRepeatCounter;
-			}
-			else if(sMenuPro.alphabetRepeatCounter < 8)
-			{
-				userKeyin = 'L' + sMenuPro.alphabetRepeatCounter;
-			}
-			else
-			{
-				userKeyin = '7';
-			}
-			break;
-		// 8(tuvTUV8)
-		case 0x00000200:
-			sMenuPro.alphabetRepeatCounter %= 7;
-			if(sMenuPro.alphabetRepeatCounter < 3)
-			{
-				userKeyin = 't' + sMenuPro.alphabetRepeatCounter;
-			}
-			else if(sMenuPro.alphabetRepeatCounter < 6)
-			{
-				userKeyin = 'Q' + sMenuPro.alphabetRepeatCounter;
-			}
-			else
-			{
-				userKeyin = '8';
-			}
-			break;
-		// 9(wxyzWXYZ9)
-		case 0x00000400:
-			sMenuPro.alphabetRepeatCounter %= 9;
-			if(sMenuPro.alphabetRepeatCounter < 4)
-			{
-				userKeyin = 'w' + sMenuPro.alphabetRepeatCounter;
-			}
-			else if(sMenuPro.alphabetRepeatCounter < 8)
-			{
-				userKeyin = 'S' + sMenuPro.alphabetRepeatCounter;
-			}
-			else
-			{
-				userKeyin = '9';
-			}
-			break;
-		// 0
-		case 0x00002000:
-			sMenuPro.alphabetRepeatCounter %= 17;
-			if(sMenuPro.alphabetRepeatCounter < 1)
-			{
-				userKeyin = '0';
-			}
-			else if(sMenuPro.alphabetRepeatCounter < 17)
-			{
-				userKeyin = 31 + sMenuPro.alphabetRepeatCounter;
-			}
-			break;
-		// Exit / Left
-		case 0x00001000:
-			pressedButton = 0;
-			if(sMenuPro.keyinCounter > 0)
-			{
-				if(sMenuPro.previousPressedButton == 0)
-				{
-					sLcd.ShiftCursorDisplay(SHIFT_CURSOR_LEFT);
-				}
-				sLcd.WriteCharacter(' ');
-				sLcd.ShiftCursorDisplay(SHIFT_CURSOR_LEFT);
-				sMenuPro.keyinCounter--;
-			}
-			else
-			{
-				sLcd.SetAttribute(1, CURSOR_OFF_TYPE);
-				sMenuPro.pCurrentMenu = sMenuPro.pCurrentMenu->pParent;
-				sMenuPro.pCurrentMenu->menuAction();
-				return;
-			}
-			break;
-		// Enter / Right
-		case 0x00004000:
-			MenuListProcessData();
-			sSoftwareTimer.Stop(sMenuPro.AlphabetButtonTimerId);
-			return;
+		pattern[row / 8][row % 8] = (row >= offset && row < offset + height) ? MENU_SCROLLBAR_THUMB : 0;
 	}
-	// Check maximum length
-	if(sMenuPro.keyinCounter >= sMenuPro.pCurrentMenu->uMenuAttribute.keyinMaxLength)
+	for(row = 0; row < LCD_MAX_LINE; row++)
 	{
-		sSoftwareTimer.Stop(sMenuPro.AlphabetButtonTimerId);
-		return;
+		if(memcmp(sMenuPro.scrollbar[row], pattern[row], 8) != 0)
+		{
+			sLcd.SetCharacter(MENU_SCROLLBAR_CHARACTER + row, pattern[row]);
+			memcpy(sMenuPro.scrollbar[row], pattern[row], 8);
+		}
 	}
-	if(sMenuPro.previousPressedButton == pressedButton && userKeyin != 0)
+}
+
+/*******************************************************************************
+ * COROUTINE FUNCTIONS
+ ******************************************************************************/
+static eCOROUTINE_STATE DateTimeCoroutine(sCOROUTINE_CONTEXT *psContext);
+
+/*******************************************************************************
+ * @fn      DateTimeCoroutine
+ * @brief   Show date and time, one line per step
+ * @paramz  psContext
+ * @return  Coroutine state
+ ******************************************************************************/
+static eCOROUTINE_STATE DateTimeCoroutine(sCOROUTINE_CONTEXT *psContext)
+{
+	static char dateTime[17];
+	static RTC_DateTypeDef sDate;
+	static RTC_TimeTypeDef sTime;
+	static const char weekDay[][5] = {"    ", "MON ", "TUE ", "WED ", "THU ", "FRI ", "SAT ", "SUN "};
+
+	COROUTINE_BEGIN(psContext);
+	if(!MenuListIsDateTimeShown())
 	{
-		sMenuPro.keyinCounter--;
+		COROUTINE_EXIT(psContext);
 	}
-	if(sMenuPro.previousPressedButton != pressedButton &&
-			sMenuPro.previousPressedButton != 0 &&
-			userKeyin != 0 &&
-			sMenuPro.keyinCounter > 0)
+	RtcGetDateTime(&sDate, &sTime);
+	sprintf(dateTime, "20%02d-%02d-%02d", sDate.Year, sDate.Month, sDate.Date);
+	sLcd.WriteString(0, 0, dateTime, LCD_ALIGN_CENTER);
+
+	COROUTINE_YIELD(psContext);
+	// Key event may leave the date time screen between two lines
+	if(!MenuListIsDateTimeShown())
+	{
+		COROUTINE_EXIT(psContext);
+	}
+	sprintf(dateTime, "%s%02d:%02d:%02d", weekDay[(sDate.WeekDay <= RTC_WEEKDAY_SUNDAY) ? sDate.WeekDay : 0], sTime.Hours, sTime.Minutes, sTime.Seconds);
+	sLcd.WriteString(1, 0, dateTime, LCD_ALIGN_CENTER);
+	COROUTINE_END(psContext);
+}
+
+/*******************************************************************************
+ * COMMIT FUNCTIONS
+ ******************************************************************************/
+static bool DateTimeCommit(const char *value);
+static bool PasswordCommit(const char *value);
+
+/*******************************************************************************
+ * @fn      DateTimeCommit
+ * @brief   Set RTC from edited date and time, week day is worked out
+ * @paramz  value
+ * @return  True
+ ******************************************************************************/
+static bool DateTimeCommit(const char *value)
+{
+	static const uint8_t monthOffset[] = {0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4};
+	RTC_DateTypeDef sDate = {0};
+	RTC_TimeTypeDef sTime = {0};
+	uint32_t year;
+	uint8_t weekDay;
+
+	// 20YY-MM-DD
+	sDate.Year = strtoul(&sMenuPro.value[VALUE_DATE][2], NULL, 10);
+	sDate.Month = strtoul(&sMenuPro.value[VALUE_DATE][5], NULL, 10);
+	sDate.Date = strtoul(&sMenuPro.value[VALUE_DATE][8], NULL, 10);
+	// HH:MM:SS
+	sTime.Hours = strtoul(&value[0], NULL, 10);
+	sTime.Minutes = strtoul(&value[3], NULL, 10);
+	sTime.Seconds = strtoul(&value[6], NULL, 10);
+	// Sakamoto, 0 is Sunday
+	year = 2000 + sDate.Year - ((sDate.Month < 3) ? 1 : 0);
+	weekDay = (year + (year / 4) - (year / 100) + (year / 400) + monthOffset[sDate.Month - 1] + sDate.Date) % 7;
+	sDate.WeekDay = (weekDay == 0) ? RTC_WEEKDAY_SUNDAY : weekDay;
+	RtcSetDateTime(&sDate, &sTime);
+	return true;
+}
+
+/*******************************************************************************
+ * @fn      PasswordCommit
+ * @brief   Save confirmed new password
+ * @paramz  value
+ * @return  True
+ ******************************************************************************/
+static bool PasswordCommit(const char *value)
+{
+	sprintf(sMenuPro.password, "%s", value);
+	sFlashStore.Write(STORE_PASSWORD, sMenuPro.password, strlen(sMenuPro.password));
+	return true;
+}
+
+/*******************************************************************************
+ * PROVIDER FUNCTIONS
+ ******************************************************************************/
+static void ReportValue(char *string, int32_t value);
+static void ReportDetail(eREPORT_PERIOD eReportPeriod, uint16_t index, char *string);
+static uint16_t DailyReportCount(void);
+static void DailyReportTitle(uint16_t index, char *title);
+static void DailyReportOpen(uint16_t index, uint8_t line, char *string);
+static uint16_t WeeklyReportCount(void);
+static void WeeklyReportTitle(uint16_t index, char *title);
+static void WeeklyReportOpen(uint16_t index, uint8_t line, char *string);
+static uint16_t MonthlyReportCount(void);
+static void MonthlyReportTitle(uint16_t index, char *title);
+static void MonthlyReportOpen(uint16_t index, uint8_t line, char *string);
+
+/*******************************************************************************
+ * @fn      ReportValue
+ * @brief   Format tenth of degree as degree with one decimal
+ * @paramz  string
+ * 			value
+ * @return  None
+ ******************************************************************************/
+static void ReportValue(char *string, int32_t value)
+{
+	sprintf(string, "%s%ld.%ld", (value < 0) ? "-" : "", labs(value) / 10, labs(value) % 10);
+}
+
+/*******************************************************************************
+ * @fn      ReportDetail
+ * @brief   Mean and minimum / maximum of a report, read from report table
+ * @paramz  eReportPeriod
+ * 			index		0 is current period
+ * 			string
+ * @return  None
+ ******************************************************************************/
+static void ReportDetail(eREPORT_PERIOD eReportPeriod, uint16_t index, char *string)
+{
+	sREPORT_AGGREGATE sReportAggregate;
+	char mean[8];
+	char minimum[8];
+	char maximum[8];
+	time_t unixTime;
+	int32_t half;
+
+	RTCGetUnixTime(&unixTime);
+	if(!sReport.Get(eReportPeriod, unixTime, index, &sReportAggregate))
 	{
-		sLcd.ShiftCursorDisplay(SHIFT_CURSOR_RIGHT);
+		snprintf(string, TITLE_MAX_LENGTH, "No Record");
+		return;
 	}
-	sMenuPro.pCurrentMenu->title[sMenuPro.keyinCounter] = userKeyin;
-	sMenuPro.previousPressedButton = pressedButton;
+	// Round half away from zero
+	half = (sReportAggregate.sum < 0) ? -(int32_t)(sReportAggregate.count / 2) : (int32_t)(sReportAggregate.count / 2);
+	ReportValue(mean, (sReportAggregate.sum + half) / (int32_t)sReportAggregate.count);
+	ReportValue(minimum, sReportAggregate.minimum);
+	ReportValue(maximum, sReportAggregate.maximum);
+	snprintf(string, TITLE_MAX_LENGTH, "%s %s/%s", mean, minimum, maximum);
+}
+
+/*******************************************************************************
+ * @fn      DailyReportCount
+ * @brief   Number of daily report
+ * @paramz  None
+ * @return  Count
+ ******************************************************************************/
+static uint16_t DailyReportCount(void)
+{
+	return MENU_DAILY_REPORT_COUNT;
+}
+
+/*******************************************************************************
+ * @fn      DailyReportTitle
+ * @brief   Date of daily report, index 0 is today
+ * @paramz  index
+ * 			title
+ * @return  None
+ ******************************************************************************/
+static void DailyReportTitle(uint16_t index, char *title)
+{
+	time_t unixTime;
 
-	if(userKeyin != 0)
+	RTCGetUnixTime(&unixTime);
+	unixTime -= (time_t)index * MENU_SECOND_PER_DAY;
+	strftime(title, TITLE_MAX_LENGTH, "%Y-%m-%d %a", localtime(&unixTime));
+}
+
+/*******************************************************************************
+ * @fn      DailyReportOpen
+ * @brief   Daily report detail
+ * @paramz  index
+ * 			line
+ * 			string
+ * @return  None
+ ******************************************************************************/
+static void DailyReportOpen(uint16_t index, uint8_t line, char *string)
+{
+	if(line == 0)
 	{
-		sSoftwareTimer.Start(sMenuPro.AlphabetButtonTimerId, ALPHABET_BUTTON_DELAY);
-		sLcd.WriteCharacter(userKeyin);
-		sLcd.ShiftCursorDisplay(SHIFT_CURSOR_LEFT);
-		sMenuPro.keyinCounter++;
+		DailyReportTitle(index, string);
 	}
 	else
 	{
-		sSoftwareTimer.Stop(sMenuPro.AlphabetButtonTimerId);
+		ReportDetail(REPORT_DAILY, index, string);
 	}
 }
 
 /*******************************************************************************
- * @fn      MenuListOptionButton
- * @brief   Menu list option button
- * @paramz  pressedButton
+ * @fn      WeeklyReportCount
+ * @brief   Number of weekly report
+ * @paramz  None
+ * @return  Count
+ ******************************************************************************/
+static uint16_t WeeklyReportCount(void)
+{
+	return MENU_WEEKLY_REPORT_COUNT;
+}
+
+/*******************************************************************************
+ * @fn      WeeklyReportTitle
+ * @brief   ISO week of weekly report, index 0 is this week
+ * @paramz  index
+ * 			title
  * @return  None
  ******************************************************************************/
-static void MenuListOptionButton(uint32_t pressedButton)
+static void WeeklyReportTitle(uint16_t index, char *title)
 {
-	switch(pressedButton)
-	{
-		// Up
-		case 0x00000200:
-			if(sMenuPro.pOptionMenu->pPrevious != NULL)
-			{
-				sMenuPro.pOptionMenu = sMenuPro.pOptionMenu->pPrevious;
-				sLcd.WriteString(1, 1, sMenuPro.pOptionMenu->title, LCD_ALIGN_LEFT);
-			}
-			break;
-		// Down
-		case 0x00002000:
-			if(sMenuPro.pOptionMenu->pNext != NULL)
-			{
-				sMenuPro.pOptionMenu = sMenuPro.pOptionMenu->pNext;
-				sLcd.WriteString(1, 1, sMenuPro.pOptionMenu->title, LCD_ALIGN_LEFT);
-			}
-			break;
-		// Exit / Left
-		case 0x00001000:
-			if(sMenuPro.pCurrentMenu->pParent != NULL)
-			{
-				sMenuPro.pCurrentMenu = sMenuPro.pCurrentMenu->pParent;
-				sMenuPro.pCurrentMenu->menuAction();
-			}
-			break;
-		// Enter / Right
-		case 0x00004000:
-			sprintf(sMenuPro.pCurrentMenu->title, "%s", sMenuPro.pOptionMenu->title);
-			MenuListProcessData();
-			break;
-		default:
-			break;
-	}
+	time_t unixTime;
+
+	RTCGetUnixTime(&unixTime);
+	unixTime -= (time_t)index * 7 * MENU_SECOND_PER_DAY;
+	strftime(title, TITLE_MAX_LENGTH, "%G Week %V", localtime(&unixTime));
 }
 
 /*******************************************************************************
- * @fn      MenuListInfoButton
- * @brief   Menu list info button
- * @paramz  pressedButton
+ * @fn      WeeklyReportOpen
+ * @brief   Weekly report detail
+ * @paramz  index
+ * 			line
+ * 			string
  * @return  None
  ******************************************************************************/
-static void MenuListInfoButton(uint32_t pressedButton)
+static void WeeklyReportOpen(uint16_t index, uint8_t line, char *string)
 {
-	// Exit / Left
-	if(pressedButton == 0x00001000)
+	if(line == 0)
+	{
+		WeeklyReportTitle(index, string);
+	}
+	else
 	{
-		sMenuPro.pCurrentMenu = sMenuPro.pCurrentMenu->pParent;
-		sMenuPro.pCurrentMenu->menuAction();
+		ReportDetail(REPORT_WEEKLY, index, string);
 	}
 }
 
 /*******************************************************************************
- * CALLBACK FUNCTIONS
+ * @fn      MonthlyReportCount
+ * @brief   Number of monthly report, no month before year 2000
+ * @paramz  None
+ * @return  Count
+ ******************************************************************************/
+static uint16_t MonthlyReportCount(void)
+{
+	RTC_DateTypeDef sDate;
+	RTC_TimeTypeDef sTime;
+	uint16_t month;
+
+	RtcGetDateTime(&sDate, &sTime);
+	month = sDate.Year * 12 + sDate.Month;
+
+	return (month < MENU_MONTHLY_REPORT_COUNT) ? month : MENU_MONTHLY_REPORT_COUNT;
+}
+
+/*******************************************************************************
+ * @fn      MonthlyReportTitle
+ * @brief   Month of monthly report, index 0 is this month
+ * @paramz  index
+ * 			title
+ * @return  None
  ******************************************************************************/
-static void AlphabetButtonCallback(uint8_t softwareTimerId);
+static void MonthlyReportTitle(uint16_t index, char *title)
+{
+	RTC_DateTypeDef sDate;
+	RTC_TimeTypeDef sTime;
+	uint16_t month;
+
+	RtcGetDateTime(&sDate, &sTime);
+	month = sDate.Year * 12 + sDate.Month - 1 - index;
+	snprintf(title, TITLE_MAX_LENGTH, "%04d-%02d", 2000 + month / 12, month % 12 + 1);
+}
 
 /*******************************************************************************
- * @fn      AlphabetButtonCallback
- * @brief   Alphabet button callback
- * @paramz  softwareTimerId
+ * @fn      MonthlyReportOpen
+ * @brief   Monthly report detail
+ * @paramz  index
+ * 			line
+ * 			string
  * @return  None
  ******************************************************************************/
-static void AlphabetButtonCallback(uint8_t softwareTimerId)
+static void MonthlyReportOpen(uint16_t index, uint8_t line, char *string)
 {
-	sMenuPro.alphabetRepeatCounter = 0;
-	sMenuPro.previousPressedButton = 0;
-	sLcd.ShiftCursorDisplay(SHIFT_CURSOR_RIGHT);
+	if(line == 0)
+	{
+		MonthlyReportTitle(index, string);
+	}
+	else
+	{
+		ReportDetail(REPORT_MONTHLY, index, string);
+	}
 }
 
 /*******************************************************************************
  * ACTION FUNCTIONS
  ******************************************************************************/
-static void PasswordAction(void);
-static void DateTimeAction(void);
+static void EditorAction(void);
 static void TitleAction(void);
-static void KeyinAction(void);
-static void OptionAction(void);
 static void InfoAction(void);
+static void DiagnosticAction(void);
+static void VirtualAction(void);
+static void TemperatureAction(void);
 
 /*******************************************************************************
- * @fn      PasswordAction
- * @brief   Key in password
+ * @fn      EditorAction
+ * @brief   Show field prompt and open field editor on second line
  * @paramz  None
  * @return  None
  ******************************************************************************/
-static void PasswordAction(void)
+static void EditorAction(void)
 {
-	if(sMenuPro.pCurrentMenu->index == sMenuPro.passwordIndex)
-	{
-		sLcd.WriteString(0, 0, "Key in password", LCD_ALIGN_LEFT);
-	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.oldPasswordIndex)
-	{
-		sLcd.WriteString(0, 0, "Old Password", LCD_ALIGN_LEFT);
-	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.newPasswordIndex)
+	const sMENU_FIELD *psMenuField = &menuField[sMenuPro.pCurrentMenu->eMenuValue];
+	char *value = sMenuPro.value[sMenuPro.pCurrentMenu->eMenuValue];
+	const struct sMENU *psMenu;
+	RTC_DateTypeDef sDate;
+	RTC_TimeTypeDef sTime;
+
+	if(psMenuField->prompt != NULL)
 	{
-		sLcd.WriteString(0, 0, "New Password", LCD_ALIGN_LEFT);
+		sLcd.WriteString(0, 0, psMenuField->prompt, LCD_ALIGN_LEFT);
 	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.confirmPasswordIndex)
+	memset(&sMenuPro.sField, 0, sizeof(sMenuPro.sField));
+	sMenuPro.sField.eFieldType = psMenuField->eFieldType;
+	sMenuPro.sField.isHidden = sMenuPro.pCurrentMenu->uMenuAttribute.isHidden;
+	sMenuPro.sField.step = 1;
+	switch(psMenuField->eFieldType)
 	{
-		sLcd.WriteString(0, 0, "Confirm Password", LCD_ALIGN_LEFT);
+		case FIELD_INTEGER:
+		case FIELD_FIXED_POINT:
+			sMenuPro.sField.minimum = psMenuField->minimum;
+			sMenuPro.sField.maximum = psMenuField->maximum;
+			sMenuPro.sField.step = psMenuField->step;
+			break;
+		case FIELD_STRING:
+			sMenuPro.sField.maximum = sMenuPro.pCurrentMenu->uMenuAttribute.keyinMaxLength;
+			break;
+		case FIELD_TEXT:
+			sMenuPro.sField.maximum = sMenuPro.pCurrentMenu->uMenuAttribute.keyinMaxLength;
+			sMenuPro.sField.eCharacterSet = CHARACTER_SET_ALPHANUMERIC;
+			break;
+		case FIELD_ENUM:
+			for(psMenu = MENU_LINK(sMenuPro.pCurrentMenu->child); psMenu != NULL; psMenu = MENU_LINK(psMenu->next))
+			{
+				sMenuPro.sField.maximum++;
+			}
+			sMenuPro.sField.GetEnumText = MenuListOptionText;
+			break;
+		case FIELD_DATE:
+		case FIELD_TIME:
+			// Start from RTC
+			RtcGetDateTime(&sDate, &sTime);
+			if(psMenuField->eFieldType == FIELD_DATE)
+			{
+				snprintf(value, TITLE_MAX_LENGTH, "20%02d-%02d-%02d", sDate.Year, sDate.Month, sDate.Date);
+			}
+			else
+			{
+				snprintf(value, TITLE_MAX_LENGTH, "%02d:%02d:%02d", sTime.Hours, sTime.Minutes, sTime.Seconds);
+			}
+			break;
+		default:
+			break;
 	}
-	MenuListPrepareKeyin();
+	sFieldEditor.Open(&sMenuPro.sField, 1, (psMenuField->eFieldType == FIELD_ENUM) ? 1 : 0, value);
 }
 
 /*******************************************************************************
- * @fn      DateTimeAction
- * @brief   Key in new date and time
+ * @fn      TitleAction
+ * @brief   Show window of current menu and its siblings, window stay while
+ * 			current menu is in it so Up / Down only move the marker, else it
+ * 			scroll one line and the old line is reused
  * @paramz  None
  * @return  None
  ******************************************************************************/
-static void DateTimeAction(void)
+static void TitleAction(void)
 {
-	if(sMenuPro.pCurrentMenu->index == sMenuPro.yearIndex)
-	{
-		sLcd.WriteString(0, 0, "Year(0-99)", LCD_ALIGN_LEFT);
-	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.monthIndex)
-	{
-		sLcd.WriteString(0, 0, "Month(1-12)", LCD_ALIGN_LEFT);
-	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.dateIndex)
-	{
-		sLcd.WriteString(0, 0, "Date(1-31)", LCD_ALIGN_LEFT);
-	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.hourIndex)
+	const struct sMENU *psMenu = sMenuPro.pCurrentMenu;
+	const struct sMENU *psTop = MENU_LINK(sMenuPro.viewportTop);
+	const struct sMENU *psLine;
+	uint16_t child = sMenuPro.pathStart[psMenu->parent];
+	uint16_t count = 0;
+	uint16_t index = 0;
+	uint8_t line = 0;
+
+	if(psTop == NULL || psTop->parent != psMenu->parent || (psTop != psMenu && MENU_LINK(psTop->next) != psMenu))
 	{
-		sLcd.WriteString(0, 0, "Hour(0-23)", LCD_ALIGN_LEFT);
+		if(psTop != NULL && psTop->parent == psMenu->parent && MENU_LINK(psMenu->next) == psTop)
+		{
+			// Up one line
+			psTop = psMenu;
+		}
+		else if(psMenu->previous != MENU_NONE &&
+				((psTop != NULL && psTop->parent == psMenu->parent && MENU_LINK(psMenu->previous) == MENU_LINK(psTop->next)) || psMenu->next == MENU_NONE))
+		{
+			// Down one line, or last menu keep window full
+			psTop = MENU_LINK(psMenu->previous);
+		}
+		else
+		{
+			psTop = psMenu;
+		}
+		sMenuPro.viewportTop = MENU_INDEX(psTop);
 	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.minuteIndex)
+	// Position of window in shown siblings, hidden menu is not counted
+	for(; child < sMenuPro.pathStart[psMenu->parent + 1]; child++)
 	{
-		sLcd.WriteString(0, 0, "Minute(0-59)", LCD_ALIGN_LEFT);
+		if(sMenuPro.pathChild[child] == sMenuPro.viewportTop)
+		{
+			index = count;
+		}
+		count += menuTree[sMenuPro.pathChild[child]].uMenuAttribute.isHidden ? 0 : 1;
 	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.secondIndex)
+	if(count > LCD_MAX_LINE)
 	{
-		sLcd.WriteString(0, 0, "Second(0-59)", LCD_ALIGN_LEFT);
+		MenuListScrollbar(index, count);
 	}
-	else if(sMenuPro.pCurrentMenu->index == sMenuPro.weekDayIndex)
+	for(line = 0, psLine = psTop; line < LCD_MAX_LINE; line++)
 	{
-		sLcd.WriteString(0, 0, "Week Day", LCD_ALIGN_LEFT);
-		OptionAction();
-		return;
+		MenuListViewportLine(line, (psLine != NULL) ? MENU_TITLE(psLine) : NULL, psLine == psMenu, count > LCD_MAX_LINE);
+		psLine = (psLine != NULL) ? MENU_LINK(psLine->next) : NULL;
 	}
-	MenuListPrepareKeyin();
+	sMenuPro.isViewportShown = true;
 }
 
 /*******************************************************************************
- * @fn      TitleAction
- * @brief   Show current menu to LCD
+ * @fn      InfoAction
+ * @brief   Show read only value
  * @paramz  None
  * @return  None
  ******************************************************************************/
-static void TitleAction(void)
+static void InfoAction(void)
 {
-	char string[LCD_MAX_LENGTH + 1];
+	sLcd.WriteString(1, 1, MENU_TITLE(sMenuPro.pCurrentMenu), LCD_ALIGN_LEFT);
+}
 
-	sprintf(string, "%c%s", INDICATE_CURRENT_MENU_SYMBOL, sMenuPro.pCurrentMenu->title);
-	sLcd.WriteString(0, 0, string, LCD_ALIGN_LEFT);
-	if(sMenuPro.pCurrentMenu->pNext != NULL)
+/*******************************************************************************
+ * @fn      DiagnosticAction
+ * @brief   Show average / 99th percentile / maximum of selected metric (us),
+ * 			or last / maximum wake up to dispatch latency (us) and time (s) of
+ * 			selected power mode
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void DiagnosticAction(void)
+{
+	char string[TITLE_MAX_LENGTH];
+	uint32_t cyclePerMicrosecond = SystemCoreClock / 1000000;
+	ePOWER_MODE ePowerMode = diagnosticPage[sMenuPro.diagnosticPage].ePowerMode;
+	sDIAGNOSTIC_STATISTIC sDiagnosticStatistic;
+	sPOWER_STATISTIC sPowerStatistic;
+
+	sLcd.WriteString(0, 0, "                ", LCD_ALIGN_LEFT);
+	sLcd.WriteString(0, 0, diagnosticPage[sMenuPro.diagnosticPage].title, LCD_ALIGN_LEFT);
+	if(ePowerMode == POWER_RUN_MODE)
+	{
+		sPowerManager.GetStatistic(&sPowerStatistic);
+		snprintf(string, sizeof(string), "%lus %luuA",
+				(uint32_t)(sPowerStatistic.modeTime[ePowerMode] / 1000000),
+				sPowerStatistic.averageCurrent);
+	}
+	else if(ePowerMode != maximumPowerMode)
 	{
-		sLcd.WriteString(1, 1, sMenuPro.pCurrentMenu->pNext->title, LCD_ALIGN_LEFT);
+		sPowerManager.GetStatistic(&sPowerStatistic);
+		snprintf(string, sizeof(string), "%lu/%lu %lus",
+				sPowerStatistic.lastWakeLatency[ePowerMode] / cyclePerMicrosecond,
+				sPowerStatistic.maximumWakeLatency[ePowerMode] / cyclePerMicrosecond,
+				(uint32_t)(sPowerStatistic.modeTime[ePowerMode] / 1000000));
 	}
 	else
 	{
-		sLcd.WriteString(1, 0, "                ", LCD_ALIGN_LEFT);
+		sDiagnostic.GetStatistic(diagnosticPage[sMenuPro.diagnosticPage].eEventFlag, diagnosticPage[sMenuPro.diagnosticPage].eDiagnosticMetric, &sDiagnosticStatistic);
+		snprintf(string, sizeof(string), "%lu/%lu/%lu",
+				sDiagnosticStatistic.average / cyclePerMicrosecond,
+				sDiagnosticStatistic.percentile99 / cyclePerMicrosecond,
+				sDiagnosticStatistic.maximum / cyclePerMicrosecond);
 	}
+	sLcd.WriteString(1, 0, "                ", LCD_ALIGN_LEFT);
+	sLcd.WriteString(1, 0, string, LCD_ALIGN_LEFT);
 }
 
 /*******************************************************************************
- * @fn      KeyinAction
- * @brief   Show user previous key in value
+ * @fn      TemperatureAction
+ * @brief   Show filtered on-chip temperature
  * @paramz  None
  * @return  None
  ******************************************************************************/
-static void KeyinAction(void)
+static void TemperatureAction(void)
 {
-	uint8_t i = 0;
+	int16_t value = sTemperatureSensor.Get();
+	char string[TITLE_MAX_LENGTH];
 
-	// Clear second line
-	MenuListPrepareKeyin();
-	// Show user previous key in value
-	for(i = 0; i < strlen(sMenuPro.pCurrentMenu->title); i++)
+	sLcd.WriteString(0, 0, "Temperature", LCD_ALIGN_LEFT);
+	if(value == TEMPERATURE_SENSOR_NO_VALUE)
 	{
-		if(!sMenuPro.pCurrentMenu->uMenuAttribute.isHidden)
-		{
-			sLcd.WriteCharacter(sMenuPro.pCurrentMenu->title[i]);
-		}
-		else
-		{
-			sLcd.WriteCharacter(HIDDEN_SYMBOL);
-		}
-		sMenuPro.keyinCounter++;
+		sLcd.WriteString(1, 1, "Measuring", LCD_ALIGN_LEFT);
+		return;
 	}
+	ReportValue(string, value);
+	sLcd.WriteString(1, 1, string, LCD_ALIGN_LEFT);
+	sLcd.WriteCharacterTo(1, 1 + strlen(string), CELSIUS_DEGREE_LOGO);
 }
 
 /*******************************************************************************
- * @fn      OptionAction
- * @brief   Show option list value
+ * @fn      VirtualAction
+ * @brief   Show window of provider entries, only shown entries are made,
+ * 			or opened entry
  * @paramz  None
  * @return  None
  ******************************************************************************/
-static void OptionAction(void)
+static void VirtualAction(void)
 {
-	struct sMENU *psMenu;
+	const sMENU_PROVIDER *psMenuProvider = &menuProvider[sMenuPro.pCurrentMenu->eMenuValue];
+	char string[TITLE_MAX_LENGTH];
+	uint16_t count = psMenuProvider->GetCount();
+	uint8_t line = 0;
 
-	if(sMenuPro.pCurrentMenu->title[0] == 0)
+	if(sMenuPro.virtualMenu != MENU_INDEX(sMenuPro.pCurrentMenu))
+	{
+		// Enter list at first entry
+		sMenuPro.virtualMenu = MENU_INDEX(sMenuPro.pCurrentMenu);
+		sMenuPro.virtualIndex = 0;
+		sMenuPro.virtualTop = 0;
+		sMenuPro.isVirtualOpen = false;
+	}
+	if(count == 0)
+	{
+		sMenuPro.isVirtualOpen = false;
+		MenuListViewportLine(0, "No Entry", false, false);
+		MenuListViewportLine(1, NULL, false, false);
+		sMenuPro.isViewportShown = true;
+		return;
+	}
+	// Count may drop while browsing
+	if(sMenuPro.virtualIndex >= count)
+	{
+		sMenuPro.virtualIndex = count - 1;
+	}
+	if(sMenuPro.isVirtualOpen)
+	{
+		sMenuPro.isViewportShown = false;
+		for(line = 0; line < LCD_MAX_LINE; line++)
+		{
+			psMenuProvider->Open(sMenuPro.virtualIndex, line, string);
+			sLcd.WriteString(line, 0, string, LCD_ALIGN_LEFT);
+		}
+		return;
+	}
+	// Window follow selected entry one line at a time
+	if(sMenuPro.virtualIndex < sMenuPro.virtualTop)
+	{
+		sMenuPro.virtualTop = sMenuPro.virtualIndex;
+	}
+	else if(sMenuPro.virtualIndex >= sMenuPro.virtualTop + LCD_MAX_LINE)
+	{
+		sMenuPro.virtualTop = sMenuPro.virtualIndex - LCD_MAX_LINE + 1;
+	}
+	if(count > LCD_MAX_LINE)
 	{
-		sLcd.WriteString(1, 1, sMenuPro.pCurrentMenu->pChild->title, LCD_ALIGN_LEFT);
-		sMenuPro.pOptionMenu = sMenuPro.pCurrentMenu->pChild;
+		if(sMenuPro.virtualTop > count - LCD_MAX_LINE)
+		{
+			sMenuPro.virtualTop = count - LCD_MAX_LINE;
+		}
+		MenuListScrollbar(sMenuPro.virtualTop, count);
 	}
 	else
 	{
-		psMenu = sMenuPro.pCurrentMenu->pChild;
-		for(;;)
+		sMenuPro.virtualTop = 0;
+	}
+	for(line = 0; line < LCD_MAX_LINE; line++)
+	{
+		if(sMenuPro.virtualTop + line < count)
 		{
-			if(strcmp(sMenuPro.pCurrentMenu->title, psMenu->title) == 0)
-			{
-				sLcd.WriteString(1, 1, psMenu->title, LCD_ALIGN_LEFT);
-				sMenuPro.pOptionMenu = psMenu;
-				break;
-			}
-			else
-			{
-				psMenu = psMenu->pNext;
-			}
-			if(psMenu == NULL)
-			{
-				break;
-			}
+			psMenuProvider->GetTitle(sMenuPro.virtualTop + line, string);
+			MenuListViewportLine(line, string, sMenuPro.virtualTop + line == sMenuPro.virtualIndex, count > LCD_MAX_LINE);
+		}
+		else
+		{
+			MenuListViewportLine(line, NULL, false, count > LCD_MAX_LINE);
 		}
 	}
-}
-
-/*******************************************************************************
- * @fn      InfoAction
- * @brief   Show read only value
- * @paramz  None
- * @return  None
- ******************************************************************************/
-static void InfoAction(void)
-{
-	sLcd.WriteString(1, 1, sMenuPro.pCurrentMenu->title, LCD_ALIGN_LEFT);
+	sMenuPro.isViewportShown = true;
 }
 
 /*******************************************************************************
@@ -1109,7 +1530,50 @@ static void InfoAction(void)
  ******************************************************************************/
 static void MenuListInitialize(void);
 static void MenuListButtonPressed(uint32_t pressedButton);
+static void MenuListButtonRepeated(uint32_t pressedButton);
+static void MenuListButtonLongPressed(uint32_t pressedButton);
 static void MenuListUpdateDateTime(void);
+static void MenuListUpdateTemperature(void);
+static uint16_t MenuListGetScreen(void);
+
+// Menu tree expanded from MENU_TREE
+static const struct sMENU menuTree[maximumMenu] =
+{
+#define MENU_NODE(id, parent, child, previous, next, title, action, type, hidden, maxLength, value) \
+	{offsetof(sMENU_TITLE_POOL, id), parent, child, previous, next, {.eMenuType = type, .isHidden = hidden, .keyinMaxLength = maxLength}, action, value},
+	MENU_TREE(MENU_NODE)
+#undef MENU_NODE
+};
+
+// Menu action jump table
+static const MENU_ACTION menuActionTable[maximumMenuAction] =
+{
+	MenuListUpdateDateTime,
+	EditorAction,
+	TitleAction,
+	InfoAction,
+	DiagnosticAction,
+	VirtualAction,
+	TemperatureAction,
+};
+
+// Menu field table expanded from MENU_FIELD, indexed by menu value
+static const sMENU_FIELD menuField[maximumMenuValue] =
+{
+#define MENU_FIELD_ENTRY(value, prompt, type, validator, minimum, maximum, step, commit, nextMenu, storeKey) \
+	{prompt, type, validator, minimum, maximum, step, nextMenu, commit, storeKey},
+	MENU_FIELD(MENU_FIELD_ENTRY)
+#undef MENU_FIELD_ENTRY
+};
+
+// Menu provider table expanded from MENU_PROVIDER
+static const sMENU_PROVIDER menuProvider[maximumMenuProvider] =
+{
+#define MENU_PROVIDER_ENTRY(provider, count, title, open) \
+	{count, title, open},
+	MENU_PROVIDER(MENU_PROVIDER_ENTRY)
+#undef MENU_PROVIDER_ENTRY
+};
 
 /*******************************************************************************
  * @fn      MenuListInitialize
@@ -1119,54 +1583,34 @@ static void MenuListUpdateDateTime(void);
  ******************************************************************************/
 static void MenuListInitialize(void)
 {
-	sMenuPro.dateTimeIndex = MenuListAddMenu(LEVEL1, "", MenuListUpdateDateTime, TITLE, false, 0);
-		sMenuPro.passwordIndex = MenuListAddMenu(LEVEL2, "", PasswordAction, NUMBER, true, 6);
-		sMenuPro.firstMenuIndex = MenuListAddMenu(LEVEL2, "Setting", TitleAction, TITLE, false, 0);
-			MenuListAddMenu(LEVEL3, "User Name", TitleAction, TITLE, false, 0);
-				MenuListAddMenu(LEVEL4, "", KeyinAction, ALPHABET, false, 8);
-			MenuListAddMenu(LEVEL3, "Serial Number", TitleAction, TITLE, false, 0);
-				MenuListAddMenu(LEVEL4, "", KeyinAction, NUMBER, false, 8);
-			MenuListAddMenu(LEVEL3, "Temperature", TitleAction, TITLE, false, 0);
-				MenuListAddMenu(LEVEL4, "", OptionAction, OPTION, false, 0);
-					MenuListAddMenu(LEVEL5, "Low", TitleAction, TITLE, false, 0);
-					MenuListAddMenu(LEVEL5, "Medium", TitleAction, TITLE, false, 0);
-					MenuListAddMenu(LEVEL5, "High", TitleAction, TITLE, false, 0);
-			MenuListAddMenu(LEVEL3, "Backlight", TitleAction, TITLE, false, 0);
-				MenuListAddMenu(LEVEL4, "", OptionAction, OPTION, false, 0);
-					MenuListAddMenu(LEVEL5, "ON", TitleAction, TITLE, false, 0);
-					MenuListAddMenu(LEVEL5, "OFF", TitleAction, TITLE, false, 0);
-			MenuListAddMenu(LEVEL3, "Date Time", TitleAction, TITLE, false, 0);
-				sMenuPro.yearIndex = MenuListAddMenu(LEVEL4, "", DateTimeAction, NUMBER, false, 2);
-				sMenuPro.monthIndex = MenuListAddMenu(LEVEL4, "", DateTimeAction, NUMBER, false, 2);
-				sMenuPro.dateIndex = MenuListAddMenu(LEVEL4, "", DateTimeAction, NUMBER, false, 2);
-				sMenuPro.hourIndex = MenuListAddMenu(LEVEL4, "", DateTimeAction, NUMBER, false, 2);
-				sMenuPro.minuteIndex = MenuListAddMenu(LEVEL4, "", DateTimeAction, NUMBER, false, 2);
-				sMenuPro.secondIndex = MenuListAddMenu(LEVEL4, "", DateTimeAction, NUMBER, false, 2);
-				sMenuPro.weekDayIndex = MenuListAddMenu(LEVEL4, "", DateTimeAction, OPTION, false, 0);
-					MenuListAddMenu(LEVEL5, "Monday", TitleAction, TITLE, false, 0);
-					MenuListAddMenu(LEVEL5, "Tuesday", TitleAction, TITLE, false, 0);
-					MenuListAddMenu(LEVEL5, "Wednesday", TitleAction, TITLE, false, 0);
-					MenuListAddMenu(LEVEL5, "Thursday", TitleAction, TITLE, false, 0);
-					MenuListAddMenu(LEVEL5, "Friday", TitleAction, TITLE, false, 0);
-					MenuListAddMenu(LEVEL5, "Saturday", TitleAction, TITLE, false, 0);
-					MenuListAddMenu(LEVEL5, "Sunday", TitleAction, TITLE, false, 0);
-			MenuListAddMenu(LEVEL3, "Change Password", TitleAction, TITLE, false, 0);
-				sMenuPro.oldPasswordIndex = MenuListAddMenu(LEVEL4, "", PasswordAction, NUMBER, true, 6);
-				sMenuPro.newPasswordIndex = MenuListAddMenu(LEVEL4, "", PasswordAction, NUMBER, true, 6);
-				sMenuPro.confirmPasswordIndex = MenuListAddMenu(LEVEL4, "", PasswordAction, NUMBER, true, 6);
-		MenuListAddMenu(LEVEL2, "Report", TitleAction, TITLE, false, 0);
-			MenuListAddMenu(LEVEL3, "Daily Report", TitleAction, TITLE, false, 0);
-			MenuListAddMenu(LEVEL3, "Weekly Report", TitleAction, TITLE, false, 0);
-			MenuListAddMenu(LEVEL3, "Monthly Report", TitleAction, TITLE, false, 0);
-		MenuListAddMenu(LEVEL2, "Info", TitleAction, TITLE, false, 0);
-			MenuListAddMenu(LEVEL3, "Version", TitleAction, TITLE, false, 0);
-				MenuListAddMenu(LEVEL4, "V1.0.0", InfoAction, INFO, false, 0);
-			MenuListAddMenu(LEVEL3, "Last Update", TitleAction, TITLE, false, 0);
-				MenuListAddMenu(LEVEL4, "20.05.25 23:00", InfoAction, INFO, false, 0);
-    sMenuPro.pCurrentMenu = &sMenuPro.sMenu[0];
-    sMenuPro.pCurrentMenu->menuAction();
-    sMenuPro.AlphabetButtonTimerId = sSoftwareTimer.Initialize(NULL, AlphabetButtonCallback, NULL, TIMER_ONCE_TYPE);
-    sprintf(sMenuPro.password, "123456");
+    uint8_t i = 0;
+    uint8_t length;
+
+    sMenuPro.dateTimeCoroutineId = sCoroutine.Initialize(DateTimeCoroutine);
+    MenuListBuildPathIndex();
+    for(i = 0; i < MENU_RECENT_COUNT; i++)
+    {
+        sMenuPro.recentMenu[i] = MENU_NONE;
+    }
+    sMenuPro.pendingMenu = MENU_NONE;
+    sMenuPro.viewportTop = MENU_NONE;
+    sMenuPro.virtualMenu = MENU_NONE;
+    // Stored value, else empty / default
+    for(i = 0; i < maximumMenuValue; i++)
+    {
+        if(menuField[i].eMenuStoreKey != STORE_NONE)
+        {
+            sMenuPro.value[i][sFlashStore.Read(menuField[i].eMenuStoreKey, sMenuPro.value[i], TITLE_MAX_LENGTH - 1)] = 0;
+        }
+    }
+    length = sFlashStore.Read(STORE_PASSWORD, sMenuPro.password, sizeof(sMenuPro.password) - 1);
+    sMenuPro.password[length] = 0;
+    if(length == 0)
+    {
+        sprintf(sMenuPro.password, "123456");
+    }
+    sMenuPro.pCurrentMenu = &menuTree[MENU_DATE_TIME];
+    MenuListShow();
 }
 
 /*******************************************************************************
@@ -1180,73 +1624,114 @@ static void MenuListButtonPressed(uint32_t pressedButton)
 	switch(sMenuPro.pCurrentMenu->uMenuAttribute.eMenuType)
 	{
 		case TITLE:
+			if(MENU_INDEX(sMenuPro.pCurrentMenu) == MENU_DATE_TIME && MenuListShortcutButton(pressedButton))
+			{
+				break;
+			}
 			MenuListNavigationButton(pressedButton);
 			break;
-		case NUMBER:
-			MenuListNumberButton(pressedButton);
-			break;
-		case ALPHABET:
-			MenuListAlphabetButton(pressedButton);
-			break;
-		case OPTION:
-			MenuListOptionButton(pressedButton);
+		case EDITOR:
+			MenuListEditorButton(sFieldEditor.Key(sKeyMap.Get(pressedButton)));
 			break;
 		case INFO:
 			MenuListInfoButton(pressedButton);
 			break;
+		case VIRTUAL:
+			MenuListVirtualButton(sKeyMap.Get(pressedButton)->eKeyFunction);
+			break;
 		default:
 			break;
 	}
 }
 
 /*******************************************************************************
- * @fn      MenuListUpdateDateTime
- * @brief   Menu list update date and time
- * @param   None
+ * @fn      MenuListButtonRepeated
+ * @brief   Menu list receive held button auto repeat, only Up / Down scroll
+ * @param   pressedButton
  * @return  None
  ******************************************************************************/
-static void MenuListUpdateDateTime(void)
+static void MenuListButtonRepeated(uint32_t pressedButton)
 {
-	char dateTime[17];
-	RTC_DateTypeDef sDate;
-	RTC_TimeTypeDef sTime;
+	// Digit is not repeated, Up / Down key may also be a digit key
+	sKEY_MAP_ENTRY sKeyMapEntry = {0, sKeyMap.Get(pressedButton)->eKeyFunction};
 
-	if(sMenuPro.pCurrentMenu->index != sMenuPro.dateTimeIndex)
+	if(sKeyMapEntry.eKeyFunction != KEY_UP && sKeyMapEntry.eKeyFunction != KEY_DOWN)
 	{
 		return;
 	}
-	RtcGetDateTime(&sDate, &sTime);
-	sprintf(dateTime, "20%02d-%02d-%02d", sDate.Year, sDate.Month, sDate.Date);
-	sLcd.WriteString(0, 0, dateTime, LCD_ALIGN_CENTER);
-	switch(sDate.WeekDay)
+	switch(sMenuPro.pCurrentMenu->uMenuAttribute.eMenuType)
 	{
-		case RTC_WEEKDAY_MONDAY:
-			sprintf(dateTime, "MON ");
-			break;
-		case RTC_WEEKDAY_TUESDAY:
-			sprintf(dateTime, "TUE ");
-			break;
-		case RTC_WEEKDAY_WEDNESDAY:
-			sprintf(dateTime, "WED ");
-			break;
-		case RTC_WEEKDAY_THURSDAY:
-			sprintf(dateTime, "THU ");
-			break;
-		case RTC_WEEKDAY_FRIDAY:
-			sprintf(dateTime, "FRI ");
+		case TITLE:
+			MenuListNavigationButton(pressedButton);
 			break;
-		case RTC_WEEKDAY_SATURDAY:
-			sprintf(dateTime, "SAT ");
+		case EDITOR:
+			MenuListEditorButton(sFieldEditor.Key(&sKeyMapEntry));
 			break;
-		case RTC_WEEKDAY_SUNDAY:
-			sprintf(dateTime, "SUN ");
+		case VIRTUAL:
+			MenuListVirtualButton(sKeyMapEntry.eKeyFunction);
 			break;
 		default:
-			sprintf(dateTime, "    ");
 			break;
 	}
-	sprintf(dateTime + 4, "%02d:%02d:%02d", sTime.Hours, sTime.Minutes, sTime.Seconds);
-	sLcd.WriteString(1, 0, dateTime, LCD_ALIGN_CENTER);
+}
+
+/*******************************************************************************
+ * @fn      MenuListButtonLongPressed
+ * @brief   Menu list receive held button long press, only editor take key
+ * 			with long press function
+ * @param   pressedButton
+ * @return  None
+ ******************************************************************************/
+static void MenuListButtonLongPressed(uint32_t pressedButton)
+{
+	const sKEY_MAP_ENTRY *psKeyMapEntry = sKeyMap.Get(pressedButton);
+
+	if(sMenuPro.pCurrentMenu->uMenuAttribute.eMenuType != EDITOR || psKeyMapEntry->eLongKeyFunction == KEY_NONE)
+	{
+		return;
+	}
+	MenuListEditorButton(sFieldEditor.LongKey(psKeyMapEntry));
+}
+
+/*******************************************************************************
+ * @fn      MenuListUpdateDateTime
+ * @brief   Menu list update date and time
+ * @param   None
+ * @return  None
+ ******************************************************************************/
+static void MenuListUpdateDateTime(void)
+{
+	if(!MenuListIsDateTimeShown())
+	{
+		return;
+	}
+	// Redraw in background, key event can be served between two lines
+	sCoroutine.Start(sMenuPro.dateTimeCoroutineId);
+}
+
+/*******************************************************************************
+ * @fn      MenuListUpdateTemperature
+ * @brief   Menu list show new temperature if it is on screen
+ * @param   None
+ * @return  None
+ ******************************************************************************/
+static void MenuListUpdateTemperature(void)
+{
+	if(sMenuPro.pCurrentMenu->eMenuAction == TEMPERATURE_ACTION)
+	{
+		MenuListShow();
+	}
+}
+
+/*******************************************************************************
+ * @fn      MenuListGetScreen
+ * @brief   Menu list get current screen
+ * @param   None
+ * @return  Index of current menu
+ ******************************************************************************/
+static uint16_t MenuListGetScreen(void)
+{
+	return MENU_INDEX(sMenuPro.pCurrentMenu);
 }
 
 /*******************************************************************************
@@ -1257,6 +1742,10 @@ sMENU_LIST sMenuList =
 {
 	MenuListInitialize,
 	MenuListButtonPressed,
+	MenuListButtonRepeated,
+	MenuListButtonLongPressed,
 	MenuListUpdateDateTime,
+	MenuListUpdateTemperature,
+	MenuListGetScreen,
 };
 
@@ -0,0 +1,320 @@
+/*******************************************************************************
+ * Filename:			power_manager.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Idle low power function
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "power_manager.h"
+#include "software_timer.h"
+#include "coroutine.h"
+#include "matrix_button.h"
+#include "rtc.h"
+#include "diagnostic.h"
+#include "flash_store.h"
+#include "temperature_sensor.h"
+#include "kernel.h"
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+
+/*******************************************************************************
+ * LOCAL VARIBLES
+ ******************************************************************************/
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define power manager property structure
+typedef struct
+{
+	uint64_t runCycles;
+	uint64_t sleepCycles;
+	uint64_t stop2Time;
+	uint32_t lastCycle;
+	uint32_t wakeCycle;
+	uint32_t stop2StartTick;
+	bool stop2TimePending;
+	bool wakePending;
+	ePOWER_MODE eWakeMode;
+	uint32_t wakeCount[maximumPowerMode];
+	uint32_t lastWakeLatency[maximumPowerMode];
+	uint32_t maximumWakeLatency[maximumPowerMode];
+	uint32_t clockRestoreCycles;
+}
+sPOWER_MANAGER_PRO;
+static sPOWER_MANAGER_PRO sPowerManagerPro;
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+static uint32_t PowerManagerGetRtcTick(void);
+static void PowerManagerUpdateStop2Time(void);
+static void PowerManagerRestoreClock(void);
+
+/*******************************************************************************
+ * @fn      PowerManagerGetRtcTick
+ * @brief   Get time of day in RTC sub second tick
+ * @param	None
+ * @return	Tick (1 tick = 1 / (SynchPrediv + 1) second)
+ ******************************************************************************/
+static uint32_t PowerManagerGetRtcTick(void)
+{
+	uint32_t subSecond = RTC->SSR;
+	uint32_t time = RTC->TR;
+	uint32_t second = 0;
+
+	// Read date register to unlock the calendar shadow registers
+	(void)RTC->DR;
+	second += RTC_Bcd2ToByte((time & (RTC_TR_HT | RTC_TR_HU)) >> RTC_TR_HU_Pos) * 3600;
+	second += RTC_Bcd2ToByte((time & (RTC_TR_MNT | RTC_TR_MNU)) >> RTC_TR_MNU_Pos) * 60;
+	second += RTC_Bcd2ToByte((time & (RTC_TR_ST | RTC_TR_SU)) >> RTC_TR_SU_Pos);
+	return (second * (hrtc.Init.SynchPrediv + 1)) + (hrtc.Init.SynchPrediv - subSecond);
+}
+
+/*******************************************************************************
+ * @fn      PowerManagerUpdateStop2Time
+ * @brief   Account the time spent in last stop 2 mode
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+static void PowerManagerUpdateStop2Time(void)
+{
+	uint32_t tickPerDay = 86400 * (hrtc.Init.SynchPrediv + 1);
+	uint32_t tick;
+
+	if(!sPowerManagerPro.stop2TimePending)
+	{
+		return;
+	}
+	sPowerManagerPro.stop2TimePending = false;
+	// Calendar shadow registers are not valid until resynchronized after stop mode
+	if(HAL_RTC_WaitForSynchro(&hrtc) != HAL_OK)
+	{
+		return;
+	}
+	tick = (PowerManagerGetRtcTick() + tickPerDay - sPowerManagerPro.stop2StartTick) % tickPerDay;
+	sPowerManagerPro.stop2Time += ((uint64_t)tick * 1000000) / (hrtc.Init.SynchPrediv + 1);
+}
+
+/*******************************************************************************
+ * @fn      PowerManagerRestoreClock
+ * @brief   Restore PLL clock after wake up from stop mode
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+static void PowerManagerRestoreClock(void)
+{
+	// MSI is woken at the range used as PLL source and the PLL configuration
+	// and flash latency are retained, only need to relock the PLL and switch
+	__HAL_RCC_PLL_ENABLE();
+	while(__HAL_RCC_GET_FLAG(RCC_FLAG_PLLRDY) == 0)
+	{
+	}
+	__HAL_RCC_SYSCLK_CONFIG(RCC_SYSCLKSOURCE_PLLCLK);
+	while(__HAL_RCC_GET_SYSCLK_SOURCE() != RCC_SYSCLKSOURCE_STATUS_PLLCLK)
+	{
+	}
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+static void PowerManagerInitialize(void);
+static void PowerManagerIdle(volatile uint32_t *eventFlags);
+static void PowerManagerEventDispatched(void);
+static void PowerManagerGetStatistic(sPOWER_STATISTIC *psPowerStatistic);
+static void PowerManagerPrint(void);
+
+/*******************************************************************************
+ * @fn      PowerManagerInitialize
+ * @brief   Power manager initialize
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+static void PowerManagerInitialize(void)
+{
+	CYCLE_COUNTER_ENABLE();
+#ifdef DEBUG
+	// Keep debugger connected in low power mode
+	HAL_DBGMCU_EnableDBGSleepMode();
+	HAL_DBGMCU_EnableDBGStopMode();
+#endif
+	// Wake up from stop mode with MSI, it is the PLL source
+	__HAL_RCC_WAKEUPSTOP_CLK_CONFIG(RCC_STOP_WAKEUPCLOCK_MSI);
+	memset(&sPowerManagerPro, 0, sizeof(sPowerManagerPro));
+	sPowerManagerPro.lastCycle = CYCLE_COUNTER_GET();
+}
+
+/*******************************************************************************
+ * @fn      PowerManagerIdle
+ * @brief   Enter sleep or stop 2 mode until next interrupt
+ * @param	eventFlags
+ * @return	None
+ ******************************************************************************/
+static void PowerManagerIdle(volatile uint32_t *eventFlags)
+{
+	uint32_t cycle;
+	ePOWER_MODE ePowerMode = POWER_SLEEP_MODE;
+
+	sPowerManagerPro.wakePending = false;
+	PowerManagerUpdateStop2Time();
+
+	// Interrupt still wake up the core from WFI but only be served after
+	// clock restored
+	__disable_irq();
+	// Event flag raised after main loop checked it
+	if(*eventFlags != 0)
+	{
+		__enable_irq();
+		return;
+	}
+#if POWER_MANAGER_STOP2_ENABLE
+	// High speed timer and coroutine delay are not running, only RTC wake up
+	// and EXTI are needed. Keypad scan is handed over to row EXTI first, it
+	// stop its own scan timer.
+	if(sCoroutine.IsIdle() && sMatrixButton.EnterLowPower())
+	{
+		// Flash erase and program must not be cut by stop mode, nor a
+		// temperature burst, ADC and its trigger timer stop there
+		if(sSoftwareTimer.IsIdle() && sFlashStore.IsIdle() && sTemperatureSensor.IsIdle()
+#if KERNEL_ENABLE
+				// Kernel delay is counted by SysTick, it is suspended there
+				&& sKernel.IsIdle()
+#endif
+				)
+		{
+			ePowerMode = POWER_STOP2_MODE;
+		}
+		else
+		{
+			sMatrixButton.ExitLowPower();
+		}
+	}
+#endif
+
+	cycle = CYCLE_COUNTER_GET();
+	sPowerManagerPro.runCycles += cycle - sPowerManagerPro.lastCycle;
+	if(ePowerMode == POWER_STOP2_MODE)
+	{
+		sPowerManagerPro.stop2StartTick = PowerManagerGetRtcTick();
+		HAL_SuspendTick();
+		HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
+		sPowerManagerPro.wakeCycle = CYCLE_COUNTER_GET();
+		PowerManagerRestoreClock();
+		HAL_ResumeTick();
+		sPowerManagerPro.clockRestoreCycles = CYCLE_COUNTER_GET() - sPowerManagerPro.wakeCycle;
+		sPowerManagerPro.stop2TimePending = true;
+		// Resume keypad scan, key woke up the MCU is measured to its event
+		sDiagnostic.Wakeup(sMatrixButton.ExitLowPower() ? matrixButtonEventFlag : maximumEventFlag, sPowerManagerPro.wakeCycle);
+	}
+	else
+	{
+		HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+		sPowerManagerPro.wakeCycle = CYCLE_COUNTER_GET();
+		sPowerManagerPro.sleepCycles += sPowerManagerPro.wakeCycle - cycle;
+	}
+	sPowerManagerPro.wakeCount[ePowerMode]++;
+	sPowerManagerPro.eWakeMode = ePowerMode;
+	sPowerManagerPro.wakePending = true;
+	sPowerManagerPro.lastCycle = CYCLE_COUNTER_GET();
+	__enable_irq();
+}
+
+/*******************************************************************************
+ * @fn      PowerManagerEventDispatched
+ * @brief   Main loop start to dispatch event, measure wake up latency
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+static void PowerManagerEventDispatched(void)
+{
+	uint32_t latency;
+
+	if(!sPowerManagerPro.wakePending)
+	{
+		return;
+	}
+	sPowerManagerPro.wakePending = false;
+	latency = CYCLE_COUNTER_GET() - sPowerManagerPro.wakeCycle;
+	sPowerManagerPro.lastWakeLatency[sPowerManagerPro.eWakeMode] = latency;
+	if(latency > sPowerManagerPro.maximumWakeLatency[sPowerManagerPro.eWakeMode])
+	{
+		sPowerManagerPro.maximumWakeLatency[sPowerManagerPro.eWakeMode] = latency;
+	}
+}
+
+/*******************************************************************************
+ * @fn      PowerManagerGetStatistic
+ * @brief   Get time in each mode, wake up latency and average current proxy
+ * @param	psPowerStatistic
+ * @return	None
+ ******************************************************************************/
+static void PowerManagerGetStatistic(sPOWER_STATISTIC *psPowerStatistic)
+{
+	uint8_t i = 0;
+	uint32_t cyclePerMicrosecond = SystemCoreClock / 1000000;
+	uint64_t totalTime = 0;
+	uint64_t totalCharge = 0;
+	const uint32_t modeCurrent[maximumPowerMode] =
+	{
+		POWER_RUN_CURRENT,
+		POWER_SLEEP_CURRENT,
+		POWER_STOP2_CURRENT,
+	};
+
+	psPowerStatistic->modeTime[POWER_RUN_MODE] = sPowerManagerPro.runCycles / cyclePerMicrosecond;
+	psPowerStatistic->modeTime[POWER_SLEEP_MODE] = sPowerManagerPro.sleepCycles / cyclePerMicrosecond;
+	psPowerStatistic->modeTime[POWER_STOP2_MODE] = sPowerManagerPro.stop2Time;
+	for(i = 0; i < maximumPowerMode; i++)
+	{
+		psPowerStatistic->wakeCount[i] = sPowerManagerPro.wakeCount[i];
+		psPowerStatistic->lastWakeLatency[i] = sPowerManagerPro.lastWakeLatency[i];
+		psPowerStatistic->maximumWakeLatency[i] = sPowerManagerPro.maximumWakeLatency[i];
+		totalTime += psPowerStatistic->modeTime[i];
+		totalCharge += psPowerStatistic->modeTime[i] * modeCurrent[i];
+	}
+	psPowerStatistic->clockRestoreCycles = sPowerManagerPro.clockRestoreCycles;
+	psPowerStatistic->averageCurrent = (totalTime > 0) ? (totalCharge / totalTime) : POWER_RUN_CURRENT;
+}
+
+/*******************************************************************************
+ * @fn      PowerManagerPrint
+ * @brief   Print time in each mode and wake up latency to SWV ITM data console
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+static void PowerManagerPrint(void)
+{
+	uint32_t cyclePerMicrosecond = SystemCoreClock / 1000000;
+	sPOWER_STATISTIC sPowerStatistic;
+
+	PowerManagerGetStatistic(&sPowerStatistic);
+	printf("Power: run %lu sleep %lu stop2 %lu ms, %lu uA\n",
+			(uint32_t)(sPowerStatistic.modeTime[POWER_RUN_MODE] / 1000),
+			(uint32_t)(sPowerStatistic.modeTime[POWER_SLEEP_MODE] / 1000),
+			(uint32_t)(sPowerStatistic.modeTime[POWER_STOP2_MODE] / 1000),
+			sPowerStatistic.averageCurrent);
+	printf("Wake: sleep n %lu last %lu max %lu us, stop2 n %lu last %lu max %lu us, clock %lu cycle\n",
+			sPowerStatistic.wakeCount[POWER_SLEEP_MODE],
+			sPowerStatistic.lastWakeLatency[POWER_SLEEP_MODE] / cyclePerMicrosecond,
+			sPowerStatistic.maximumWakeLatency[POWER_SLEEP_MODE] / cyclePerMicrosecond,
+			sPowerStatistic.wakeCount[POWER_STOP2_MODE],
+			sPowerStatistic.lastWakeLatency[POWER_STOP2_MODE] / cyclePerMicrosecond,
+			sPowerStatistic.maximumWakeLatency[POWER_STOP2_MODE] / cyclePerMicrosecond,
+			sPowerStatistic.clockRestoreCycles);
+}
+
+// Power manager function structure
+sPOWER_MANAGER sPowerManager =
+{
+	PowerManagerInitialize,
+	PowerManagerIdle,
+	PowerManagerEventDispatched,
+	PowerManagerGetStatistic,
+	PowerManagerPrint,
+};
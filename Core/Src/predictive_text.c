@@ -0,0 +1,179 @@
+/*******************************************************************************
+ * Filename:			predictive_text.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    One key per letter word lookup in flash dictionary
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "predictive_text.h"
+#include "predictive_dictionary.h"
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+static uint16_t PredictiveTextFirstChild(uint16_t node);
+static bool PredictiveTextIsTerminal(uint16_t node);
+static uint16_t PredictiveTextGroup(uint16_t node);
+
+/*******************************************************************************
+ * @fn      PredictiveTextFirstChild
+ * @brief   Level order index of first child, child bit count before node
+ * 			plus root, count at most one rank block
+ * @paramz  node
+ * @return  First child node
+ ******************************************************************************/
+static uint16_t PredictiveTextFirstChild(uint16_t node)
+{
+	uint16_t index = node - (node % PREDICTIVE_RANK_BLOCK);
+	uint16_t rank = predictiveChildRank[node / PREDICTIVE_RANK_BLOCK];
+
+	for(; index < node; index++)
+	{
+		rank += __builtin_popcount(predictiveChild[index]);
+	}
+
+	return rank + 1;
+}
+
+/*******************************************************************************
+ * @fn      PredictiveTextIsTerminal
+ * @brief   Check any word end at node
+ * @paramz  node
+ * @return  True if node has word
+ ******************************************************************************/
+static bool PredictiveTextIsTerminal(uint16_t node)
+{
+	return (predictiveTerminal[node / PREDICTIVE_RANK_BLOCK] & (1U << (node % PREDICTIVE_RANK_BLOCK))) != 0;
+}
+
+/*******************************************************************************
+ * @fn      PredictiveTextGroup
+ * @brief   Word group of terminal node, terminal bit count before node
+ * @paramz  node
+ * @return  Word group
+ ******************************************************************************/
+static uint16_t PredictiveTextGroup(uint16_t node)
+{
+	uint16_t mask = (1U << (node % PREDICTIVE_RANK_BLOCK)) - 1;
+
+	return predictiveTerminalRank[node / PREDICTIVE_RANK_BLOCK] + __builtin_popcount(predictiveTerminal[node / PREDICTIVE_RANK_BLOCK] & mask);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+static uint16_t PredictiveTextNext(uint16_t node, char digit);
+static uint8_t PredictiveTextGetWordCount(uint16_t node);
+static const char* PredictiveTextGetWord(uint16_t node, uint8_t rank);
+static const char* PredictiveTextGetCompletion(uint16_t node);
+
+/*******************************************************************************
+ * @fn      PredictiveTextNext
+ * @brief   Extend digit sequence of node by one key
+ * @param   node		PREDICTIVE_ROOT for first key
+ * 			digit		'2' - '9'
+ * @return  Node, PREDICTIVE_NO_NODE if no word start with new sequence
+ ******************************************************************************/
+static uint16_t PredictiveTextNext(uint16_t node, char digit)
+{
+	uint8_t bit;
+
+	if(node >= PREDICTIVE_NODE_COUNT || digit < '2' || digit > '9')
+	{
+		return PREDICTIVE_NO_NODE;
+	}
+	bit = 1U << (digit - '2');
+	if((predictiveChild[node] & bit) == 0)
+	{
+		return PREDICTIVE_NO_NODE;
+	}
+
+	return PredictiveTextFirstChild(node) + __builtin_popcount(predictiveChild[node] & (bit - 1));
+}
+
+/*******************************************************************************
+ * @fn      PredictiveTextGetWordCount
+ * @brief   Number of word with exactly digit sequence of node
+ * @param   node
+ * @return  Word count
+ ******************************************************************************/
+static uint8_t PredictiveTextGetWordCount(uint16_t node)
+{
+	uint16_t group;
+	uint32_t index;
+	uint8_t count = 0;
+
+	if(node >= PREDICTIVE_NODE_COUNT || !PredictiveTextIsTerminal(node))
+	{
+		return 0;
+	}
+	group = PredictiveTextGroup(node);
+	for(index = predictiveWordIndex[group]; index < predictiveWordIndex[group + 1]; index++)
+	{
+		if(predictiveWord[index] == 0)
+		{
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/*******************************************************************************
+ * @fn      PredictiveTextGetWord
+ * @brief   Word of node by frequency rank
+ * @param   node
+ * 			rank		0 is most frequent, wrap around word count
+ * @return  Word, NULL if node has no word
+ ******************************************************************************/
+static const char* PredictiveTextGetWord(uint16_t node, uint8_t rank)
+{
+	uint8_t count = PredictiveTextGetWordCount(node);
+	uint32_t index;
+
+	if(count == 0)
+	{
+		return NULL;
+	}
+	index = predictiveWordIndex[PredictiveTextGroup(node)];
+	for(rank %= count; rank > 0; rank--)
+	{
+		index += strlen(&predictiveWord[index]) + 1;
+	}
+
+	return &predictiveWord[index];
+}
+
+/*******************************************************************************
+ * @fn      PredictiveTextGetCompletion
+ * @brief   A longer word start with digit sequence of node, for show letter
+ * 			of sequence not yet a word
+ * @param   node
+ * @return  Word, NULL if node is invalid
+ ******************************************************************************/
+static const char* PredictiveTextGetCompletion(uint16_t node)
+{
+	if(node >= PREDICTIVE_NODE_COUNT)
+	{
+		return NULL;
+	}
+	// Node without word always has child
+	while(!PredictiveTextIsTerminal(node))
+	{
+		node = PredictiveTextFirstChild(node);
+	}
+
+	return PredictiveTextGetWord(node, 0);
+}
+
+// Predictive text function structure
+sPREDICTIVE_TEXT sPredictiveText =
+{
+	PredictiveTextNext,
+	PredictiveTextGetWordCount,
+	PredictiveTextGetWord,
+	PredictiveTextGetCompletion,
+};
@@ -0,0 +1,228 @@
+/*******************************************************************************
+ * Filename:			report.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Daily, weekly and monthly aggregate of timed sample
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "report.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+#define REPORT_SECOND_PER_DAY		86400
+// 1970-01-01 is Thursday, ISO week start at Monday 3 days before
+#define REPORT_WEEK_OFFSET			3
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define report property structure
+typedef struct
+{
+	// Ring table of each period, period key select the slot
+	sREPORT_AGGREGATE daily[REPORT_DAY_COUNT];
+	sREPORT_AGGREGATE weekly[REPORT_WEEK_COUNT];
+	sREPORT_AGGREGATE monthly[REPORT_MONTH_COUNT];
+	// Month of last day, calendar is only worked out when day change
+	uint16_t cachedDay;
+	uint16_t cachedMonth;
+	sREPORT_STATISTIC sStatistic;
+}
+sREPORT_PRO;
+static sREPORT_PRO sReportPro;
+
+// Ring table and its size of each period
+static const struct
+{
+	sREPORT_AGGREGATE *psTable;
+	uint16_t size;
+}
+reportTable[maximumReportPeriod] =
+{
+	{sReportPro.daily, REPORT_DAY_COUNT},
+	{sReportPro.weekly, REPORT_WEEK_COUNT},
+	{sReportPro.monthly, REPORT_MONTH_COUNT},
+};
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+static uint16_t ReportKey(eREPORT_PERIOD eReportPeriod, time_t unixTime);
+
+/*******************************************************************************
+ * @fn      ReportKey
+ * @brief   Period number since 1970 of time
+ * @paramz  eReportPeriod
+ * 			unixTime
+ * @return  Day, ISO week or month number
+ ******************************************************************************/
+static uint16_t ReportKey(eREPORT_PERIOD eReportPeriod, time_t unixTime)
+{
+	uint16_t day = unixTime / REPORT_SECOND_PER_DAY;
+	struct tm *psTime;
+
+	switch(eReportPeriod)
+	{
+		case REPORT_DAILY:
+			return day;
+		case REPORT_WEEKLY:
+			return (day + REPORT_WEEK_OFFSET) / 7;
+		default:
+			if(day != sReportPro.cachedDay)
+			{
+				psTime = localtime(&unixTime);
+				sReportPro.cachedDay = day;
+				sReportPro.cachedMonth = (psTime->tm_year - 70) * 12 + psTime->tm_mon;
+			}
+			return sReportPro.cachedMonth;
+	}
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+static void ReportInitialize(void);
+static void ReportAddSample(time_t unixTime, int16_t value);
+static bool ReportGet(eREPORT_PERIOD eReportPeriod, time_t unixTime, uint16_t index, sREPORT_AGGREGATE *psReportAggregate);
+static void ReportGetStatistic(sREPORT_STATISTIC *psReportStatistic);
+static void ReportPrint(void);
+
+/*******************************************************************************
+ * @fn      ReportInitialize
+ * @brief   Report initialize, every table empty
+ * @param   None
+ * @return  None
+ ******************************************************************************/
+static void ReportInitialize(void)
+{
+	memset(&sReportPro, 0, sizeof(sReportPro));
+	// Day 0 is never a sample day, force first calendar lookup
+	sReportPro.cachedDay = 0xFFFF;
+}
+
+/*******************************************************************************
+ * @fn      ReportAddSample
+ * @brief   Add sample to aggregate of its day, week and month, one slot per
+ * 			period so cost does not grow with sample count
+ * @param   unixTime
+ * 			value
+ * @return  None
+ ******************************************************************************/
+static void ReportAddSample(time_t unixTime, int16_t value)
+{
+	uint32_t cycle = CYCLE_COUNTER_GET();
+	sREPORT_AGGREGATE *psReportAggregate;
+	uint16_t key;
+	uint8_t period = 0;
+
+	for(period = 0; period < maximumReportPeriod; period++)
+	{
+		key = ReportKey(period, unixTime);
+		psReportAggregate = &reportTable[period].psTable[key % reportTable[period].size];
+		if(psReportAggregate->count == 0 || (int16_t)(key - psReportAggregate->key) > 0)
+		{
+			// Slot of older period is reused
+			psReportAggregate->key = key;
+			psReportAggregate->sum = 0;
+			psReportAggregate->count = 0;
+			psReportAggregate->minimum = value;
+			psReportAggregate->maximum = value;
+		}
+		else if(key != psReportAggregate->key)
+		{
+			// Period is already overwritten by newer one
+			sReportPro.sStatistic.droppedCount++;
+			continue;
+		}
+		psReportAggregate->sum += value;
+		psReportAggregate->count++;
+		if(value < psReportAggregate->minimum)
+		{
+			psReportAggregate->minimum = value;
+		}
+		if(value > psReportAggregate->maximum)
+		{
+			psReportAggregate->maximum = value;
+		}
+	}
+	sReportPro.sStatistic.sampleCount++;
+	cycle = CYCLE_COUNTER_GET() - cycle;
+	sReportPro.sStatistic.updateCycles += cycle;
+	if(cycle > sReportPro.sStatistic.maximumUpdateCycles)
+	{
+		sReportPro.sStatistic.maximumUpdateCycles = cycle;
+	}
+}
+
+/*******************************************************************************
+ * @fn      ReportGet
+ * @brief   Aggregate of a period, one table read
+ * @param   eReportPeriod
+ * 			unixTime	Time in newest period
+ * 			index		Period before it, 0 is the period of unixTime
+ * 			psReportAggregate
+ * @return  True if period has sample
+ ******************************************************************************/
+static bool ReportGet(eREPORT_PERIOD eReportPeriod, time_t unixTime, uint16_t index, sREPORT_AGGREGATE *psReportAggregate)
+{
+	uint16_t key = ReportKey(eReportPeriod, unixTime) - index;
+	const sREPORT_AGGREGATE *psSlot;
+
+	if(index >= reportTable[eReportPeriod].size)
+	{
+		return false;
+	}
+	psSlot = &reportTable[eReportPeriod].psTable[key % reportTable[eReportPeriod].size];
+	if(psSlot->count == 0 || psSlot->key != key)
+	{
+		return false;
+	}
+	*psReportAggregate = *psSlot;
+
+	return true;
+}
+
+/*******************************************************************************
+ * @fn      ReportGetStatistic
+ * @brief   Copy sample count and update cost
+ * @param   psReportStatistic
+ * @return  None
+ ******************************************************************************/
+static void ReportGetStatistic(sREPORT_STATISTIC *psReportStatistic)
+{
+	*psReportStatistic = sReportPro.sStatistic;
+}
+
+/*******************************************************************************
+ * @fn      ReportPrint
+ * @brief   Print sample count and update cost to SWV ITM data console
+ * @param   None
+ * @return  None
+ ******************************************************************************/
+static void ReportPrint(void)
+{
+	sREPORT_STATISTIC *psStatistic = &sReportPro.sStatistic;
+	uint32_t cyclePerMicrosecond = SystemCoreClock / 1000000;
+	uint32_t average = (psStatistic->sampleCount != 0) ? (uint32_t)(psStatistic->updateCycles / psStatistic->sampleCount) : 0;
+
+	printf("Report: sample %lu, dropped %lu, update %lu/%lu cycle (%lu us max)\n",
+			psStatistic->sampleCount,
+			psStatistic->droppedCount,
+			average,
+			psStatistic->maximumUpdateCycles,
+			psStatistic->maximumUpdateCycles / cyclePerMicrosecond);
+}
+
+// Report function structure
+sREPORT sReport =
+{
+	ReportInitialize,
+	ReportAddSample,
+	ReportGet,
+	ReportGetStatistic,
+	ReportPrint,
+};
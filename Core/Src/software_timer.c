@@ -25,6 +25,7 @@
 // Define software timer property structure
 typedef struct
 {
+	volatile bool isEnabled;
     uint8_t usedTimer;
     eTIMER_TYPE eTimerType[NUM_OF_SOFTWARE_TIMER];
     volatile uint32_t period[NUM_OF_SOFTWARE_TIMER];
@@ -44,6 +45,7 @@ static bool SoftwareTimerDisable(void);
 static uint8_t SoftwareTimerInitialize(SOFTWARE_TIMER_CALLBACK softwareTimerStartCallback, SOFTWARE_TIMER_CALLBACK softwareTimerCallback, SOFTWARE_TIMER_CALLBACK softwareTimerStopCallback, eTIMER_TYPE eTimerType);
 static void SoftwareTimerStart(uint8_t softwareTimerId, uint32_t countdown);
 static void SoftwareTimerStop(uint8_t softwareTimerId);
+static bool SoftwareTimerIsIdle(void);
 
 /*******************************************************************************
  * @fn      SoftwareTimerEnable
@@ -54,13 +56,8 @@ static void SoftwareTimerStop(uint8_t softwareTimerId);
  ******************************************************************************/
 static bool SoftwareTimerEnable(void)
 {
-	__HAL_TIM_CLEAR_IT(&SOFTWARE_TIMER_HANDLE, TIM_IT_UPDATE);
-	if(HAL_TIM_Base_Start_IT(&SOFTWARE_TIMER_HANDLE) != HAL_OK)
-	{
-    	for(;;)
-    	{
-    	}
-	}
+	// Tick source is SysTick, it is shared with HAL tick and always running
+	sSoftwareTimerPro.isEnabled = true;
 	return true;
 }
 
@@ -73,12 +70,7 @@ static bool SoftwareTimerEnable(void)
  ******************************************************************************/
 static bool SoftwareTimerDisable(void)
 {
-	if(HAL_TIM_Base_Stop_IT(&SOFTWARE_TIMER_HANDLE) != HAL_OK)
-	{
-    	for(;;)
-    	{
-    	}
-	}
+	sSoftwareTimerPro.isEnabled = false;
 	return true;
 }
 
@@ -145,6 +137,27 @@ static void SoftwareTimerStop(uint8_t softwareTimerId)
 	}
 }
 
+/*******************************************************************************
+ * @fn      SoftwareTimerIsIdle
+ * @brief   Check all software timer are stopped
+ * @param   None
+ * @return  true	No software timer is counting down
+ *			false
+ ******************************************************************************/
+static bool SoftwareTimerIsIdle(void)
+{
+    uint8_t i = 0;
+
+    for(i = 0; i < sSoftwareTimerPro.usedTimer; i++)
+    {
+        if(sSoftwareTimerPro.countdown[i] > 0)
+        {
+        	return false;
+        }
+    }
+    return true;
+}
+
 // Software timer function structure
 sSOFTWARE_TIMER sSoftwareTimer =
 {
@@ -153,6 +166,7 @@ sSOFTWARE_TIMER sSoftwareTimer =
 	SoftwareTimerInitialize,
 	SoftwareTimerStart,
 	SoftwareTimerStop,
+	SoftwareTimerIsIdle,
 };
 
 /*******************************************************************************
@@ -176,6 +190,10 @@ void SoftwareTimerInterruptCallback(void)
 //	toggle = !toggle;
     uint8_t i = 0;
 
+    if(!sSoftwareTimerPro.isEnabled)
+    {
+    	return;
+    }
     for(i = 0; i < NUM_OF_SOFTWARE_TIMER; i++)
     {
         // Decrease countdown
@@ -0,0 +1,424 @@
+/*******************************************************************************
+ * Filename:			temperature_sensor.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    On-chip temperature sensor sampled by ADC1 and DMA
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "temperature_sensor.h"
+#include "main.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// Sequence of one trigger, VREFINT (channel 0) give VDDA of same burst
+#define TEMPERATURE_SENSOR_CHANNEL_COUNT		2
+#define TEMPERATURE_SENSOR_VREFINT_CHANNEL		0
+#define TEMPERATURE_SENSOR_TS_CHANNEL			17
+// 640.5 ADC clock, sensor need at least 5us sampling time
+#define TEMPERATURE_SENSOR_SAMPLING_TIME		7
+// ADC regular external trigger 13 is TIM6 TRGO
+#define TEMPERATURE_SENSOR_TRIGGER				13
+// Factory calibration, measured at VDDA 3.0V, temperature in 0.1 degree
+#define TEMPERATURE_SENSOR_CAL1					(*(const uint16_t*)0x1FFF75A8)
+#define TEMPERATURE_SENSOR_CAL2					(*(const uint16_t*)0x1FFF75CA)
+#define TEMPERATURE_SENSOR_VREFINT_CAL			(*(const uint16_t*)0x1FFF75AA)
+#define TEMPERATURE_SENSOR_CAL1_TEMPERATURE		300
+#define TEMPERATURE_SENSOR_CAL2_TEMPERATURE		1100
+// Sample of one half buffer
+#define TEMPERATURE_SENSOR_HALF_SIZE			(TEMPERATURE_SENSOR_BLOCK * TEMPERATURE_SENSOR_CHANNEL_COUNT)
+// Fraction bits of filter state
+#define TEMPERATURE_SENSOR_FILTER_SHIFT			4
+// ADC voltage regulator start up, us
+#define TEMPERATURE_SENSOR_REGULATOR_TIME		20
+// ADC_CR bits set by software and cleared by hardware, written as 0 so a
+// read back 1 is not set again
+#define TEMPERATURE_SENSOR_CR_SET_BITS			(ADC_CR_ADCAL | ADC_CR_JADSTP | ADC_CR_ADSTP | ADC_CR_JADSTART | \
+												 ADC_CR_ADSTART | ADC_CR_ADDIS | ADC_CR_ADEN)
+#define TEMPERATURE_SENSOR_CR_SET(bit)			(ADC1->CR = (ADC1->CR & ~TEMPERATURE_SENSOR_CR_SET_BITS) | (bit))
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define temperature sensor property structure
+typedef struct
+{
+	SOFTWARE_TIMER_CALLBACK eventCallback;
+	DMA_HandleTypeDef sampleDmaHandle;
+	TIM_HandleTypeDef triggerTimerHandle;
+	// Circular DMA buffer, one burst fill one half
+	uint16_t sample[2 * TEMPERATURE_SENSOR_HALF_SIZE];
+	volatile bool isBusy;
+	// IIR state, 0.1 degree with fraction bits
+	int32_t filter;
+	volatile int16_t value;
+	sTEMPERATURE_SENSOR_STATISTIC sStatistic;
+}
+sTEMPERATURE_SENSOR_PRO;
+static sTEMPERATURE_SENSOR_PRO sTemperatureSensorPro;
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+static bool TemperatureSensorConvert(const uint16_t *pSample, uint16_t cal1, uint16_t cal2, uint16_t vrefintCal, int32_t *pTemperature);
+static int16_t TemperatureSensorIir(int32_t *pFilter, int32_t temperature, bool isFirst);
+static void TemperatureSensorAdcEnable(void);
+static void TemperatureSensorAdcDisable(void);
+static void TemperatureSensorFilter(uint16_t firstSample);
+static void SampleHalfCallback(DMA_HandleTypeDef *hdma);
+static void SampleCompleteCallback(DMA_HandleTypeDef *hdma);
+
+/*******************************************************************************
+ * @fn      TemperatureSensorConvert
+ * @brief   Average one block to one VDDA compensated temperature, integer
+ * 			math only
+ * @paramz  pSample		VREFINT and sensor sample of each conversion
+ * 			cal1		Sensor reading at CAL1 temperature, VDDA 3.0V
+ * 			cal2		Sensor reading at CAL2 temperature, VDDA 3.0V
+ * 			vrefintCal	VREFINT reading at VDDA 3.0V
+ * 			pTemperature	0.1 degree with fraction bits
+ * @return  False if VREFINT is not converted
+ ******************************************************************************/
+static bool TemperatureSensorConvert(const uint16_t *pSample, uint16_t cal1, uint16_t cal2, uint16_t vrefintCal, int32_t *pTemperature)
+{
+	uint32_t vrefintSum = 0;
+	uint32_t sensorSum = 0;
+	int32_t sensor;
+	uint8_t i = 0;
+
+	for(i = 0; i < TEMPERATURE_SENSOR_BLOCK; i++)
+	{
+		vrefintSum += pSample[0];
+		sensorSum += pSample[1];
+		pSample += TEMPERATURE_SENSOR_CHANNEL_COUNT;
+	}
+	if(vrefintSum == 0)
+	{
+		return false;
+	}
+	// Sensor reading at VDDA of calibration, with fraction bits, block sum
+	// cancel out
+	sensor = ((sensorSum * vrefintCal) << TEMPERATURE_SENSOR_FILTER_SHIFT) / vrefintSum;
+	*pTemperature = ((sensor - (cal1 << TEMPERATURE_SENSOR_FILTER_SHIFT)) * (TEMPERATURE_SENSOR_CAL2_TEMPERATURE - TEMPERATURE_SENSOR_CAL1_TEMPERATURE)) /
+			(cal2 - cal1) + (TEMPERATURE_SENSOR_CAL1_TEMPERATURE << TEMPERATURE_SENSOR_FILTER_SHIFT);
+
+	return true;
+}
+
+/*******************************************************************************
+ * @fn      TemperatureSensorIir
+ * @brief   Feed one block temperature to IIR filter
+ * @paramz  pFilter		Filter state, 0.1 degree with fraction bits
+ * 			temperature	0.1 degree with fraction bits
+ * 			isFirst		First block, it set the filter
+ * @return  Filtered temperature rounded to 0.1 degree
+ ******************************************************************************/
+static int16_t TemperatureSensorIir(int32_t *pFilter, int32_t temperature, bool isFirst)
+{
+	if(isFirst)
+	{
+		*pFilter = temperature;
+	}
+	else
+	{
+		*pFilter += (temperature - *pFilter) >> TEMPERATURE_SENSOR_IIR_SHIFT;
+	}
+
+	return (*pFilter + (1 << (TEMPERATURE_SENSOR_FILTER_SHIFT - 1))) >> TEMPERATURE_SENSOR_FILTER_SHIFT;
+}
+
+/*******************************************************************************
+ * @fn      TemperatureSensorAdcEnable
+ * @brief   Power up ADC1 and sensor, wait for trigger. TSEN and VREFEN are
+ * 			only written while ADSTART is 0.
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TemperatureSensorAdcEnable(void)
+{
+	uint32_t cycle = CYCLE_COUNTER_GET();
+
+	ADC1->CR |= ADC_CR_ADVREGEN;
+	while((CYCLE_COUNTER_GET() - cycle) < (SystemCoreClock / 1000000) * TEMPERATURE_SENSOR_REGULATOR_TIME)
+	{
+	}
+	ADC1->ISR = ADC_ISR_ADRDY;
+	TEMPERATURE_SENSOR_CR_SET(ADC_CR_ADEN);
+	while((ADC1->ISR & ADC_ISR_ADRDY) == 0)
+	{
+	}
+	ADC123_COMMON->CCR |= ADC_CCR_TSEN | ADC_CCR_VREFEN;
+	TEMPERATURE_SENSOR_CR_SET(ADC_CR_ADSTART);
+}
+
+/*******************************************************************************
+ * @fn      TemperatureSensorAdcDisable
+ * @brief   Stop conversion before sensor is turned off, then disable ADC1
+ * 			and its regulator so stop 2 current is not raised
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TemperatureSensorAdcDisable(void)
+{
+	if((ADC1->CR & ADC_CR_ADSTART) != 0)
+	{
+		TEMPERATURE_SENSOR_CR_SET(ADC_CR_ADSTP);
+		while((ADC1->CR & ADC_CR_ADSTART) != 0)
+		{
+		}
+	}
+	ADC123_COMMON->CCR &= ~(ADC_CCR_TSEN | ADC_CCR_VREFEN);
+	if((ADC1->CR & ADC_CR_ADEN) != 0)
+	{
+		TEMPERATURE_SENSOR_CR_SET(ADC_CR_ADDIS);
+		while((ADC1->CR & ADC_CR_ADEN) != 0)
+		{
+		}
+	}
+	ADC1->CR &= ~ADC_CR_ADVREGEN;
+}
+
+/*******************************************************************************
+ * @fn      TemperatureSensorFilter
+ * @brief   End burst, average one half buffer to one VDDA compensated
+ * 			temperature and feed it to IIR filter
+ * @paramz  firstSample
+ * @return  None
+ ******************************************************************************/
+static void TemperatureSensorFilter(uint16_t firstSample)
+{
+	uint32_t cycle = CYCLE_COUNTER_GET();
+	int32_t temperature;
+
+	// Stop trigger, ADC and sensor until next burst
+	__HAL_TIM_DISABLE(&sTemperatureSensorPro.triggerTimerHandle);
+	TemperatureSensorAdcDisable();
+	if(TemperatureSensorConvert(&sTemperatureSensorPro.sample[firstSample], TEMPERATURE_SENSOR_CAL1, TEMPERATURE_SENSOR_CAL2,
+								TEMPERATURE_SENSOR_VREFINT_CAL, &temperature))
+	{
+		sTemperatureSensorPro.value = TemperatureSensorIir(&sTemperatureSensorPro.filter, temperature,
+														   sTemperatureSensorPro.value == TEMPERATURE_SENSOR_NO_VALUE);
+	}
+	sTemperatureSensorPro.isBusy = false;
+	sTemperatureSensorPro.sStatistic.blockCount++;
+	cycle = CYCLE_COUNTER_GET() - cycle;
+	if(cycle > sTemperatureSensorPro.sStatistic.maximumFilterCycles)
+	{
+		sTemperatureSensorPro.sStatistic.maximumFilterCycles = cycle;
+	}
+	sTemperatureSensorPro.eventCallback(0);
+}
+
+/*******************************************************************************
+ * @fn      SampleHalfCallback
+ * @brief   First half of sample is ready
+ * @paramz  hdma
+ * @return  None
+ ******************************************************************************/
+static void SampleHalfCallback(DMA_HandleTypeDef *hdma)
+{
+	TemperatureSensorFilter(0);
+}
+
+/*******************************************************************************
+ * @fn      SampleCompleteCallback
+ * @brief   Second half of sample is ready
+ * @paramz  hdma
+ * @return  None
+ ******************************************************************************/
+static void SampleCompleteCallback(DMA_HandleTypeDef *hdma)
+{
+	TemperatureSensorFilter(TEMPERATURE_SENSOR_HALF_SIZE);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+static void TemperatureSensorInitialize(SOFTWARE_TIMER_CALLBACK eventCallback);
+static void TemperatureSensorStart(void);
+static int16_t TemperatureSensorGet(void);
+static bool TemperatureSensorIsIdle(void);
+static void TemperatureSensorGetStatistic(sTEMPERATURE_SENSOR_STATISTIC *psTemperatureSensorStatistic);
+static void TemperatureSensorPrint(void);
+
+/*******************************************************************************
+ * @fn      TemperatureSensorInitialize
+ * @brief   Calibrate ADC1 for TIM6 TRGO, DMA1 channel 1 (request 0) move
+ * 			every conversion to circular buffer, only half and complete
+ * 			transfer interrupt the CPU. ADC is enabled per burst.
+ * @param   eventCallback	Called in interrupt when new value is filtered
+ * @return  None
+ ******************************************************************************/
+static void TemperatureSensorInitialize(SOFTWARE_TIMER_CALLBACK eventCallback)
+{
+	TIM_MasterConfigTypeDef sMasterConfig = {0};
+
+	sTemperatureSensorPro.eventCallback = eventCallback;
+	sTemperatureSensorPro.value = TEMPERATURE_SENSOR_NO_VALUE;
+
+	__HAL_RCC_ADC_CLK_ENABLE();
+	__HAL_RCC_DMA1_CLK_ENABLE();
+	__HAL_RCC_TIM6_CLK_ENABLE();
+
+	// ADC clock is HCLK / 1, regulator need 20us before calibration
+	ADC123_COMMON->CCR = ADC_CCR_CKMODE_0;
+	ADC1->CR &= ~ADC_CR_DEEPPWD;
+	ADC1->CR |= ADC_CR_ADVREGEN;
+	HAL_Delay(1);
+	ADC1->CR |= ADC_CR_ADCAL;
+	while((ADC1->CR & ADC_CR_ADCAL) != 0)
+	{
+	}
+	ADC1->SMPR1 = TEMPERATURE_SENSOR_SAMPLING_TIME << ADC_SMPR1_SMP0_Pos;
+	ADC1->SMPR2 = TEMPERATURE_SENSOR_SAMPLING_TIME << ADC_SMPR2_SMP17_Pos;
+	ADC1->SQR1 = ((TEMPERATURE_SENSOR_CHANNEL_COUNT - 1) << ADC_SQR1_L_Pos) |
+			(TEMPERATURE_SENSOR_VREFINT_CHANNEL << ADC_SQR1_SQ1_Pos) |
+			(TEMPERATURE_SENSOR_TS_CHANNEL << ADC_SQR1_SQ2_Pos);
+	// Whole sequence on rising edge of trigger, DMA in circular mode
+	ADC1->CFGR = ADC_CFGR_DMAEN | ADC_CFGR_DMACFG | ADC_CFGR_OVRMOD |
+			(TEMPERATURE_SENSOR_TRIGGER << ADC_CFGR_EXTSEL_Pos) | ADC_CFGR_EXTEN_0;
+	// Regulator off until first burst, calibration is kept out of deep power down
+	ADC1->CR &= ~ADC_CR_ADVREGEN;
+
+	sTemperatureSensorPro.sampleDmaHandle.Instance = DMA1_Channel1;
+	sTemperatureSensorPro.sampleDmaHandle.Init.Request = DMA_REQUEST_0;
+	sTemperatureSensorPro.sampleDmaHandle.Init.Direction = DMA_PERIPH_TO_MEMORY;
+	sTemperatureSensorPro.sampleDmaHandle.Init.PeriphInc = DMA_PINC_DISABLE;
+	sTemperatureSensorPro.sampleDmaHandle.Init.MemInc = DMA_MINC_ENABLE;
+	sTemperatureSensorPro.sampleDmaHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+	sTemperatureSensorPro.sampleDmaHandle.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+	sTemperatureSensorPro.sampleDmaHandle.Init.Mode = DMA_CIRCULAR;
+	sTemperatureSensorPro.sampleDmaHandle.Init.Priority = DMA_PRIORITY_LOW;
+	if(HAL_DMA_Init(&sTemperatureSensorPro.sampleDmaHandle) != HAL_OK)
+	{
+		Error_Handler();
+	}
+	sTemperatureSensorPro.sampleDmaHandle.XferHalfCpltCallback = SampleHalfCallback;
+	sTemperatureSensorPro.sampleDmaHandle.XferCpltCallback = SampleCompleteCallback;
+	HAL_NVIC_SetPriority(DMA1_Channel1_IRQn, 1, 0);
+	HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+	HAL_DMA_Start_IT(&sTemperatureSensorPro.sampleDmaHandle, (uint32_t)&ADC1->DR, (uint32_t)sTemperatureSensorPro.sample, 2 * TEMPERATURE_SENSOR_HALF_SIZE);
+
+	// 1us timer tick, update event is TRGO, started per burst
+	sTemperatureSensorPro.triggerTimerHandle.Instance = TIM6;
+	sTemperatureSensorPro.triggerTimerHandle.Init.Prescaler = (SystemCoreClock / 1000000) - 1;
+	sTemperatureSensorPro.triggerTimerHandle.Init.CounterMode = TIM_COUNTERMODE_UP;
+	sTemperatureSensorPro.triggerTimerHandle.Init.Period = TEMPERATURE_SENSOR_SAMPLE_PERIOD - 1;
+	sTemperatureSensorPro.triggerTimerHandle.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+	if(HAL_TIM_Base_Init(&sTemperatureSensorPro.triggerTimerHandle) != HAL_OK)
+	{
+		Error_Handler();
+	}
+	sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
+	sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+	if(HAL_TIMEx_MasterConfigSynchronization(&sTemperatureSensorPro.triggerTimerHandle, &sMasterConfig) != HAL_OK)
+	{
+		Error_Handler();
+	}
+}
+
+/*******************************************************************************
+ * @fn      TemperatureSensorStart
+ * @brief   Start one burst of TEMPERATURE_SENSOR_BLOCK conversion, first
+ * 			trigger is one period later so sensor has started up
+ * @param   None
+ * @return  None
+ ******************************************************************************/
+static void TemperatureSensorStart(void)
+{
+	if(sTemperatureSensorPro.isBusy)
+	{
+		sTemperatureSensorPro.sStatistic.overrunCount++;
+		return;
+	}
+	// A late trigger after last burst shift the buffer, start it again
+	if((__HAL_DMA_GET_COUNTER(&sTemperatureSensorPro.sampleDmaHandle) % TEMPERATURE_SENSOR_HALF_SIZE) != 0)
+	{
+		sTemperatureSensorPro.sStatistic.overrunCount++;
+		HAL_DMA_Abort(&sTemperatureSensorPro.sampleDmaHandle);
+		HAL_DMA_Start_IT(&sTemperatureSensorPro.sampleDmaHandle, (uint32_t)&ADC1->DR, (uint32_t)sTemperatureSensorPro.sample, 2 * TEMPERATURE_SENSOR_HALF_SIZE);
+	}
+	sTemperatureSensorPro.isBusy = true;
+	TemperatureSensorAdcEnable();
+	__HAL_TIM_SET_COUNTER(&sTemperatureSensorPro.triggerTimerHandle, 0);
+	__HAL_TIM_ENABLE(&sTemperatureSensorPro.triggerTimerHandle);
+}
+
+/*******************************************************************************
+ * @fn      TemperatureSensorGet
+ * @brief   Filtered temperature
+ * @param   None
+ * @return  0.1 degree, TEMPERATURE_SENSOR_NO_VALUE before first burst
+ ******************************************************************************/
+static int16_t TemperatureSensorGet(void)
+{
+	return sTemperatureSensorPro.value;
+}
+
+/*******************************************************************************
+ * @fn      TemperatureSensorIsIdle
+ * @brief   Check no burst is running, ADC and its regulator are off
+ * 			between burst
+ * @param   None
+ * @return  True if idle
+ ******************************************************************************/
+static bool TemperatureSensorIsIdle(void)
+{
+	return !sTemperatureSensorPro.isBusy;
+}
+
+/*******************************************************************************
+ * @fn      TemperatureSensorGetStatistic
+ * @brief   Copy block count and filter cost
+ * @param   psTemperatureSensorStatistic
+ * @return  None
+ ******************************************************************************/
+static void TemperatureSensorGetStatistic(sTEMPERATURE_SENSOR_STATISTIC *psTemperatureSensorStatistic)
+{
+	*psTemperatureSensorStatistic = sTemperatureSensorPro.sStatistic;
+}
+
+/*******************************************************************************
+ * @fn      TemperatureSensorPrint
+ * @brief   Print value, block count and filter cost to SWV ITM data console
+ * @param   None
+ * @return  None
+ ******************************************************************************/
+static void TemperatureSensorPrint(void)
+{
+	sTEMPERATURE_SENSOR_STATISTIC *psStatistic = &sTemperatureSensorPro.sStatistic;
+
+	printf("Temperature: %d/10, block %lu, overrun %lu, filter %lu cycle max\n",
+			sTemperatureSensorPro.value,
+			psStatistic->blockCount,
+			psStatistic->overrunCount,
+			psStatistic->maximumFilterCycles);
+}
+
+/*******************************************************************************
+ * INTERRUPT CALLBACK
+ ******************************************************************************/
+/*******************************************************************************
+ * @fn      TemperatureSensorDmaInterruptCallback
+ * @brief   ADC sample DMA interrupt callback
+ * @param	None
+ * @return	None
+ ******************************************************************************/
+void TemperatureSensorDmaInterruptCallback(void)
+{
+	HAL_DMA_IRQHandler(&sTemperatureSensorPro.sampleDmaHandle);
+}
+
+// Temperature sensor function structure
+sTEMPERATURE_SENSOR sTemperatureSensor =
+{
+	TemperatureSensorInitialize,
+	TemperatureSensorStart,
+	TemperatureSensorGet,
+	TemperatureSensorIsIdle,
+	TemperatureSensorGetStatistic,
+	TemperatureSensorPrint,
+};
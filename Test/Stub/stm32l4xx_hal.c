@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * Filename:			stm32l4xx_hal.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Host stand-in of the ST HAL core, GPIO, tick, flash
+ * 						lock, ADC, DMA and TIM init
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "stm32l4xx_hal.h"
+#include <x86intrin.h>
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+CoreDebug_Type hostCoreDebug;
+GPIO_TypeDef hostGpio[4];
+EXTI_TypeDef hostExti;
+uint32_t hostTick = 0;
+uint32_t (*hostCycleCounter)(void) = NULL;
+GPIO_PinState (*hostGpioRead)(GPIO_TypeDef *gpio, uint16_t pin) = NULL;
+uint32_t SystemCoreClock = 80000000;
+ADC_TypeDef hostAdc;
+ADC_Common_TypeDef hostAdcCommon;
+uint32_t hostDmaChannel;
+uint32_t hostTim6;
+FLASH_TypeDef hostFlashRegister;
+uint8_t hostFlash[HOST_FLASH_PAGE_COUNT * FLASH_PAGE_SIZE] __attribute__((aligned(4096)));
+
+/*******************************************************************************
+ * LOCAL VARIBLES
+ ******************************************************************************/
+static DWT_Type hostDwt;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+/*******************************************************************************
+ * @fn      HostDwt
+ * @brief   DWT register block with cycle counter loaded on every access
+ * @param	None
+ * @return	DWT register block
+ ******************************************************************************/
+DWT_Type *HostDwt(void)
+{
+	hostDwt.CYCCNT = (hostCycleCounter != NULL) ? hostCycleCounter() : (uint32_t)__rdtsc();
+	return &hostDwt;
+}
+
+void __disable_irq(void)
+{
+}
+
+void __enable_irq(void)
+{
+}
+
+uint32_t __get_PRIMASK(void)
+{
+	return 0;
+}
+
+void __set_PRIMASK(uint32_t primask)
+{
+}
+
+uint32_t HAL_GetTick(void)
+{
+	return hostTick;
+}
+
+void HAL_Delay(uint32_t delay)
+{
+	hostTick += delay;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *gpio, GPIO_InitTypeDef *psGpioInit)
+{
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *gpio, uint16_t pin, GPIO_PinState pinState)
+{
+	if(pinState == GPIO_PIN_SET)
+	{
+		gpio->ODR |= pin;
+	}
+	else
+	{
+		gpio->ODR &= ~pin;
+	}
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *gpio, uint16_t pin)
+{
+	if(hostGpioRead != NULL)
+	{
+		return hostGpioRead(gpio, pin);
+	}
+	return (gpio->IDR & pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+uint8_t __CLZ(uint32_t value)
+{
+	return (value == 0) ? 32 : __builtin_clz(value);
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type irq, uint32_t preemptPriority, uint32_t subPriority)
+{
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type irq)
+{
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma)
+{
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uint32_t srcAddress, uint32_t dstAddress, uint32_t dataLength)
+{
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *hdma)
+{
+	return HAL_OK;
+}
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma)
+{
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim)
+{
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *htim, TIM_MasterConfigTypeDef *psMasterConfig)
+{
+	return HAL_OK;
+}
@@ -0,0 +1,376 @@
+/*******************************************************************************
+ * Filename:			stm32l4xx_hal.h
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Host stand-in of the ST HAL header, only what the
+ * 						module under test touch
+*******************************************************************************/
+
+#ifndef _STM32L4XX_HAL_H_
+#define _STM32L4XX_HAL_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+#define __IO							volatile
+#define HAL_MAX_DELAY					0xFFFFFFFFU
+
+// Core debug and DWT, cycle counter read host time stamp counter unless the
+// test simulate its own clock
+#define CoreDebug_DEMCR_TRCENA_Msk		(1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk			(1UL << 0)
+#define CoreDebug						(&hostCoreDebug)
+#define DWT								HostDwt()
+
+// GPIO
+#define GPIO_PIN_0						((uint16_t)0x0001)
+#define GPIO_PIN_1						((uint16_t)0x0002)
+#define GPIO_PIN_2						((uint16_t)0x0004)
+#define GPIO_PIN_3						((uint16_t)0x0008)
+#define GPIO_PIN_4						((uint16_t)0x0010)
+#define GPIO_PIN_5						((uint16_t)0x0020)
+#define GPIO_PIN_6						((uint16_t)0x0040)
+#define GPIO_PIN_7						((uint16_t)0x0080)
+#define GPIO_PIN_8						((uint16_t)0x0100)
+#define GPIO_PIN_9						((uint16_t)0x0200)
+#define GPIO_PIN_10						((uint16_t)0x0400)
+#define GPIO_PIN_11						((uint16_t)0x0800)
+#define GPIO_PIN_12						((uint16_t)0x1000)
+#define GPIO_PIN_13						((uint16_t)0x2000)
+#define GPIO_PIN_14						((uint16_t)0x4000)
+#define GPIO_PIN_15						((uint16_t)0x8000)
+#define GPIOA							(&hostGpio[0])
+#define GPIOB							(&hostGpio[1])
+#define GPIOC							(&hostGpio[2])
+#define GPIOH							(&hostGpio[3])
+#define GPIO_MODE_INPUT					0
+#define GPIO_MODE_OUTPUT_PP				1
+#define GPIO_NOPULL						0
+#define GPIO_PULLUP						1
+#define GPIO_SPEED_FREQ_VERY_HIGH		3
+
+// EXTI
+#define EXTI							(&hostExti)
+#define __HAL_GPIO_EXTI_CLEAR_IT(pin)	(EXTI->PR1 = (pin))
+
+// RTC
+#define RTC_WEEKDAY_SUNDAY				7
+#define RTC_FORMAT_BIN					0
+#define RTC_FLAG_WUTF					(1UL << 10)
+#define RTC_WAKEUPCLOCK_CK_SPRE_16BITS	4
+#define RTC_BKP_DR0						0
+#define __HAL_RTC_WAKEUPTIMER_CLEAR_FLAG(handle, flag)	((void)(handle))
+
+// Flash, only the last pages of bank 2 (flash store) are backed by RAM,
+// FLASH_BASE is placed so they fall in hostFlash
+#define FLASH_PAGE_SIZE					0x00000800U
+#define FLASH_BANK_SIZE					0x00080000U
+#define HOST_FLASH_PAGE_COUNT			2
+#define FLASH_BASE						((uintptr_t)hostFlash + (HOST_FLASH_PAGE_COUNT * FLASH_PAGE_SIZE) - (2 * FLASH_BANK_SIZE))
+#define FLASH_BANK_2					2
+#define FLASH_TYPEERASE_PAGES			0
+#define FLASH_TYPEPROGRAM_DOUBLEWORD	0
+#define FLASH							(&hostFlashRegister)
+#define FLASH_FLAG_ECCD					(1UL << 31)
+#define FLASH_FLAG_ALL_ERRORS			(0x0000C3FAU | FLASH_FLAG_ECCD)
+// Only ECCD of ECCR is kept, it is cleared by writing 1
+#define __HAL_FLASH_GET_FLAG(flag)		((FLASH->ECCR & (flag)) == (flag))
+#define __HAL_FLASH_CLEAR_FLAG(flag)	(FLASH->ECCR &= ~((flag) & FLASH_FLAG_ECCD))
+
+// ADC, DMA and TIM of temperature sensor, registers are plain memory so
+// only the hardware independent part can run on host
+#define ADC1							(&hostAdc)
+#define ADC123_COMMON					(&hostAdcCommon)
+#define ADC_CCR_CKMODE_0				(1UL << 16)
+#define ADC_CCR_VREFEN					(1UL << 22)
+#define ADC_CCR_TSEN					(1UL << 23)
+#define ADC_CR_ADEN						(1UL << 0)
+#define ADC_CR_ADDIS					(1UL << 1)
+#define ADC_CR_ADSTART					(1UL << 2)
+#define ADC_CR_JADSTART					(1UL << 3)
+#define ADC_CR_ADSTP					(1UL << 4)
+#define ADC_CR_JADSTP					(1UL << 5)
+#define ADC_CR_ADVREGEN					(1UL << 28)
+#define ADC_CR_DEEPPWD					(1UL << 29)
+#define ADC_CR_ADCAL					(1UL << 31)
+#define ADC_ISR_ADRDY					(1UL << 0)
+#define ADC_CFGR_DMAEN					(1UL << 0)
+#define ADC_CFGR_DMACFG					(1UL << 1)
+#define ADC_CFGR_EXTSEL_Pos				6
+#define ADC_CFGR_EXTEN_0				(1UL << 10)
+#define ADC_CFGR_OVRMOD					(1UL << 12)
+#define ADC_SMPR1_SMP0_Pos				0
+#define ADC_SMPR2_SMP17_Pos				21
+#define ADC_SQR1_L_Pos					0
+#define ADC_SQR1_SQ1_Pos				6
+#define ADC_SQR1_SQ2_Pos				12
+#define DMA1_Channel1					((void*)&hostDmaChannel)
+#define DMA_REQUEST_0					0
+#define DMA_PERIPH_TO_MEMORY			0
+#define DMA_PINC_DISABLE				0
+#define DMA_MINC_ENABLE					(1UL << 7)
+#define DMA_PDATAALIGN_HALFWORD			(1UL << 8)
+#define DMA_MDATAALIGN_HALFWORD			(1UL << 10)
+#define DMA_CIRCULAR					(1UL << 5)
+#define DMA_PRIORITY_LOW				0
+#define TIM6							((void*)&hostTim6)
+#define TIM_COUNTERMODE_UP				0
+#define TIM_AUTORELOAD_PRELOAD_DISABLE	0
+#define TIM_TRGO_UPDATE					(2UL << 4)
+#define TIM_MASTERSLAVEMODE_DISABLE		0
+#define __HAL_RCC_ADC_CLK_ENABLE()		do {} while(0)
+#define __HAL_RCC_DMA1_CLK_ENABLE()		do {} while(0)
+#define __HAL_RCC_TIM6_CLK_ENABLE()		do {} while(0)
+#define __HAL_TIM_ENABLE(handle)		((void)(handle))
+#define __HAL_TIM_DISABLE(handle)		((void)(handle))
+#define __HAL_TIM_SET_COUNTER(handle, counter)	((void)(handle))
+#define __HAL_DMA_GET_COUNTER(handle)	((void)(handle), 0)
+
+/*******************************************************************************
+ * ENUMERATE
+ ******************************************************************************/
+typedef enum
+{
+	HAL_OK = 0,
+	HAL_ERROR,
+	HAL_BUSY,
+	HAL_TIMEOUT,
+}
+HAL_StatusTypeDef;
+
+typedef enum
+{
+	FLASH_IRQn = 4,
+	DMA1_Channel1_IRQn = 11,
+}
+IRQn_Type;
+
+typedef enum
+{
+	GPIO_PIN_RESET = 0,
+	GPIO_PIN_SET,
+}
+GPIO_PinState;
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+typedef struct
+{
+	volatile uint32_t DEMCR;
+}
+CoreDebug_Type;
+
+typedef struct
+{
+	volatile uint32_t CTRL;
+	volatile uint32_t CYCCNT;
+}
+DWT_Type;
+
+typedef struct
+{
+	volatile uint32_t ODR;
+	volatile uint32_t IDR;
+}
+GPIO_TypeDef;
+
+typedef struct
+{
+	uint32_t Pin;
+	uint32_t Mode;
+	uint32_t Pull;
+	uint32_t Speed;
+}
+GPIO_InitTypeDef;
+
+typedef struct
+{
+	volatile uint32_t IMR1;
+	volatile uint32_t PR1;
+}
+EXTI_TypeDef;
+
+typedef struct
+{
+	uint32_t Prescaler;
+	uint32_t CounterMode;
+	uint32_t Period;
+	uint32_t AutoReloadPreload;
+}
+TIM_Base_InitTypeDef;
+
+typedef struct
+{
+	void *Instance;
+	TIM_Base_InitTypeDef Init;
+}
+TIM_HandleTypeDef;
+
+typedef struct
+{
+	uint32_t MasterOutputTrigger;
+	uint32_t MasterSlaveMode;
+}
+TIM_MasterConfigTypeDef;
+
+typedef struct
+{
+	volatile uint32_t ISR;
+	volatile uint32_t CR;
+	volatile uint32_t CFGR;
+	volatile uint32_t SMPR1;
+	volatile uint32_t SMPR2;
+	volatile uint32_t SQR1;
+	volatile uint32_t DR;
+}
+ADC_TypeDef;
+
+typedef struct
+{
+	volatile uint32_t CCR;
+}
+ADC_Common_TypeDef;
+
+typedef struct
+{
+	uint32_t Request;
+	uint32_t Direction;
+	uint32_t PeriphInc;
+	uint32_t MemInc;
+	uint32_t PeriphDataAlignment;
+	uint32_t MemDataAlignment;
+	uint32_t Mode;
+	uint32_t Priority;
+}
+DMA_InitTypeDef;
+
+typedef struct __DMA_HandleTypeDef
+{
+	void *Instance;
+	DMA_InitTypeDef Init;
+	void (*XferCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+	void (*XferHalfCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+}
+DMA_HandleTypeDef;
+
+typedef struct
+{
+	uint32_t AsynchPrediv;
+	uint32_t SynchPrediv;
+}
+RTC_InitTypeDef;
+
+typedef struct
+{
+	void *Instance;
+	RTC_InitTypeDef Init;
+}
+RTC_HandleTypeDef;
+
+typedef struct
+{
+	uint8_t Hours;
+	uint8_t Minutes;
+	uint8_t Seconds;
+	uint32_t SubSeconds;
+}
+RTC_TimeTypeDef;
+
+typedef struct
+{
+	uint8_t WeekDay;
+	uint8_t Month;
+	uint8_t Date;
+	uint8_t Year;
+}
+RTC_DateTypeDef;
+
+typedef struct
+{
+	volatile uint32_t ECCR;
+}
+FLASH_TypeDef;
+
+typedef struct
+{
+	uint32_t TypeErase;
+	uint32_t Banks;
+	uint32_t Page;
+	uint32_t NbPages;
+}
+FLASH_EraseInitTypeDef;
+
+/*******************************************************************************
+ * PUBLIC VARIABLES
+ ******************************************************************************/
+extern CoreDebug_Type hostCoreDebug;
+extern GPIO_TypeDef hostGpio[4];
+extern EXTI_TypeDef hostExti;
+// HAL tick (ms), test advance it
+extern uint32_t hostTick;
+// Simulated cycle counter, time stamp counter is read when it is not set
+extern uint32_t (*hostCycleCounter)(void);
+// Pin read of simulated hardware, IDR is read when it is not set
+extern GPIO_PinState (*hostGpioRead)(GPIO_TypeDef *gpio, uint16_t pin);
+extern uint32_t SystemCoreClock;
+extern ADC_TypeDef hostAdc;
+extern ADC_Common_TypeDef hostAdcCommon;
+extern uint32_t hostDmaChannel;
+extern uint32_t hostTim6;
+extern FLASH_TypeDef hostFlashRegister;
+// Flash store pages, test erase them (0xFF) before use. Aligned to host page
+// so a test can trap read of it.
+extern uint8_t hostFlash[HOST_FLASH_PAGE_COUNT * FLASH_PAGE_SIZE];
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+DWT_Type *HostDwt(void);
+void __disable_irq(void);
+void __enable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t delay);
+uint8_t __CLZ(uint32_t value);
+void HAL_GPIO_Init(GPIO_TypeDef *gpio, GPIO_InitTypeDef *psGpioInit);
+void HAL_GPIO_WritePin(GPIO_TypeDef *gpio, uint16_t pin, GPIO_PinState pinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *gpio, uint16_t pin);
+void HAL_NVIC_SetPriority(IRQn_Type irq, uint32_t preemptPriority, uint32_t subPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type irq);
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma);
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uint32_t srcAddress, uint32_t dstAddress, uint32_t dataLength);
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *hdma);
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma);
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *htim, TIM_MasterConfigTypeDef *psMasterConfig);
+
+// Hardware the test simulate, defined by the test reaching it
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t format);
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t format);
+HAL_StatusTypeDef HAL_RTCEx_SetWakeUpTimer_IT(RTC_HandleTypeDef *hrtc, uint32_t counter, uint32_t clock);
+// Address is 32 bit as on target, test map it back into hostFlash
+HAL_StatusTypeDef HAL_FLASH_Program_IT(uint32_t typeProgram, uint32_t address, uint64_t data);
+HAL_StatusTypeDef HAL_FLASHEx_Erase_IT(FLASH_EraseInitTypeDef *psEraseInit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _STM32L4XX_HAL_H_ */
@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+"""
+Filename:       synthetic_words.py
+Revised:        Date: 2026.10.19
+Revision:       V001
+Description:    Write a synthetic word list for predictive text benchmark
+
+Words are made of English like prefix, stem and suffix so digit sequences
+share prefixes as a real dictionary does. Same count always give the same
+list, frequency is Zipf like by generated order.
+
+Usage: synthetic_words.py count > word_list
+"""
+
+import random
+import sys
+
+PREFIX = ['', '', '', 're', 'un', 'in', 'de', 'pre', 'dis', 'over', 'out', 'sub', 'inter', 'mis', 'non', 'up']
+STEM = ['act', 'band', 'call', 'care', 'cast', 'code', 'count', 'cover', 'dial', 'draw', 'fill', 'form',
+        'grade', 'hand', 'hold', 'join', 'key', 'light', 'link', 'list', 'load', 'lock', 'mark', 'menu',
+        'move', 'name', 'note', 'pack', 'part', 'pass', 'pay', 'play', 'point', 'port', 'press', 'print',
+        'read', 'rest', 'run', 'save', 'scan', 'send', 'set', 'sign', 'start', 'state', 'store', 'take',
+        'test', 'time', 'turn', 'type', 'view', 'walk', 'watch', 'work', 'write', 'zone', 'charge', 'clock']
+SUFFIX = ['', '', 's', 'ed', 'er', 'ers', 'ing', 'able', 'ment', 'ness', 'ful', 'less', 'ive', 'ion', 'ly', 'y']
+
+
+def main():
+    count = int(sys.argv[1]) if len(sys.argv) > 1 else 10000
+    generator = random.Random(count)
+    words = []
+    seen = set()
+    candidate = [prefix + stem + suffix for prefix in PREFIX for stem in STEM for suffix in SUFFIX]
+    generator.shuffle(candidate)
+    for word in candidate:
+        if word not in seen:
+            seen.add(word)
+            words.append(word)
+    # Two stem compound when the single stem word run out
+    while len(words) < count:
+        word = generator.choice(PREFIX) + generator.choice(STEM) + generator.choice(STEM) + generator.choice(SUFFIX)
+        if word not in seen:
+            seen.add(word)
+            words.append(word)
+    for rank, word in enumerate(words[:count], 1):
+        print('%s %d' % (word, 1000000 // rank))
+
+
+if __name__ == '__main__':
+    main()
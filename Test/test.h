@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * Filename:			test.h
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Host test check and report
+*******************************************************************************/
+
+#ifndef _TEST_H_
+#define _TEST_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// Count and print failed check, test go on to show every failure
+#define TEST_CHECK(condition)	do \
+								{ \
+									testCheckCount++; \
+									if(!(condition)) \
+									{ \
+										testFailCount++; \
+										printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+									} \
+								} \
+								while(0)
+
+// Print result, return value of main
+#define TEST_RESULT()			(printf("%s: %u check, %u failed\n", __FILE__, testCheckCount, testFailCount), \
+								(testFailCount != 0))
+
+/*******************************************************************************
+ * LOCAL VARIBLES
+ ******************************************************************************/
+static unsigned int testCheckCount = 0;
+static unsigned int testFailCount = 0;
+
+#endif /* _TEST_H_ */
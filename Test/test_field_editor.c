@@ -0,0 +1,204 @@
+/*******************************************************************************
+ * Filename:			test_field_editor.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Bounded integer, date / time and predictive text
+ * 						field key, digit key which is also Up / Down or
+ * 						function key
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test.h"
+// Module under test, its local functions are reached directly
+#include "field_editor.c"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// Key of 4x4 layout, '8' / '0' are also Up / Down
+#define KEY_DIGIT(digit)		(&(const sKEY_MAP_ENTRY){digit, KEY_NONE})
+#define KEY_8_UP				(&(const sKEY_MAP_ENTRY){'8', KEY_UP})
+#define KEY_0_DOWN				(&(const sKEY_MAP_ENTRY){'0', KEY_DOWN})
+// Held repeat of a key, digit is not repeated, same as Up / Down of 5x4
+#define KEY_REPEAT_UP			(&(const sKEY_MAP_ENTRY){0, KEY_UP})
+#define KEY_REPEAT_DOWN			(&(const sKEY_MAP_ENTRY){0, KEY_DOWN})
+#define KEY_ENTER_ONLY			(&(const sKEY_MAP_ENTRY){0, KEY_ENTER})
+#define KEY_FUNCTION_C_ONLY		(&(const sKEY_MAP_ENTRY){0, KEY_FUNCTION_C})
+// '1' of 4x3, Function C and long press Function B
+#define KEY_1_4X3				(&(const sKEY_MAP_ENTRY){'1', KEY_FUNCTION_C, KEY_FUNCTION_B})
+
+/*******************************************************************************
+ * LOCAL VARIBLES
+ ******************************************************************************/
+// Backlight, 0 - 100 % step 10
+static const sFIELD integerField = {FIELD_INTEGER, false, 0, 0, 0, 100, 10, NULL};
+static const sFIELD dateField = {FIELD_DATE, false, 0, 0, 0, 0, 1, NULL};
+static const sFIELD timeField = {FIELD_TIME, false, 0, 0, 0, 0, 1, NULL};
+static const sFIELD textField = {FIELD_TEXT, false, 0, CHARACTER_SET_ALPHANUMERIC, 0, 16, 1, NULL};
+
+/*******************************************************************************
+ * STUB FUNCTIONS
+ ******************************************************************************/
+static bool StubLcdSetAttribute(uint8_t noOfAttribute, ...) { return true; }
+static bool StubLcdGoTo(uint8_t line, uint8_t position) { return true; }
+static bool StubLcdWriteString(uint8_t line, uint8_t position, const char* data, eLCD_ALIGN eLcdAlign) { return true; }
+static bool StubLcdWriteCharacter(uint8_t data) { return true; }
+static bool StubLcdWriteCharacterTo(uint8_t line, uint8_t position, uint8_t data) { return true; }
+sLCD sLcd =
+{
+	NULL,
+	StubLcdSetAttribute,
+	NULL,
+	NULL,
+	StubLcdGoTo,
+	StubLcdWriteString,
+	StubLcdWriteCharacter,
+	StubLcdWriteCharacterTo,
+	NULL,
+	NULL,
+};
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+/*******************************************************************************
+ * @fn      TestInteger
+ * @brief   Bounded integer, digit type in, Up / Down step and clamp, held '8'
+ * 			step the value it replaced
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestInteger(void)
+{
+	sFieldEditor.Open(&integerField, 1, 0, "50");
+	TEST_CHECK(sFieldEditor.GetValue() == 50);
+	// Press type 8, held repeat step from 50
+	sFieldEditor.Key(KEY_8_UP);
+	TEST_CHECK(sFieldEditor.GetValue() == 8);
+	sFieldEditor.Key(KEY_REPEAT_UP);
+	TEST_CHECK(sFieldEditor.GetValue() == 60);
+	sFieldEditor.Key(KEY_REPEAT_UP);
+	TEST_CHECK(sFieldEditor.GetValue() == 70);
+	sFieldEditor.Key(KEY_0_DOWN);
+	sFieldEditor.Key(KEY_REPEAT_DOWN);
+	TEST_CHECK(sFieldEditor.GetValue() == 60);
+	TEST_CHECK(sFieldEditor.Key(KEY_ENTER_ONLY) == FIELD_DONE);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "60") == 0);
+
+	// Digit never in range is refused, step clamp at bound
+	sFieldEditor.Open(&integerField, 1, 0, "");
+	sFieldEditor.Key(KEY_DIGIT('1'));
+	sFieldEditor.Key(KEY_0_DOWN);
+	sFieldEditor.Key(KEY_0_DOWN);
+	sFieldEditor.Key(KEY_DIGIT('5'));
+	TEST_CHECK(sFieldEditor.GetValue() == 100);
+	sFieldEditor.Key(KEY_REPEAT_UP);
+	TEST_CHECK(sFieldEditor.GetValue() == 100);
+	sFieldEditor.Open(&integerField, 1, 0, "5");
+	sFieldEditor.Key(KEY_REPEAT_DOWN);
+	TEST_CHECK(sFieldEditor.GetValue() == 0);
+	// Open clamp stored value out of range
+	sFieldEditor.Open(&integerField, 1, 0, "150");
+	TEST_CHECK(sFieldEditor.GetValue() == 100);
+}
+
+/*******************************************************************************
+ * @fn      TestDateTime
+ * @brief   Date / time digit overwrite, held '8' / '0' step the digit it
+ * 			typed, Up / Down without digit step digit at cursor
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestDateTime(void)
+{
+	sFieldEditor.Open(&dateField, 1, 0, "2024-02-28");
+	TEST_CHECK(sFieldEditorPro.cursor == 2);
+	sFieldEditor.Key(KEY_8_UP);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "2084-02-28") == 0 && sFieldEditorPro.cursor == 3);
+	// Held '8' go back and step the typed digit, 8, 9, 0
+	sFieldEditor.Key(KEY_REPEAT_UP);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "2094-02-28") == 0 && sFieldEditorPro.cursor == 2);
+	sFieldEditor.Key(KEY_REPEAT_UP);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "2004-02-28") == 0 && sFieldEditorPro.cursor == 2);
+	sFieldEditor.Key(KEY_DIGIT('1'));
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "2014-02-28") == 0 && sFieldEditorPro.cursor == 3);
+	// Key not also Up / Down, Up step digit at cursor
+	sFieldEditor.Key(KEY_DIGIT('6'));
+	sFieldEditor.Key(KEY_REPEAT_UP);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "2016-12-28") == 0 && sFieldEditorPro.cursor == 5);
+	TEST_CHECK(sFieldEditor.Key(KEY_ENTER_ONLY) == FIELD_DONE);
+
+	// Held '0' step down and clamp hour
+	sFieldEditor.Open(&timeField, 1, 0, "12:34:56");
+	sFieldEditor.Key(KEY_0_DOWN);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "02:34:56") == 0 && sFieldEditorPro.cursor == 1);
+	sFieldEditor.Key(KEY_REPEAT_DOWN);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "23:34:56") == 0 && sFieldEditorPro.cursor == 0);
+	sFieldEditor.Key(KEY_REPEAT_DOWN);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "13:34:56") == 0 && sFieldEditorPro.cursor == 0);
+}
+
+/*******************************************************************************
+ * @fn      TestPredictive
+ * @brief   4x3 long press '1' toggle predictive text dropping its multi-tap
+ * 			character, '1' / Function C show next word, '0' accept with space
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestPredictive(void)
+{
+	sFieldEditor.Open(&textField, 1, 0, "");
+	sFieldEditor.Key(KEY_1_4X3);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "1") == 0 && !sFieldEditorPro.isPredictive);
+	sFieldEditor.LongKey(KEY_1_4X3);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "") == 0 && sFieldEditorPro.isPredictive);
+	// 4663 is home, good, gone, hood, hoof by frequency
+	sFieldEditor.Key(KEY_DIGIT('4'));
+	sFieldEditor.Key(KEY_DIGIT('6'));
+	sFieldEditor.Key(KEY_DIGIT('6'));
+	sFieldEditor.Key(KEY_DIGIT('3'));
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "home") == 0);
+	sFieldEditor.Key(KEY_1_4X3);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "good") == 0);
+	sFieldEditor.Key(KEY_FUNCTION_C_ONLY);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "gone") == 0);
+	// '0' is also Down, it accept the word and add space
+	sFieldEditor.Key(KEY_0_DOWN);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "gone ") == 0);
+	sFieldEditor.Key(KEY_DIGIT('8'));
+	sFieldEditor.Key(KEY_DIGIT('4'));
+	sFieldEditor.Key(KEY_DIGIT('3'));
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "gone the") == 0);
+	// Keypad send press before long press, next word of the press is undone
+	sFieldEditor.Key(KEY_1_4X3);
+	sFieldEditor.LongKey(KEY_1_4X3);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "gone the") == 0 && !sFieldEditorPro.isPredictive);
+	TEST_CHECK(sFieldEditor.Key(KEY_ENTER_ONLY) == FIELD_DONE);
+
+	// Same for a word which has a next word
+	sFieldEditor.Open(&textField, 1, 0, "");
+	sFieldEditor.Key(KEY_1_4X3);
+	sFieldEditor.LongKey(KEY_1_4X3);
+	sFieldEditor.Key(KEY_DIGIT('4'));
+	sFieldEditor.Key(KEY_DIGIT('6'));
+	sFieldEditor.Key(KEY_DIGIT('6'));
+	sFieldEditor.Key(KEY_DIGIT('3'));
+	sFieldEditor.Key(KEY_1_4X3);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "good") == 0);
+	sFieldEditor.LongKey(KEY_1_4X3);
+	TEST_CHECK(strcmp(sFieldEditor.GetText(), "home") == 0 && !sFieldEditorPro.isPredictive);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+int main(void)
+{
+	sFieldEditor.Initialize(NULL);
+	TestInteger();
+	TestDateTime();
+	TestPredictive();
+	return TEST_RESULT();
+}
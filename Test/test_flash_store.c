@@ -0,0 +1,797 @@
+/*******************************************************************************
+ * Filename:			test_flash_store.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Key value log on RAM backed flash pages, append,
+ * 						compaction, power cut in compaction and append, bad
+ * 						CRC record, flash error abort and retry, double word
+ * 						with bad ECC, boot load time and write amplification
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test.h"
+// Module under test, its local functions are reached directly
+#include "flash_store.c"
+#include <time.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// Flash operation count of no power cut / no error
+#define TEST_NEVER					0xFFFFFFFF
+#define TEST_WRITE_ROUND			2000
+#define TEST_REBOOT_EVERY			50
+// x86-64 EFLAGS trap flag, one instruction is run then SIGTRAP
+#define TEST_TRAP_FLAG				0x100
+
+/*******************************************************************************
+ * ENUMERATE
+ ******************************************************************************/
+typedef enum
+{
+	TEST_FLASH_NONE = 0,
+	TEST_FLASH_PROGRAM,
+	TEST_FLASH_ERASE,
+}
+eTEST_FLASH_OPERATION;
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Simulated flash controller, one operation at a time ended by interrupt
+typedef struct
+{
+	eTEST_FLASH_OPERATION eOperation;
+	uint8_t *address;
+	uint64_t data;
+	// Operation ended so far, ended operation count the power is cut at, the
+	// operation ended with error and erase refused at start
+	uint32_t endCount;
+	uint32_t cutAt;
+	uint32_t errorAt;
+	bool isEraseRefused;
+	// Double word programmed over not erased flash, address out of store
+	uint32_t overwriteCount;
+	uint32_t outOfRangeCount;
+	uint8_t *lastProgram;
+	// Double word cut by power loss, its read set ECCD and raise NMI
+	uint8_t *eccAddress;
+	uint32_t eccReadCount;
+}
+sTEST_FLASH;
+
+// Value the store should return of each key
+typedef struct
+{
+	uint8_t value[FLASH_STORE_KEY_COUNT][FLASH_STORE_MAX_LENGTH];
+	uint8_t length[FLASH_STORE_KEY_COUNT];
+}
+sTEST_VALUE;
+
+/*******************************************************************************
+ * LOCAL VARIBLES
+ ******************************************************************************/
+static sTEST_FLASH sTestFlash;
+static bool isFlushTimerRunning = false;
+static uint32_t randomState = 1;
+
+/*******************************************************************************
+ * STUB FUNCTIONS
+ ******************************************************************************/
+static uint8_t StubTimerInitialize(SOFTWARE_TIMER_CALLBACK softwareTimerStartCallback, SOFTWARE_TIMER_CALLBACK softwareTimerCallback, SOFTWARE_TIMER_CALLBACK softwareTimerStopCallback, eTIMER_TYPE eTimerType)
+{
+	return 0;
+}
+
+static void StubTimerStart(uint8_t softwareTimerId, uint32_t period)
+{
+	isFlushTimerRunning = true;
+}
+
+static void StubTimerStop(uint8_t softwareTimerId)
+{
+	isFlushTimerRunning = false;
+}
+
+sSOFTWARE_TIMER sSoftwareTimer =
+{
+	NULL,
+	NULL,
+	StubTimerInitialize,
+	StubTimerStart,
+	StubTimerStop,
+	NULL,
+};
+
+/*******************************************************************************
+ * @fn      HAL_FLASH_Program_IT
+ * @brief   Start program of a double word, it is written when the test end
+ * 			the operation. 32 bit address is mapped back into hostFlash.
+ ******************************************************************************/
+HAL_StatusTypeDef HAL_FLASH_Program_IT(uint32_t typeProgram, uint32_t address, uint64_t data)
+{
+	uint32_t offset = address - (uint32_t)(uintptr_t)hostFlash;
+	uint8_t i = 0;
+
+	if(offset > sizeof(hostFlash) - 8 || (offset % 8) != 0 || sTestFlash.eOperation != TEST_FLASH_NONE)
+	{
+		sTestFlash.outOfRangeCount++;
+		return HAL_ERROR;
+	}
+	for(i = 0; i < 8; i++)
+	{
+		sTestFlash.overwriteCount += (hostFlash[offset + i] != 0xFF) ? 1 : 0;
+	}
+	sTestFlash.eOperation = TEST_FLASH_PROGRAM;
+	sTestFlash.address = &hostFlash[offset];
+	sTestFlash.data = data;
+	return HAL_OK;
+}
+
+/*******************************************************************************
+ * @fn      HAL_FLASHEx_Erase_IT
+ * @brief   Start erase of a store page, it is erased when the test end the
+ * 			operation
+ ******************************************************************************/
+HAL_StatusTypeDef HAL_FLASHEx_Erase_IT(FLASH_EraseInitTypeDef *psEraseInit)
+{
+	uint32_t page = psEraseInit->Page - FLASH_STORE_FIRST_PAGE;
+
+	if(psEraseInit->Banks != FLASH_BANK_2 || psEraseInit->NbPages != 1 || page >= HOST_FLASH_PAGE_COUNT ||
+	   sTestFlash.eOperation != TEST_FLASH_NONE)
+	{
+		sTestFlash.outOfRangeCount++;
+		return HAL_ERROR;
+	}
+	if(sTestFlash.isEraseRefused)
+	{
+		sTestFlash.isEraseRefused = false;
+		return HAL_ERROR;
+	}
+	sTestFlash.eOperation = TEST_FLASH_ERASE;
+	sTestFlash.address = &hostFlash[page * FLASH_PAGE_SIZE];
+	return HAL_OK;
+}
+
+/*******************************************************************************
+ * @fn      TestNmi
+ * @brief   Same as NMI_Handler, ECCD left set would raise NMI again
+ ******************************************************************************/
+static void TestNmi(void)
+{
+	if(__HAL_FLASH_GET_FLAG(FLASH_FLAG_ECCD))
+	{
+		sFlashStore.EccError();
+	}
+}
+
+/*******************************************************************************
+ * @fn      TestFlashFault
+ * @brief   Trapped read of hostFlash, read of the bad ECC double word raise
+ * 			NMI. Read go on after one instruction is run with flash
+ * 			readable.
+ ******************************************************************************/
+static void TestFlashFault(int signalNumber, siginfo_t *psInfo, void *context)
+{
+	ucontext_t *psContext = context;
+	uint8_t *address = psInfo->si_addr;
+
+	if(address + 8 > sTestFlash.eccAddress && address < sTestFlash.eccAddress + 8)
+	{
+		FLASH->ECCR |= FLASH_FLAG_ECCD;
+		sTestFlash.eccReadCount++;
+		TestNmi();
+	}
+	mprotect(hostFlash, sizeof(hostFlash), PROT_READ | PROT_WRITE);
+	psContext->uc_mcontext.gregs[REG_EFL] |= TEST_TRAP_FLAG;
+}
+
+/*******************************************************************************
+ * @fn      TestFlashStep
+ * @brief   Trapped read is done, trap next read
+ ******************************************************************************/
+static void TestFlashStep(int signalNumber, siginfo_t *psInfo, void *context)
+{
+	ucontext_t *psContext = context;
+
+	mprotect(hostFlash, sizeof(hostFlash), PROT_NONE);
+	psContext->uc_mcontext.gregs[REG_EFL] &= ~TEST_TRAP_FLAG;
+}
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+/*******************************************************************************
+ * @fn      TestEvent
+ * @brief   Event callback, test run Process itself
+ ******************************************************************************/
+static void TestEvent(uint8_t softwareTimerId)
+{
+}
+
+/*******************************************************************************
+ * @fn      TestHostCycle
+ * @brief   Host time in CPU clock cycles, load time print in real us
+ ******************************************************************************/
+static uint32_t TestHostCycle(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint32_t)(((uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec) * (SystemCoreClock / 1000000) / 1000);
+}
+
+/*******************************************************************************
+ * @fn      TestRandom
+ * @brief   Same sequence every run
+ ******************************************************************************/
+static uint32_t TestRandom(uint32_t range)
+{
+	randomState = randomState * 1103515245 + 12345;
+	return (randomState >> 16) % range;
+}
+
+/*******************************************************************************
+ * @fn      TestErase
+ * @brief   Blank flash and simulated controller
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestErase(void)
+{
+	memset(hostFlash, 0xFF, sizeof(hostFlash));
+	memset(&sTestFlash, 0, sizeof(sTestFlash));
+	sTestFlash.cutAt = TEST_NEVER;
+	sTestFlash.errorAt = TEST_NEVER;
+}
+
+/*******************************************************************************
+ * @fn      TestReboot
+ * @brief   Power up, operation in progress is lost
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestReboot(void)
+{
+	sTestFlash.eOperation = TEST_FLASH_NONE;
+	isFlushTimerRunning = false;
+	// Boot read of flash is trapped while a double word has bad ECC
+	if(sTestFlash.eccAddress != NULL)
+	{
+		mprotect(hostFlash, sizeof(hostFlash), PROT_NONE);
+	}
+	sFlashStore.Initialize(TestEvent);
+	mprotect(hostFlash, sizeof(hostFlash), PROT_READ | PROT_WRITE);
+}
+
+/*******************************************************************************
+ * @fn      TestTear
+ * @brief   Power was cut in the middle of the program, half the double word
+ * 			is written and its ECC is bad
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestTear(void)
+{
+	memcpy(sTestFlash.address, &sTestFlash.data, 4);
+	sTestFlash.eccAddress = sTestFlash.address;
+}
+
+/*******************************************************************************
+ * @fn      TestFlush
+ * @brief   Flush delay expire, Process run and every flash operation end by
+ * 			interrupt until store is idle or power is cut
+ * @paramz  None
+ * @return  False if power was cut
+ ******************************************************************************/
+static bool TestFlush(void)
+{
+	uint8_t *address;
+
+	if(isFlushTimerRunning)
+	{
+		isFlushTimerRunning = false;
+		FlashStoreTimerCallback(sFlashStorePro.flushTimerId);
+	}
+	sFlashStore.Process();
+	while(sTestFlash.eOperation != TEST_FLASH_NONE)
+	{
+		if(sTestFlash.endCount == sTestFlash.cutAt)
+		{
+			return false;
+		}
+		address = sTestFlash.address;
+		if(sTestFlash.endCount == sTestFlash.errorAt)
+		{
+			sTestFlash.eOperation = TEST_FLASH_NONE;
+			sTestFlash.endCount++;
+			sFlashStore.OperationEnd(true);
+		}
+		else if(sTestFlash.eOperation == TEST_FLASH_ERASE)
+		{
+			memset(address, 0xFF, FLASH_PAGE_SIZE);
+			if(sTestFlash.eccAddress >= address && sTestFlash.eccAddress < address + FLASH_PAGE_SIZE)
+			{
+				sTestFlash.eccAddress = NULL;
+			}
+			sTestFlash.eOperation = TEST_FLASH_NONE;
+			sTestFlash.endCount++;
+			sFlashStore.OperationEnd(false);
+		}
+		else
+		{
+			memcpy(address, &sTestFlash.data, 8);
+			sTestFlash.lastProgram = address;
+			sTestFlash.eOperation = TEST_FLASH_NONE;
+			sTestFlash.endCount++;
+			sFlashStore.OperationEnd(false);
+		}
+		sFlashStore.Process();
+	}
+	return true;
+}
+
+/*******************************************************************************
+ * @fn      TestWrite
+ * @brief   Write key and keep the expected value
+ * @paramz  psValue
+ * 			key
+ * 			data
+ * 			length
+ * @return  None
+ ******************************************************************************/
+static void TestWrite(sTEST_VALUE *psValue, uint8_t key, const void *data, uint8_t length)
+{
+	sFlashStore.Write(key, data, length);
+	memcpy(psValue->value[key], data, length);
+	psValue->length[key] = length;
+}
+
+/*******************************************************************************
+ * @fn      TestSame
+ * @brief   Every key read the expected value
+ * @paramz  psValue
+ * @return  True if all same
+ ******************************************************************************/
+static bool TestSame(const sTEST_VALUE *psValue)
+{
+	uint8_t data[FLASH_STORE_MAX_LENGTH];
+	uint8_t key = 0;
+
+	for(key = 0; key < FLASH_STORE_KEY_COUNT; key++)
+	{
+		if(sFlashStore.Read(key, data, sizeof(data)) != psValue->length[key] ||
+		   memcmp(data, psValue->value[key], psValue->length[key]) != 0)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/*******************************************************************************
+ * @fn      TestFillPage
+ * @brief   Append to active page until the next flush of key 0 compact
+ * @paramz  psValue
+ * @return  None
+ ******************************************************************************/
+static void TestFillPage(sTEST_VALUE *psValue)
+{
+	uint8_t data[4];
+	uint32_t count = 0;
+
+	// Blank flash is formatted by first flush
+	do
+	{
+		memcpy(data, &count, sizeof(data));
+		TestWrite(psValue, 1 + (count % (FLASH_STORE_KEY_COUNT - 1)), data, sizeof(data));
+		TestFlush();
+		count++;
+	}
+	while(sFlashStorePro.writeOffset + FLASH_STORE_RECORD_SIZE(sizeof(data)) <= FLASH_PAGE_SIZE);
+}
+
+/*******************************************************************************
+ * @fn      TestBlank
+ * @brief   Blank flash read nothing, first flush format the other page with
+ * 			page header programmed last
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestBlank(void)
+{
+	sTEST_VALUE sValue = {0};
+	uint8_t data[FLASH_STORE_MAX_LENGTH];
+	const uint32_t *header = (const uint32_t*)&hostFlash[FLASH_PAGE_SIZE];
+
+	TestErase();
+	TestReboot();
+	TEST_CHECK(sFlashStore.Read(0, data, sizeof(data)) == 0);
+	TEST_CHECK(sFlashStorePro.writeOffset == FLASH_PAGE_SIZE);
+	TestWrite(&sValue, 0, "hello", 5);
+	TestWrite(&sValue, 3, "01234567890123456789", 20);
+	// Still in RAM until flush delay
+	TEST_CHECK(sTestFlash.endCount == 0 && TestSame(&sValue));
+	TEST_CHECK(TestFlush());
+	TEST_CHECK(sFlashStorePro.activePage == 1 && sFlashStorePro.sequence == 1);
+	TEST_CHECK(header[0] == FLASH_STORE_MAGIC && header[1] == 1);
+	TEST_CHECK(sTestFlash.lastProgram == &hostFlash[FLASH_PAGE_SIZE]);
+	// Erase, record of 5 byte (2 double word), of 20 byte (3), page header
+	TEST_CHECK(sTestFlash.endCount == 1 + 2 + 3 + 1);
+	TestReboot();
+	TEST_CHECK(TestSame(&sValue));
+	// Same value is not programmed again
+	TestWrite(&sValue, 0, "hello", 5);
+	TEST_CHECK(!isFlushTimerRunning && sFlashStorePro.dirtyKeys == 0);
+}
+
+/*******************************************************************************
+ * @fn      TestAppendCompaction
+ * @brief   Random key and length written many time with reboot between,
+ * 			every value survive append and compaction
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestAppendCompaction(void)
+{
+	sTEST_VALUE sValue = {0};
+	uint8_t data[FLASH_STORE_MAX_LENGTH];
+	uint32_t round = 0;
+	uint32_t sameCount = 0;
+	uint32_t rebootCount = 0;
+	uint16_t compactionCount = 0;
+	uint8_t length;
+	uint8_t i = 0;
+
+	TestErase();
+	TestReboot();
+	for(round = 0; round < TEST_WRITE_ROUND; round++)
+	{
+		length = 1 + TestRandom(FLASH_STORE_MAX_LENGTH);
+		for(i = 0; i < length; i++)
+		{
+			data[i] = TestRandom(256);
+		}
+		TestWrite(&sValue, TestRandom(FLASH_STORE_KEY_COUNT), data, length);
+		TestFlush();
+		if((round % TEST_REBOOT_EVERY) == TEST_REBOOT_EVERY - 1)
+		{
+			compactionCount += sFlashStorePro.sStatistic.compactionCount;
+			TestReboot();
+			sameCount += TestSame(&sValue) ? 1 : 0;
+			rebootCount++;
+		}
+	}
+	TEST_CHECK(sameCount == rebootCount);
+	TEST_CHECK(compactionCount > 10);
+	TEST_CHECK(sTestFlash.overwriteCount == 0 && sTestFlash.outOfRangeCount == 0);
+	TEST_CHECK(sFlashStorePro.sStatistic.errorCount == 0);
+	printf("Append / compaction: %u write, %u reboot, %u compaction\n", TEST_WRITE_ROUND, rebootCount, compactionCount);
+}
+
+/*******************************************************************************
+ * @fn      TestCutCompaction
+ * @brief   Power cut after every operation of a compaction, old page stay
+ * 			active with the flushed values until new page header is
+ * 			programmed
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestCutCompaction(void)
+{
+	static uint8_t snapshot[sizeof(hostFlash)];
+	sTEST_VALUE sValue = {0};
+	sTEST_VALUE sNewValue;
+	uint32_t operationCount = 0;
+	uint32_t cut = 0;
+	uint32_t oldCount = 0;
+	uint32_t sequence;
+	uint8_t activePage;
+
+	TestErase();
+	TestReboot();
+	TestFillPage(&sValue);
+	memcpy(snapshot, hostFlash, sizeof(hostFlash));
+	activePage = sFlashStorePro.activePage;
+	sequence = sFlashStorePro.sequence;
+	// Full compaction, operation count of no cut
+	sNewValue = sValue;
+	TestWrite(&sNewValue, 0, "compact", 7);
+	sTestFlash.endCount = 0;
+	TEST_CHECK(TestFlush() && sFlashStorePro.sequence == sequence + 1);
+	operationCount = sTestFlash.endCount;
+	for(cut = 0; cut < operationCount; cut++)
+	{
+		memcpy(hostFlash, snapshot, sizeof(hostFlash));
+		TestReboot();
+		TestWrite(&sNewValue, 0, "compact", 7);
+		sTestFlash.endCount = 0;
+		sTestFlash.cutAt = cut;
+		TEST_CHECK(!TestFlush());
+		sTestFlash.cutAt = TEST_NEVER;
+		TestReboot();
+		oldCount += (sFlashStorePro.activePage == activePage && sFlashStorePro.sequence == sequence && TestSame(&sValue)) ? 1 : 0;
+		// Next flush erase the half programmed page and compact again
+		TestWrite(&sNewValue, 0, "compact", 7);
+		TEST_CHECK(TestFlush());
+		TestReboot();
+		TEST_CHECK(TestSame(&sNewValue));
+	}
+	TEST_CHECK(oldCount == operationCount);
+	TEST_CHECK(sTestFlash.overwriteCount == 0 && sTestFlash.outOfRangeCount == 0);
+	printf("Compaction power cut: old page kept at all %u cut point\n", operationCount);
+}
+
+/*******************************************************************************
+ * @fn      TestBadCrc
+ * @brief   Corrupted record and record cut by power loss are skipped, older
+ * 			record of the key is read, log go on after them
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestBadCrc(void)
+{
+	sTEST_VALUE sValue = {0};
+	sTEST_VALUE sOldValue;
+	uint16_t offset;
+
+	TestErase();
+	TestReboot();
+	TestWrite(&sValue, 2, "first", 5);
+	TestFlush();
+	sOldValue = sValue;
+	TestWrite(&sValue, 2, "second", 6);
+	TestFlush();
+	offset = sFlashStorePro.index[2];
+	// Bit of value cleared
+	hostFlash[(sFlashStorePro.activePage * FLASH_PAGE_SIZE) + offset + FLASH_STORE_RECORD_HEADER] &= 0xFE;
+	TestReboot();
+	TEST_CHECK(TestSame(&sOldValue));
+	TEST_CHECK(sFlashStorePro.index[2] != 0 && sFlashStorePro.index[2] < offset);
+	TEST_CHECK(sFlashStorePro.writeOffset == offset + FLASH_STORE_RECORD_SIZE(6));
+
+	// Power cut after first double word of a 3 double word record
+	sValue = sOldValue;
+	TestWrite(&sValue, 5, "01234567890123456789", 20);
+	sTestFlash.endCount = 0;
+	sTestFlash.cutAt = 1;
+	TEST_CHECK(!TestFlush());
+	sTestFlash.cutAt = TEST_NEVER;
+	TestReboot();
+	TEST_CHECK(TestSame(&sOldValue));
+	// Record after the broken one is found
+	TestWrite(&sValue, 5, "01234567890123456789", 20);
+	TestFlush();
+	TestWrite(&sValue, 6, "after", 5);
+	TestFlush();
+	TestReboot();
+	TEST_CHECK(TestSame(&sValue));
+	TEST_CHECK(sFlashStorePro.sStatistic.compactionCount == 0);
+	TEST_CHECK(sTestFlash.overwriteCount == 0);
+}
+
+/*******************************************************************************
+ * @fn      TestAbortRetry
+ * @brief   Program error, erase refused and erase error keep value dirty, it
+ * 			is flushed by compaction after next flush delay
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestAbortRetry(void)
+{
+	static uint8_t snapshot[sizeof(hostFlash)];
+	sTEST_VALUE sValue = {0};
+	sTEST_VALUE sOldValue;
+	uint8_t activePage;
+
+	TestErase();
+	TestReboot();
+	TestWrite(&sValue, 1, "one", 3);
+	TestWrite(&sValue, 4, "four", 4);
+	TestFlush();
+	sOldValue = sValue;
+	activePage = sFlashStorePro.activePage;
+
+	// Append error on second double word
+	TestWrite(&sValue, 7, "01234567890123456789", 20);
+	sTestFlash.endCount = 0;
+	sTestFlash.errorAt = 1;
+	TestFlush();
+	sTestFlash.errorAt = TEST_NEVER;
+	TEST_CHECK(sFlashStore.IsIdle() && sFlashStorePro.sStatistic.errorCount == 1);
+	TEST_CHECK(sFlashStorePro.dirtyKeys == (0x01 << 7) && isFlushTimerRunning);
+	TEST_CHECK(sFlashStorePro.writeOffset == FLASH_PAGE_SIZE);
+	TEST_CHECK(TestSame(&sValue));
+	// Retry compact to the other page
+	TEST_CHECK(TestFlush() && sFlashStorePro.activePage != activePage);
+	TestReboot();
+	TEST_CHECK(TestSame(&sValue));
+
+	// Erase refused at start, erase error, program error in compaction
+	TestFillPage(&sValue);
+	memcpy(snapshot, hostFlash, sizeof(hostFlash));
+	sOldValue = sValue;
+	activePage = sFlashStorePro.activePage;
+	TestWrite(&sValue, 0, "retry", 5);
+	sTestFlash.isEraseRefused = true;
+	TestFlush();
+	TEST_CHECK(sFlashStorePro.sStatistic.errorCount == 1 && sFlashStorePro.dirtyKeys == 0x01 && isFlushTimerRunning);
+	sTestFlash.endCount = 0;
+	sTestFlash.errorAt = 0;
+	TestFlush();
+	TEST_CHECK(sFlashStorePro.sStatistic.errorCount == 2 && sFlashStorePro.dirtyKeys == 0x01);
+	sTestFlash.endCount = 0;
+	sTestFlash.errorAt = 3;
+	TestFlush();
+	sTestFlash.errorAt = TEST_NEVER;
+	TEST_CHECK(sFlashStorePro.sStatistic.errorCount == 3 && sFlashStorePro.activePage == activePage);
+	TEST_CHECK(memcmp(&hostFlash[activePage * FLASH_PAGE_SIZE], &snapshot[activePage * FLASH_PAGE_SIZE], FLASH_PAGE_SIZE) == 0);
+	TEST_CHECK(TestSame(&sValue));
+	// Power lost before retry, flushed value kept
+	TestReboot();
+	TEST_CHECK(TestSame(&sOldValue));
+	TestWrite(&sValue, 0, "retry", 5);
+	TEST_CHECK(TestFlush() && sFlashStorePro.activePage != activePage);
+	TestReboot();
+	TEST_CHECK(TestSame(&sValue));
+	TEST_CHECK(sTestFlash.overwriteCount == 0 && sTestFlash.outOfRangeCount == 0);
+}
+
+/*******************************************************************************
+ * @fn      TestEcc
+ * @brief   Record and page header cut in a double word program, its read
+ * 			raise NMI. ECCD is cleared, boot go on with the older value and
+ * 			next flush compact away from the bad double word.
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestEcc(void)
+{
+	static uint8_t snapshot[sizeof(hostFlash)];
+	sTEST_VALUE sValue = {0};
+	sTEST_VALUE sOldValue;
+	uint32_t operationCount;
+	uint8_t activePage;
+
+	TestErase();
+	TestReboot();
+	TestWrite(&sValue, 2, "first", 5);
+	TestFlush();
+	sOldValue = sValue;
+	activePage = sFlashStorePro.activePage;
+
+	// Power cut in second double word of a 3 double word record
+	TestWrite(&sValue, 5, "01234567890123456789", 20);
+	sTestFlash.endCount = 0;
+	sTestFlash.cutAt = 1;
+	TEST_CHECK(!TestFlush());
+	sTestFlash.cutAt = TEST_NEVER;
+	TestTear();
+	TestReboot();
+	TEST_CHECK(sTestFlash.eccReadCount > 0 && !__HAL_FLASH_GET_FLAG(FLASH_FLAG_ECCD));
+	TEST_CHECK(sFlashStorePro.writeOffset == FLASH_PAGE_SIZE && sFlashStorePro.sStatistic.errorCount > 0);
+	TEST_CHECK(TestSame(&sOldValue));
+	// Compacted to the other page, bad double word is not read again
+	TestWrite(&sValue, 5, "01234567890123456789", 20);
+	TEST_CHECK(TestFlush() && sFlashStorePro.activePage != activePage);
+	sTestFlash.eccReadCount = 0;
+	TestReboot();
+	TEST_CHECK(sTestFlash.eccReadCount == 0 && TestSame(&sValue));
+
+	// Power cut in page header, last double word of compaction
+	TestErase();
+	TestReboot();
+	TestFillPage(&sValue);
+	memcpy(snapshot, hostFlash, sizeof(hostFlash));
+	sOldValue = sValue;
+	activePage = sFlashStorePro.activePage;
+	TestWrite(&sValue, 0, "compact", 7);
+	sTestFlash.endCount = 0;
+	TEST_CHECK(TestFlush());
+	operationCount = sTestFlash.endCount;
+	memcpy(hostFlash, snapshot, sizeof(hostFlash));
+	TestReboot();
+	TestWrite(&sValue, 0, "compact", 7);
+	sTestFlash.endCount = 0;
+	sTestFlash.cutAt = operationCount - 1;
+	TEST_CHECK(!TestFlush());
+	sTestFlash.cutAt = TEST_NEVER;
+	TEST_CHECK(sTestFlash.address == &hostFlash[(1 - activePage) * FLASH_PAGE_SIZE]);
+	TestTear();
+	TestReboot();
+	TEST_CHECK(sTestFlash.eccReadCount > 0 && !__HAL_FLASH_GET_FLAG(FLASH_FLAG_ECCD));
+	TEST_CHECK(sFlashStorePro.activePage == activePage && TestSame(&sOldValue));
+	// Erase of the page clear the bad double word
+	TestWrite(&sValue, 0, "compact", 7);
+	TEST_CHECK(TestFlush() && sTestFlash.eccAddress == NULL);
+	TestReboot();
+	TEST_CHECK(sFlashStorePro.activePage != activePage && TestSame(&sValue));
+	TEST_CHECK(sTestFlash.overwriteCount == 0 && sTestFlash.outOfRangeCount == 0);
+}
+
+/*******************************************************************************
+ * @fn      TestStatistic
+ * @brief   Boot load time of a full page of smallest record, write
+ * 			amplification of 4 byte setting and of 20 byte string
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestStatistic(void)
+{
+	sTEST_VALUE sValue = {0};
+	sFLASH_STORE_STATISTIC sStatistic;
+	uint8_t data[FLASH_STORE_MAX_LENGTH];
+	uint32_t round = 0;
+	uint32_t amplification;
+	uint32_t bestCycles = TEST_NEVER;
+	uint8_t length;
+
+	// Full page of 1 byte value, slowest boot scan
+	hostCycleCounter = TestHostCycle;
+	TestErase();
+	TestReboot();
+	do
+	{
+		data[0] = round;
+		TestWrite(&sValue, round % FLASH_STORE_KEY_COUNT, data, 1);
+		TestFlush();
+		round++;
+	}
+	while(sFlashStorePro.writeOffset + FLASH_STORE_RECORD_SIZE(1) <= FLASH_PAGE_SIZE);
+	for(round = 0; round < 20; round++)
+	{
+		TestReboot();
+		bestCycles = (sFlashStorePro.sStatistic.loadCycles < bestCycles) ? sFlashStorePro.sStatistic.loadCycles : bestCycles;
+	}
+	TEST_CHECK(sFlashStorePro.writeOffset == FLASH_PAGE_SIZE && TestSame(&sValue));
+	printf("Boot load of full page, %u record: %u us host\n", (FLASH_PAGE_SIZE - FLASH_STORE_HEADER_SIZE) / FLASH_STORE_RECORD_SIZE(1),
+			bestCycles / (SystemCoreClock / 1000000));
+
+	for(length = 4; length <= FLASH_STORE_MAX_LENGTH; length += FLASH_STORE_MAX_LENGTH - 4)
+	{
+		TestErase();
+		TestReboot();
+		for(round = 0; round < TEST_WRITE_ROUND; round++)
+		{
+			memcpy(data, &round, sizeof(round));
+			memset(&data[sizeof(round)], round, sizeof(data) - sizeof(round));
+			TestWrite(&sValue, TestRandom(FLASH_STORE_KEY_COUNT), data, length);
+			TestFlush();
+		}
+		sFlashStore.GetStatistic(&sStatistic);
+		amplification = (sStatistic.programBytes * 100) / sStatistic.valueBytes;
+		printf("%u byte value, ", length);
+		sFlashStore.Print();
+		// Record size over value size, compaction copy add the rest
+		TEST_CHECK(amplification >= (FLASH_STORE_RECORD_SIZE(length) * 100) / length);
+		TEST_CHECK(amplification < (FLASH_STORE_RECORD_SIZE(length) * 200) / length);
+	}
+	hostCycleCounter = NULL;
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+int main(void)
+{
+	struct sigaction sAction = {0};
+
+	sAction.sa_flags = SA_SIGINFO;
+	sAction.sa_sigaction = TestFlashFault;
+	sigaction(SIGSEGV, &sAction, NULL);
+	sAction.sa_sigaction = TestFlashStep;
+	sigaction(SIGTRAP, &sAction, NULL);
+	TestBlank();
+	TestAppendCompaction();
+	TestCutCompaction();
+	TestBadCrc();
+	TestAbortRetry();
+	TestEcc();
+	TestStatistic();
+	return TEST_RESULT();
+}
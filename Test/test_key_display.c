@@ -0,0 +1,388 @@
+/*******************************************************************************
+ * Filename:			test_key_display.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Host simulation of key edge to last LCD byte latency,
+ * 						real main loop, matrix button, menu and LCD driver
+ * 						on a simulated 80MHz clock. Bounce, SysTick, LCD
+ * 						timer and LCD busy time are simulated, CPU time of
+ * 						the code is not, it is measured on device.
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test.h"
+// Module under test, event jump table and key handler are reached directly
+#include "main_loop.c"
+#include "menu_tree.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+#define SIMULATE_CYCLE_PER_MS		80000
+// HD44780 instruction and data write execution time
+#define SIMULATE_LCD_BUSY_CYCLES	(37 * 80)
+// LCD timer tick is 100ns
+#define SIMULATE_LCD_TIMER_CYCLES	8
+// Contact bounce after press and release edge (us)
+#define SIMULATE_BOUNCE_PERIOD		300
+#define SIMULATE_BOUNCE_COUNT		4
+#define SIMULATE_HOLD_PERIOD		120
+#define SIMULATE_GAP_PERIOD			300
+#define SIMULATE_ROUND				25
+#define SIMULATE_START_TIME			1735689600
+// Down and Exit on the top screen of a round change nothing, not measured
+#define SIMULATE_NO_CHANGE_KEY		2
+
+// Front keypad key of 4x4 layout
+#define KEY_1						0
+#define KEY_2						1
+#define KEY_3						2
+#define KEY_4						4
+#define KEY_5						5
+#define KEY_6						6
+#define KEY_8_UP					9
+#define KEY_EXIT					12
+#define KEY_0_DOWN					13
+#define KEY_ENTER					14
+
+/*******************************************************************************
+ * ENUMERATE
+ ******************************************************************************/
+// Menu ID, same expansion as menu list
+typedef enum
+{
+#define MENU_ID(id, parent, child, previous, next, title, action, type, hidden, maxLength, value)	id,
+	MENU_TREE(MENU_ID)
+#undef MENU_ID
+}
+eMENU_ID;
+
+/*******************************************************************************
+ * LOCAL VARIBLES
+ ******************************************************************************/
+static uint64_t simulateCycle = 0;
+static uint64_t nextTickCycle = SIMULATE_CYCLE_PER_MS;
+static uint32_t nextSecondTick = 1000;
+static uint16_t heldKey = 0;
+static bool isLcdTimerRunning = false;
+// Key press of one round, log in, walk setting and report menus, log out
+static const uint8_t scenario[] =
+{
+	KEY_ENTER, KEY_1, KEY_2, KEY_3, KEY_4, KEY_5, KEY_6, KEY_ENTER,
+	KEY_0_DOWN, KEY_0_DOWN, KEY_ENTER, KEY_0_DOWN, KEY_8_UP, KEY_EXIT,
+	KEY_8_UP, KEY_ENTER, KEY_0_DOWN, KEY_0_DOWN, KEY_EXIT, KEY_EXIT,
+	KEY_0_DOWN, KEY_ENTER, KEY_ENTER, KEY_0_DOWN, KEY_EXIT, KEY_EXIT, KEY_EXIT,
+};
+
+/*******************************************************************************
+ * STUB FUNCTIONS
+ ******************************************************************************/
+RTC_HandleTypeDef hrtc;
+TIM_HandleTypeDef htim7;
+
+void Error_Handler(void)
+{
+	printf("Error_Handler called\n");
+	exit(1);
+}
+
+void RtcGetDateTime(RTC_DateTypeDef *sDate, RTC_TimeTypeDef *sTime)
+{
+	time_t unixTime;
+	struct tm *psTime;
+
+	RTCGetUnixTime(&unixTime);
+	psTime = gmtime(&unixTime);
+	sDate->Year = psTime->tm_year - 100;
+	sDate->Month = psTime->tm_mon + 1;
+	sDate->Date = psTime->tm_mday;
+	sDate->WeekDay = (psTime->tm_wday == 0) ? RTC_WEEKDAY_SUNDAY : psTime->tm_wday;
+	sTime->Hours = psTime->tm_hour;
+	sTime->Minutes = psTime->tm_min;
+	sTime->Seconds = psTime->tm_sec;
+}
+
+void RtcSetDateTime(RTC_DateTypeDef *sDate, RTC_TimeTypeDef *sTime)
+{
+}
+
+void RTCGetUnixTime(time_t *unixTime)
+{
+	*unixTime = SIMULATE_START_TIME + (simulateCycle / (SIMULATE_CYCLE_PER_MS * 1000));
+}
+
+HAL_StatusTypeDef HAL_RTCEx_SetWakeUpTimer_IT(RTC_HandleTypeDef *hrtc, uint32_t counter, uint32_t clock)
+{
+	return HAL_OK;
+}
+
+/*******************************************************************************
+ * @fn      HAL_TIM_Base_Start_IT
+ * @brief   LCD timer, interrupt every 100ns until the driver stop it
+ * @paramz  htim
+ * @return  HAL_OK
+ ******************************************************************************/
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+	isLcdTimerRunning = true;
+	while(isLcdTimerRunning)
+	{
+		simulateCycle += SIMULATE_LCD_TIMER_CYCLES;
+		LcdTimerInterruptCallback();
+	}
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim)
+{
+	isLcdTimerRunning = false;
+	return HAL_OK;
+}
+
+// Setting are never stored, menu show default value
+static void StubFlashStoreInitialize(SOFTWARE_TIMER_CALLBACK eventCallback) {}
+static uint8_t StubFlashStoreRead(uint8_t key, void *data, uint8_t size) { return 0; }
+static void StubFlashStoreWrite(uint8_t key, const void *data, uint8_t length) {}
+static void StubFlashStoreProcess(void) {}
+static void StubFlashStoreOperationEnd(bool isError) {}
+static bool StubIsIdle(void) { return true; }
+static void StubFlashStoreGetStatistic(sFLASH_STORE_STATISTIC *psFlashStoreStatistic) { memset(psFlashStoreStatistic, 0, sizeof(*psFlashStoreStatistic)); }
+static void StubPrint(void) {}
+static void StubFlashStoreEccError(void) {}
+sFLASH_STORE sFlashStore =
+{
+	StubFlashStoreInitialize,
+	StubFlashStoreRead,
+	StubFlashStoreWrite,
+	StubFlashStoreProcess,
+	StubFlashStoreOperationEnd,
+	StubIsIdle,
+	StubFlashStoreEccError,
+	StubFlashStoreGetStatistic,
+	StubPrint,
+};
+
+static void StubTemperatureSensorInitialize(SOFTWARE_TIMER_CALLBACK eventCallback) {}
+static void StubTemperatureSensorStart(void) {}
+static int16_t StubTemperatureSensorGet(void) { return 250; }
+static void StubTemperatureSensorGetStatistic(sTEMPERATURE_SENSOR_STATISTIC *psTemperatureSensorStatistic) { memset(psTemperatureSensorStatistic, 0, sizeof(*psTemperatureSensorStatistic)); }
+sTEMPERATURE_SENSOR sTemperatureSensor =
+{
+	StubTemperatureSensorInitialize,
+	StubTemperatureSensorStart,
+	StubTemperatureSensorGet,
+	StubIsIdle,
+	StubTemperatureSensorGetStatistic,
+	StubPrint,
+};
+
+static void StubPowerManagerInitialize(void) {}
+static void StubPowerManagerIdle(volatile uint32_t *eventFlags) {}
+static void StubPowerManagerEventDispatched(void) {}
+static void StubPowerManagerGetStatistic(sPOWER_STATISTIC *psPowerStatistic) { memset(psPowerStatistic, 0, sizeof(*psPowerStatistic)); }
+sPOWER_MANAGER sPowerManager =
+{
+	StubPowerManagerInitialize,
+	StubPowerManagerIdle,
+	StubPowerManagerEventDispatched,
+	StubPowerManagerGetStatistic,
+	StubPrint,
+};
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+/*******************************************************************************
+ * @fn      SimulateCycleCounter
+ * @brief   DWT cycle counter of simulated clock
+ * @paramz  None
+ * @return  Cycle
+ ******************************************************************************/
+static uint32_t SimulateCycleCounter(void)
+{
+	return (uint32_t)simulateCycle;
+}
+
+/*******************************************************************************
+ * @fn      SimulateReadPin
+ * @brief   Keypad row is low when a held key connect it to a column driven
+ * 			low, LCD busy flag clear after the execution time of a write
+ * @paramz  gpio
+ * 			pin
+ * @return  Pin state
+ ******************************************************************************/
+static GPIO_PinState SimulateReadPin(GPIO_TypeDef *gpio, uint16_t pin)
+{
+	uint8_t row = 0;
+	uint8_t column = 0;
+	const sMATRIX_BUTTON_PIN *psColumnPin;
+
+	if(gpio == LCD_DB7_GPIO_Port && pin == LCD_DB7_Pin)
+	{
+		simulateCycle += SIMULATE_LCD_BUSY_CYCLES;
+		return GPIO_PIN_RESET;
+	}
+	for(row = 0; row < NUM_OF_MATRIX_BUTTON_ROW; row++)
+	{
+		if(frontKeypadConfig.sRowPin[row].gpio != gpio || frontKeypadConfig.sRowPin[row].pin != pin)
+		{
+			continue;
+		}
+		for(column = 0; column < NUM_OF_MATRIX_BUTTON_COLUMN; column++)
+		{
+			psColumnPin = &frontKeypadConfig.sColumnPin[column];
+			if((heldKey & (0x01 << ((NUM_OF_MATRIX_BUTTON_COLUMN * row) + column))) && (psColumnPin->gpio->ODR & psColumnPin->pin) == 0)
+			{
+				return GPIO_PIN_RESET;
+			}
+		}
+	}
+	return GPIO_PIN_SET;
+}
+
+/*******************************************************************************
+ * @fn      SimulateUntil
+ * @brief   Run SysTick, RTC and the main loop body until the cycle, main
+ * 			loop sleep until next tick when it is idle
+ * @paramz  endCycle
+ * @return  None
+ ******************************************************************************/
+static void SimulateUntil(uint64_t endCycle)
+{
+	while(simulateCycle < endCycle)
+	{
+		while(simulateCycle >= nextTickCycle)
+		{
+			nextTickCycle += SIMULATE_CYCLE_PER_MS;
+			hostTick++;
+			SoftwareTimerInterruptCallback();
+			if(hostTick == nextSecondTick)
+			{
+				nextSecondTick += 1000;
+				HAL_RTCEx_WakeUpTimerEventCallback(&hrtc);
+			}
+		}
+		// Same as MainLoop
+		if(eventFlags != 0)
+		{
+			DispatchEventFlags();
+		}
+		if(!sCoroutine.Schedule() && eventFlags == 0)
+		{
+			sDiagnostic.DisplayEnd(sMenuList.GetScreen());
+			simulateCycle = (nextTickCycle < endCycle) ? nextTickCycle : endCycle;
+		}
+	}
+}
+
+/*******************************************************************************
+ * @fn      SimulateEdge
+ * @brief   Key contact change with bounce, every edge raise row EXTI
+ * @paramz  key
+ * 			isPressed	Final contact state
+ * @return  None
+ ******************************************************************************/
+static void SimulateEdge(uint8_t key, bool isPressed)
+{
+	uint8_t i = 0;
+	uint16_t rowPin = frontKeypadConfig.sRowPin[key / NUM_OF_MATRIX_BUTTON_COLUMN].pin;
+
+	for(i = 0; i <= SIMULATE_BOUNCE_COUNT; i++)
+	{
+		// Contact toggle, ending at the final state
+		if(((SIMULATE_BOUNCE_COUNT - i) & 0x01) == 0)
+		{
+			heldKey = isPressed ? (heldKey | (0x01 << key)) : (heldKey & ~(0x01 << key));
+		}
+		else
+		{
+			heldKey = isPressed ? (heldKey & ~(0x01 << key)) : (heldKey | (0x01 << key));
+		}
+		// Row EXTI fire on falling edge only
+		if(heldKey & (0x01 << key))
+		{
+			HAL_GPIO_EXTI_Callback(rowPin);
+		}
+		SimulateUntil(simulateCycle + (SIMULATE_BOUNCE_PERIOD * SIMULATE_CYCLE_PER_MS / 1000));
+	}
+}
+
+/*******************************************************************************
+ * @fn      SimulateKey
+ * @brief   Press, hold and release a key, then leave a gap
+ * @paramz  key
+ * @return  None
+ ******************************************************************************/
+static void SimulateKey(uint8_t key)
+{
+	SimulateEdge(key, true);
+	SimulateUntil(simulateCycle + (SIMULATE_HOLD_PERIOD * SIMULATE_CYCLE_PER_MS));
+	SimulateEdge(key, false);
+	SimulateUntil(simulateCycle + (SIMULATE_GAP_PERIOD * SIMULATE_CYCLE_PER_MS));
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+int main(void)
+{
+	uint8_t i = 0;
+	uint8_t key;
+	uint16_t screen;
+	uint32_t pressCount = 0;
+	uint32_t pairCount = 0;
+	uint32_t displayCount = 0;
+	uint32_t cyclePerMillisecond = SIMULATE_CYCLE_PER_MS;
+	sDIAGNOSTIC_STATISTIC sDiagnosticStatistic;
+
+	hostCycleCounter = SimulateCycleCounter;
+	hostGpioRead = SimulateReadPin;
+	setenv("TZ", "UTC", 1);
+
+	// Same as MainLoop initialize
+	sDiagnostic.Initialize();
+	sSoftwareTimer.Enable();
+	frontKeypadId = sMatrixButton.Initialize(&frontKeypadConfig, MatrixButtonCallback);
+	sLcd.Initialize();
+	sFieldEditor.Initialize(MultiTapTimerCallback);
+	sReport.Initialize();
+	sMenuList.Initialize();
+	SimulateUntil(simulateCycle + (SIMULATE_GAP_PERIOD * SIMULATE_CYCLE_PER_MS));
+	TEST_CHECK(sMenuList.GetScreen() == MENU_DATE_TIME);
+
+	for(i = 0; i < SIMULATE_ROUND; i++)
+	{
+		for(key = 0; key < sizeof(scenario); key++)
+		{
+			SimulateKey(scenario[key]);
+			pressCount++;
+		}
+		// Round end where it started
+		TEST_CHECK(sMenuList.GetScreen() == MENU_DATE_TIME);
+	}
+
+	sDiagnostic.Print();
+	sDiagnostic.GetStatistic(matrixButtonEventFlag, DIAGNOSTIC_DISPLAY, &sDiagnosticStatistic);
+	printf("Simulated edge to display: n %u p50 %u p99 %u max %u ms, over %u ms %u\n",
+			sDiagnosticStatistic.count,
+			sDiagnosticStatistic.percentile50 / cyclePerMillisecond,
+			sDiagnosticStatistic.percentile99 / cyclePerMillisecond,
+			sDiagnosticStatistic.maximum / cyclePerMillisecond,
+			DIAGNOSTIC_DISPLAY_BUDGET,
+			sDiagnosticStatistic.overBudget);
+	// Every press changing the screen is measured and never shorter than its
+	// debounce
+	displayCount = sDiagnosticStatistic.count;
+	TEST_CHECK(displayCount == (pressCount - (SIMULATE_NO_CHANGE_KEY * SIMULATE_ROUND)));
+	TEST_CHECK(sDiagnosticStatistic.minimum >= (uint32_t)DEBOUNCE_DELAY * cyclePerMillisecond);
+	TEST_CHECK(sDiagnosticStatistic.overBudget == 0);
+	for(i = 0; sDiagnostic.GetDisplayStatistic(i, &key, &screen, &sDiagnosticStatistic); i++)
+	{
+		pairCount += sDiagnosticStatistic.count;
+	}
+	// Pair table keep the first pairs only, the rest is counted as dropped
+	TEST_CHECK(pairCount > 0 && pairCount <= displayCount);
+	return TEST_RESULT();
+}
@@ -0,0 +1,305 @@
+/*******************************************************************************
+ * Filename:			test_matrix_button.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Per key debounce integrator and ghost key check
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test.h"
+// Module under test, its local functions are reached directly
+#include "matrix_button.c"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+#define KEY(row, column)	(0x01 << ((NUM_OF_MATRIX_BUTTON_COLUMN * (row)) + (column)))
+
+/*******************************************************************************
+ * LOCAL VARIBLES
+ ******************************************************************************/
+static sMATRIX_BUTTON_KEYPAD sKeypad;
+// Two keypads share the column port, rows on separate pins
+static const sMATRIX_BUTTON_CONFIG keypadConfig[2] =
+{
+	{
+		{{GPIOB, GPIO_PIN_0}, {GPIOB, GPIO_PIN_1}, {GPIOB, GPIO_PIN_2}, {GPIOB, GPIO_PIN_3}},
+		{{GPIOA, GPIO_PIN_0}, {GPIOA, GPIO_PIN_1}, {GPIOA, GPIO_PIN_2}, {GPIOA, GPIO_PIN_3}},
+		3,
+	},
+	{
+		{{GPIOB, GPIO_PIN_4}, {GPIOB, GPIO_PIN_5}, {GPIOB, GPIO_PIN_6}, {GPIOB, GPIO_PIN_7}},
+		{{GPIOA, GPIO_PIN_4}, {GPIOA, GPIO_PIN_5}, {GPIOA, GPIO_PIN_6}, {GPIOA, GPIO_PIN_7}},
+		0,
+	},
+};
+// Held keys of each simulated keypad
+static uint16_t heldKey[2];
+
+/*******************************************************************************
+ * STUB FUNCTIONS
+ ******************************************************************************/
+static uint8_t StubTimerInitialize(SOFTWARE_TIMER_CALLBACK softwareTimerStartCallback, SOFTWARE_TIMER_CALLBACK softwareTimerCallback, SOFTWARE_TIMER_CALLBACK softwareTimerStopCallback, eTIMER_TYPE eTimerType)
+{
+	return 0;
+}
+
+static void StubTimerStart(uint8_t softwareTimerId, uint32_t period)
+{
+}
+
+static void StubTimerStop(uint8_t softwareTimerId)
+{
+}
+
+sSOFTWARE_TIMER sSoftwareTimer =
+{
+	NULL,
+	NULL,
+	StubTimerInitialize,
+	StubTimerStart,
+	StubTimerStop,
+	NULL,
+};
+
+/*******************************************************************************
+ * @fn      KeypadReadPin
+ * @brief   Row is low when a held key connect it to a column driven low
+ * @paramz  gpio
+ * 			pin
+ * @return  Pin state
+ ******************************************************************************/
+static GPIO_PinState KeypadReadPin(GPIO_TypeDef *gpio, uint16_t pin)
+{
+	uint8_t keypad = 0;
+	uint8_t row = 0;
+	uint8_t column = 0;
+	const sMATRIX_BUTTON_CONFIG *psConfig;
+
+	for(keypad = 0; keypad < 2; keypad++)
+	{
+		psConfig = &keypadConfig[keypad];
+		for(row = 0; row < NUM_OF_MATRIX_BUTTON_ROW; row++)
+		{
+			if(psConfig->sRowPin[row].gpio != gpio || psConfig->sRowPin[row].pin != pin)
+			{
+				continue;
+			}
+			for(column = 0; column < NUM_OF_MATRIX_BUTTON_COLUMN; column++)
+			{
+				if((heldKey[keypad] & KEY(row, column)) && (psConfig->sColumnPin[column].gpio->ODR & psConfig->sColumnPin[column].pin) == 0)
+				{
+					return GPIO_PIN_RESET;
+				}
+			}
+		}
+	}
+	return GPIO_PIN_SET;
+}
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+/*******************************************************************************
+ * @fn      ResetKeypad
+ * @brief   Released keypad, every key debounced over debounceScan scans
+ * @paramz  debounceScan
+ * @return  None
+ ******************************************************************************/
+static void ResetKeypad(uint8_t debounceScan)
+{
+	uint8_t i = 0;
+
+	memset(&sKeypad, 0, sizeof(sKeypad));
+	sKeypad.holdKey = NUM_OF_MATRIX_BUTTON;
+	for(i = 0; i < NUM_OF_MATRIX_BUTTON; i++)
+	{
+		sKeypad.debounceScan[i] = debounceScan;
+	}
+}
+
+/*******************************************************************************
+ * @fn      FeedKey
+ * @brief   Feed one key with a raw pattern, scan by scan
+ * @paramz  rawState	Key bit
+ * 			pattern		'1' pressed, '0' released
+ * 			stable		Expected stable state after each scan
+ * @return  None
+ ******************************************************************************/
+static void FeedKey(uint16_t rawState, const char *pattern, const char *stable)
+{
+	uint8_t i = 0;
+
+	for(i = 0; pattern[i] != '\0'; i++)
+	{
+		sKeypad.keyState = DebounceKey(&sKeypad, (pattern[i] == '1') ? rawState : 0);
+		TEST_CHECK(((sKeypad.keyState & rawState) != 0) == (stable[i] == '1'));
+	}
+}
+
+/*******************************************************************************
+ * @fn      TestDebounce
+ * @brief   Contact bounce is absorbed, state change after debounceScan net
+ * 			agreeing scans
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestDebounce(void)
+{
+	uint8_t i = 0;
+
+	// Clean press and release take exactly debounceScan scans
+	ResetKeypad(5);
+	FeedKey(KEY(1, 2), "11111" "00000", "00001" "11110");
+
+	// Press bounce, integrator step back on each open scan
+	ResetKeypad(5);
+	FeedKey(KEY(0, 0), "101101111" "1", "000000001" "1");
+	// Release bounce, a short open does not release
+	FeedKey(KEY(0, 0), "0100000", "1111110");
+
+	// Glitch shorter than debounceScan is never reported
+	ResetKeypad(5);
+	FeedKey(KEY(3, 3), "1101100000", "0000000000");
+	TEST_CHECK(sKeypad.pressEdge == 0);
+
+	// Keys are integrated independently
+	ResetKeypad(3);
+	for(i = 0; i < 3; i++)
+	{
+		sKeypad.keyState = DebounceKey(&sKeypad, KEY(0, 1) | (((i & 0x01) == 0) ? KEY(2, 0) : 0));
+	}
+	TEST_CHECK(sKeypad.keyState == KEY(0, 1));
+	TEST_CHECK(sKeypad.integrator[NUM_OF_MATRIX_BUTTON_COLUMN * 2] == 1);
+
+	// Per key setting, slow key lag fast key
+	ResetKeypad(2);
+	sKeypad.debounceScan[5] = 6;
+	for(i = 0; i < 2; i++)
+	{
+		sKeypad.keyState = DebounceKey(&sKeypad, KEY(1, 1) | KEY(1, 0));
+	}
+	TEST_CHECK(sKeypad.keyState == KEY(1, 0));
+	for(i = 0; i < 4; i++)
+	{
+		sKeypad.keyState = DebounceKey(&sKeypad, KEY(1, 1) | KEY(1, 0));
+	}
+	TEST_CHECK(sKeypad.keyState == (KEY(1, 1) | KEY(1, 0)));
+}
+
+/*******************************************************************************
+ * @fn      TestGhost
+ * @brief   Any two rows sharing two columns is ambiguous
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestGhost(void)
+{
+	uint8_t i = 0;
+
+	TEST_CHECK(!IsGhosted(0));
+	TEST_CHECK(!IsGhosted(KEY(2, 2)));
+	// Two keys never ghost
+	TEST_CHECK(!IsGhosted(KEY(0, 0) | KEY(0, 3)));
+	TEST_CHECK(!IsGhosted(KEY(0, 0) | KEY(3, 0)));
+	TEST_CHECK(!IsGhosted(KEY(0, 0) | KEY(1, 1)));
+	// Three keys in a row, or an L sharing one column only
+	TEST_CHECK(!IsGhosted(KEY(1, 0) | KEY(1, 1) | KEY(1, 2)));
+	TEST_CHECK(!IsGhosted(KEY(0, 1) | KEY(2, 1) | KEY(2, 3)));
+	TEST_CHECK(!IsGhosted(KEY(0, 0) | KEY(1, 1) | KEY(2, 2)));
+	// Three corners of a rectangle, the fourth key reads pressed too
+	TEST_CHECK(IsGhosted(KEY(0, 0) | KEY(0, 1) | KEY(1, 0) | KEY(1, 1)));
+	TEST_CHECK(IsGhosted(KEY(0, 0) | KEY(0, 2) | KEY(3, 0) | KEY(3, 2)));
+	TEST_CHECK(IsGhosted(KEY(1, 1) | KEY(1, 3) | KEY(2, 1) | KEY(2, 3)));
+	// Every rectangle of the matrix
+	for(i = 0; i < NUM_OF_MATRIX_BUTTON_ROW * NUM_OF_MATRIX_BUTTON_COLUMN; i++)
+	{
+		uint8_t row = i / NUM_OF_MATRIX_BUTTON_COLUMN;
+		uint8_t column = i % NUM_OF_MATRIX_BUTTON_COLUMN;
+		uint8_t otherRow = (row + 1) % NUM_OF_MATRIX_BUTTON_ROW;
+		uint8_t otherColumn = (column + 1) % NUM_OF_MATRIX_BUTTON_COLUMN;
+
+		TEST_CHECK(IsGhosted(KEY(row, column) | KEY(row, otherColumn) | KEY(otherRow, column) | KEY(otherRow, otherColumn)));
+	}
+
+	// Ambiguous scan hold last stable state until it is gone
+	ResetKeypad(2);
+	ProcessRawState(&sKeypad, KEY(0, 0) | KEY(0, 1));
+	ProcessRawState(&sKeypad, KEY(0, 0) | KEY(0, 1));
+	TEST_CHECK(sKeypad.keyState == (KEY(0, 0) | KEY(0, 1)));
+	sKeypad.pressEdge = 0;
+	for(i = 0; i < 4; i++)
+	{
+		ProcessRawState(&sKeypad, KEY(0, 0) | KEY(0, 1) | KEY(1, 0) | KEY(1, 1));
+	}
+	TEST_CHECK(sKeypad.keyState == (KEY(0, 0) | KEY(0, 1)));
+	TEST_CHECK(sKeypad.pressEdge == 0);
+	TEST_CHECK(sKeypad.ghostCount == 4);
+	ProcessRawState(&sKeypad, KEY(0, 0) | KEY(0, 1) | KEY(1, 0));
+	ProcessRawState(&sKeypad, KEY(0, 0) | KEY(0, 1) | KEY(1, 0));
+	TEST_CHECK(sKeypad.keyState == (KEY(0, 0) | KEY(0, 1) | KEY(1, 0)));
+}
+
+/*******************************************************************************
+ * @fn      TestMultiKeypad
+ * @brief   Two keypad instances scanned in turn, each with own debounce
+ * 			setting and event queue
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestMultiKeypad(void)
+{
+	uint8_t i = 0;
+	uint8_t keypadId[2];
+	sKEY_EVENT sKeyEvent;
+
+	hostGpioRead = KeypadReadPin;
+	keypadId[0] = sMatrixButton.Initialize(&keypadConfig[0], NULL);
+	keypadId[1] = sMatrixButton.Initialize(&keypadConfig[1], NULL);
+	TEST_CHECK(keypadId[0] == 0 && keypadId[1] == 1);
+	TEST_CHECK(sMatrixButtonPro.sKeypad[0].debounceScan[0] == 3);
+	TEST_CHECK(sMatrixButtonPro.sKeypad[1].debounceScan[0] == MATRIX_BUTTON_DEBOUNCE_SCAN);
+
+	// Same key position held on both keypads, one keypad scanned per tick
+	heldKey[0] = KEY(2, 1);
+	heldKey[1] = KEY(2, 1);
+	for(i = 0; i < 2 * 3; i++)
+	{
+		PeriodicScanTimerCallback(0);
+	}
+	TEST_CHECK(sMatrixButton.GetKeyState(keypadId[0]) == KEY(2, 1));
+	TEST_CHECK(sMatrixButton.GetKeyState(keypadId[1]) == 0);
+	for(i = 0; i < 2 * (MATRIX_BUTTON_DEBOUNCE_SCAN - 3); i++)
+	{
+		PeriodicScanTimerCallback(0);
+	}
+	TEST_CHECK(sMatrixButton.GetKeyState(keypadId[1]) == KEY(2, 1));
+
+	// Events stay in the queue of own keypad
+	heldKey[0] = 0;
+	heldKey[1] = KEY(2, 1) | KEY(0, 3);
+	for(i = 0; i < 2 * MATRIX_BUTTON_DEBOUNCE_SCAN; i++)
+	{
+		PeriodicScanTimerCallback(0);
+	}
+	TEST_CHECK(sMatrixButton.GetKeyEvent(keypadId[0], &sKeyEvent) && sKeyEvent.eKeyEventType == KEY_PRESS && sKeyEvent.key == 9);
+	TEST_CHECK(sMatrixButton.GetKeyEvent(keypadId[0], &sKeyEvent) && sKeyEvent.eKeyEventType == KEY_RELEASE && sKeyEvent.key == 9);
+	TEST_CHECK(!sMatrixButton.GetKeyEvent(keypadId[0], &sKeyEvent));
+	TEST_CHECK(sMatrixButton.GetKeyEvent(keypadId[1], &sKeyEvent) && sKeyEvent.eKeyEventType == KEY_PRESS && sKeyEvent.key == 9);
+	TEST_CHECK(sMatrixButton.GetKeyEvent(keypadId[1], &sKeyEvent) && sKeyEvent.eKeyEventType == KEY_PRESS && sKeyEvent.key == 3);
+	TEST_CHECK(!sMatrixButton.GetKeyEvent(keypadId[1], &sKeyEvent));
+	hostGpioRead = NULL;
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+int main(void)
+{
+	TestDebounce();
+	TestGhost();
+	TestMultiKeypad();
+	return TEST_RESULT();
+}
@@ -0,0 +1,286 @@
+/*******************************************************************************
+ * Filename:			test_predictive_text.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    Every word of the list round trip through Next /
+ * 						GetWord in frequency order, lookup latency on host
+ * 						and dictionary footprint. Build with the shipped
+ * 						dictionary and with a synthetic 10k word one.
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test.h"
+// Module under test, dictionary array are reached directly
+#include "predictive_text.c"
+#include <stdlib.h>
+#include <time.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+#ifndef TEST_WORD_LIST
+#define TEST_WORD_LIST			"../Tools/predictive_words.txt"
+#endif
+#define TEST_MAX_WORD			20000
+#define TEST_MAX_WORD_LENGTH	32
+#define TEST_LOOKUP_ROUND		20
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+typedef struct
+{
+	char word[TEST_MAX_WORD_LENGTH];
+	char digit[TEST_MAX_WORD_LENGTH];
+	uint32_t frequency;
+}
+sTEST_WORD;
+
+/*******************************************************************************
+ * LOCAL VARIBLES
+ ******************************************************************************/
+static sTEST_WORD sTestWord[TEST_MAX_WORD];
+static uint32_t testWordCount = 0;
+// Fastest lookup time of each word over the rounds, host noise removed
+static uint32_t bestNanosecond[TEST_MAX_WORD];
+// Key digit of letter 'a' - 'z'
+static const char letterKey[] = "22233344455566677778889999";
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+/*******************************************************************************
+ * @fn      TestCompare
+ * @brief   Word order for sort and search
+ ******************************************************************************/
+static int TestCompare(const void *a, const void *b)
+{
+	return strcmp(((const sTEST_WORD*)a)->word, ((const sTEST_WORD*)b)->word);
+}
+
+/*******************************************************************************
+ * @fn      TestFind
+ * @brief   Word of the list
+ * @paramz  word
+ * @return  Word, NULL if not in list
+ ******************************************************************************/
+static const sTEST_WORD* TestFind(const char *word)
+{
+	sTEST_WORD sKey;
+
+	snprintf(sKey.word, sizeof(sKey.word), "%s", word);
+	return bsearch(&sKey, sTestWord, testWordCount, sizeof(sTEST_WORD), TestCompare);
+}
+
+/*******************************************************************************
+ * @fn      TestReadWordList
+ * @brief   Read word list the same way as Tools/predictive_dictionary.py,
+ * 			lower case 'a' - 'z' word only, same word add frequency
+ * @paramz  path
+ * @return  None
+ ******************************************************************************/
+static void TestReadWordList(const char *path)
+{
+	FILE *file = fopen(path, "r");
+	char line[128];
+	char word[TEST_MAX_WORD_LENGTH];
+	unsigned int frequency;
+	uint32_t i = 0;
+	uint32_t j = 0;
+	int fields;
+	bool isValid;
+
+	TEST_CHECK(file != NULL);
+	if(file == NULL)
+	{
+		return;
+	}
+	while(fgets(line, sizeof(line), file) != NULL && testWordCount < TEST_MAX_WORD)
+	{
+		line[strcspn(line, "#")] = 0;
+		frequency = 1;
+		fields = sscanf(line, "%31s %u", word, &frequency);
+		if(fields < 1)
+		{
+			continue;
+		}
+		isValid = true;
+		for(i = 0; word[i] != 0; i++)
+		{
+			word[i] = (word[i] >= 'A' && word[i] <= 'Z') ? word[i] - 'A' + 'a' : word[i];
+			isValid = isValid && word[i] >= 'a' && word[i] <= 'z';
+		}
+		if(!isValid)
+		{
+			continue;
+		}
+		snprintf(sTestWord[testWordCount].word, TEST_MAX_WORD_LENGTH, "%s", word);
+		for(i = 0; word[i] != 0; i++)
+		{
+			sTestWord[testWordCount].digit[i] = letterKey[word[i] - 'a'];
+		}
+		sTestWord[testWordCount].digit[i] = 0;
+		sTestWord[testWordCount].frequency = frequency;
+		testWordCount++;
+	}
+	fclose(file);
+	// Same word on more line is one word
+	qsort(sTestWord, testWordCount, sizeof(sTEST_WORD), TestCompare);
+	for(i = 1, j = 0; i < testWordCount; i++)
+	{
+		if(strcmp(sTestWord[i].word, sTestWord[j].word) == 0)
+		{
+			sTestWord[j].frequency += sTestWord[i].frequency;
+		}
+		else
+		{
+			sTestWord[++j] = sTestWord[i];
+		}
+	}
+	testWordCount = (testWordCount == 0) ? 0 : j + 1;
+}
+
+/*******************************************************************************
+ * @fn      TestLookup
+ * @brief   Node of digit sequence from root
+ * @paramz  digit
+ * @return  Node, PREDICTIVE_NO_NODE if no word start with it
+ ******************************************************************************/
+static uint16_t TestLookup(const char *digit)
+{
+	uint16_t node = PREDICTIVE_ROOT;
+
+	for(; *digit != 0 && node != PREDICTIVE_NO_NODE; digit++)
+	{
+		node = sPredictiveText.Next(node, *digit);
+	}
+	return node;
+}
+
+/*******************************************************************************
+ * @fn      TestRoundTrip
+ * @brief   Every word is found at its digit sequence, word before it has
+ * 			same or higher frequency, every prefix has a completion
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestRoundTrip(void)
+{
+	uint32_t i = 0;
+	uint32_t found = 0;
+	uint32_t ordered = 0;
+	uint32_t completed = 0;
+	uint32_t prefix = 0;
+	uint16_t node;
+	uint8_t rank;
+	uint8_t count;
+	uint8_t length;
+	const char *pWord;
+	const char *pCompletion;
+	const sTEST_WORD *psBefore;
+	char digit[TEST_MAX_WORD_LENGTH];
+
+	for(i = 0; i < testWordCount; i++)
+	{
+		node = TestLookup(sTestWord[i].digit);
+		count = sPredictiveText.GetWordCount(node);
+		for(rank = 0; rank < count; rank++)
+		{
+			pWord = sPredictiveText.GetWord(node, rank);
+			if(strcmp(pWord, sTestWord[i].word) == 0)
+			{
+				found++;
+				psBefore = (rank == 0) ? &sTestWord[i] : TestFind(sPredictiveText.GetWord(node, rank - 1));
+				ordered += (psBefore != NULL && psBefore->frequency >= sTestWord[i].frequency) ? 1 : 0;
+				break;
+			}
+		}
+		// Letter shown while the word is typed, completion share the digit
+		for(length = 1; sTestWord[i].digit[length] != 0; length++)
+		{
+			snprintf(digit, sizeof(digit), "%.*s", length, sTestWord[i].digit);
+			pCompletion = sPredictiveText.GetCompletion(TestLookup(digit));
+			prefix++;
+			if(pCompletion == NULL || strlen(pCompletion) < length)
+			{
+				continue;
+			}
+			for(rank = 0; rank < length && letterKey[pCompletion[rank] - 'a'] == digit[rank]; rank++);
+			completed += (rank == length) ? 1 : 0;
+		}
+	}
+	printf("Round trip: %u of %u word found, %u in frequency order, %u of %u prefix completed\n",
+			found, testWordCount, ordered, completed, prefix);
+	TEST_CHECK(testWordCount > 0);
+	TEST_CHECK(found == testWordCount);
+	TEST_CHECK(ordered == testWordCount);
+	TEST_CHECK(completed == prefix);
+	// Key without letter and sequence of no word
+	TEST_CHECK(sPredictiveText.Next(PREDICTIVE_ROOT, '1') == PREDICTIVE_NO_NODE);
+	TEST_CHECK(sPredictiveText.Next(PREDICTIVE_NO_NODE, '2') == PREDICTIVE_NO_NODE);
+	TEST_CHECK(sPredictiveText.GetWord(PREDICTIVE_NO_NODE, 0) == NULL);
+	TEST_CHECK(sPredictiveText.GetCompletion(PREDICTIVE_NO_NODE) == NULL);
+}
+
+/*******************************************************************************
+ * @fn      TestBenchmark
+ * @brief   Host time of one key (Next) and of a whole word lookup with its
+ * 			first word, slowest word by its best round and dictionary flash
+ * 			footprint
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestBenchmark(void)
+{
+	struct timespec start;
+	struct timespec end;
+	uint32_t round = 0;
+	uint32_t i = 0;
+	uint32_t keyCount = 0;
+	uint32_t worstNanosecond = 0;
+	uint32_t nanosecond;
+	uint64_t totalNanosecond = 0;
+	volatile uintptr_t sink = 0;
+	uint32_t footprint = sizeof(predictiveChild) + sizeof(predictiveChildRank) + sizeof(predictiveTerminal) +
+						 sizeof(predictiveTerminalRank) + sizeof(predictiveWordIndex) + sizeof(predictiveWord);
+
+	memset(bestNanosecond, 0xFF, sizeof(bestNanosecond));
+	for(round = 0; round < TEST_LOOKUP_ROUND; round++)
+	{
+		for(i = 0; i < testWordCount; i++)
+		{
+			clock_gettime(CLOCK_MONOTONIC, &start);
+			sink += (uintptr_t)sPredictiveText.GetWord(TestLookup(sTestWord[i].digit), 0);
+			clock_gettime(CLOCK_MONOTONIC, &end);
+			nanosecond = (end.tv_sec - start.tv_sec) * 1000000000UL + (end.tv_nsec - start.tv_nsec);
+			totalNanosecond += nanosecond;
+			bestNanosecond[i] = (nanosecond < bestNanosecond[i]) ? nanosecond : bestNanosecond[i];
+			keyCount += strlen(sTestWord[i].digit);
+		}
+	}
+	for(i = 0; i < testWordCount; i++)
+	{
+		worstNanosecond = (bestNanosecond[i] > worstNanosecond) ? bestNanosecond[i] : worstNanosecond;
+	}
+	printf("Dictionary: %u word, %u node, %u group, %u byte flash (%u byte word pool)\n",
+			testWordCount, PREDICTIVE_NODE_COUNT, PREDICTIVE_GROUP_COUNT, footprint, (uint32_t)sizeof(predictiveWord));
+	printf("Host lookup: %lu ns per word, %lu ns per key, slowest word %u ns (timer included)\n",
+			(unsigned long)(totalNanosecond / (TEST_LOOKUP_ROUND * testWordCount)),
+			(unsigned long)(totalNanosecond / keyCount), worstNanosecond);
+	// Next read at most one rank block, cost does not grow with the list
+	TEST_CHECK(PREDICTIVE_RANK_BLOCK <= 16);
+	TEST_CHECK(footprint < (1024 * 1024));
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+int main(void)
+{
+	TestReadWordList(TEST_WORD_LIST);
+	TestRoundTrip();
+	TestBenchmark();
+	return TEST_RESULT();
+}
@@ -0,0 +1,260 @@
+/*******************************************************************************
+ * Filename:			test_report.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    One year of minute sample replayed, every daily,
+ * 						ISO weekly and monthly aggregate against a gmtime /
+ * 						strftime reference, period roll-over, old sample
+ * 						dropped and 64 bit update cycle total
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test.h"
+// Module under test, its local functions are reached directly
+#include "report.c"
+#include <stdlib.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// 2025-01-01 00:00:00 UTC Wednesday, ISO week 2025-W01 start 2024-12-30
+#define TEST_START_TIME			1735689600
+#define TEST_DAY_COUNT			366
+#define TEST_SAMPLE_PERIOD		60
+// Simulated cost of one update, total wrap 32 bit within the year
+#define TEST_UPDATE_CYCLES		10000
+// Reference period of the year, day, ISO week and month
+#define TEST_MAX_PERIOD			(TEST_DAY_COUNT + 1)
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Reference aggregate of each period in order, worked out from calendar
+typedef struct
+{
+	sREPORT_AGGREGATE sAggregate[TEST_MAX_PERIOD];
+	uint16_t count;
+	// strftime label of current period
+	char label[16];
+}
+sTEST_REFERENCE;
+
+/*******************************************************************************
+ * LOCAL VARIBLES
+ ******************************************************************************/
+static sTEST_REFERENCE sTestReference[maximumReportPeriod];
+static const char *const testLabelFormat[maximumReportPeriod] = {"%Y-%j", "%G-W%V", "%Y-%m"};
+static const char *const testPeriodName[maximumReportPeriod] = {"daily", "weekly", "monthly"};
+static uint32_t testCycle = 0;
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+/*******************************************************************************
+ * @fn      TestCycleCounter
+ * @brief   Each counter read advance one update cost
+ ******************************************************************************/
+static uint32_t TestCycleCounter(void)
+{
+	testCycle += TEST_UPDATE_CYCLES;
+	return testCycle;
+}
+
+/*******************************************************************************
+ * @fn      TestSame
+ * @brief   Aggregate sum, count, minimum and maximum are same
+ ******************************************************************************/
+static bool TestSame(const sREPORT_AGGREGATE *psA, const sREPORT_AGGREGATE *psB)
+{
+	return psA->sum == psB->sum && psA->count == psB->count &&
+		   psA->minimum == psB->minimum && psA->maximum == psB->maximum;
+}
+
+/*******************************************************************************
+ * @fn      TestReferenceAdd
+ * @brief   Add sample to reference of every period
+ * @paramz  unixTime
+ * 			value
+ * @return  Bit per period of sample starting a new period
+ ******************************************************************************/
+static uint8_t TestReferenceAdd(time_t unixTime, int16_t value)
+{
+	sTEST_REFERENCE *psReference;
+	sREPORT_AGGREGATE *psAggregate;
+	char label[16];
+	uint8_t period = 0;
+	uint8_t newPeriod = 0;
+
+	for(period = 0; period < maximumReportPeriod; period++)
+	{
+		psReference = &sTestReference[period];
+		strftime(label, sizeof(label), testLabelFormat[period], gmtime(&unixTime));
+		if(psReference->count == 0 || strcmp(label, psReference->label) != 0)
+		{
+			strcpy(psReference->label, label);
+			psAggregate = &psReference->sAggregate[psReference->count++];
+			psAggregate->minimum = value;
+			psAggregate->maximum = value;
+			newPeriod |= (0x01 << period);
+		}
+		psAggregate = &psReference->sAggregate[psReference->count - 1];
+		psAggregate->sum += value;
+		psAggregate->count++;
+		psAggregate->minimum = (value < psAggregate->minimum) ? value : psAggregate->minimum;
+		psAggregate->maximum = (value > psAggregate->maximum) ? value : psAggregate->maximum;
+	}
+	return newPeriod;
+}
+
+/*******************************************************************************
+ * @fn      TestReplay
+ * @brief   A sample every minute for a year, at each period roll-over the
+ * 			new period has one sample and the one before it is complete
+ * @paramz  None
+ * @return  Time of last sample
+ ******************************************************************************/
+static time_t TestReplay(void)
+{
+	sREPORT_AGGREGATE sAggregate;
+	time_t unixTime = TEST_START_TIME;
+	time_t endTime = TEST_START_TIME + (TEST_DAY_COUNT * REPORT_SECOND_PER_DAY);
+	uint32_t rollOver[maximumReportPeriod] = {0};
+	uint32_t rollOverSame[maximumReportPeriod] = {0};
+	uint16_t count;
+	uint8_t newPeriod;
+	uint8_t period = 0;
+	int16_t value;
+
+	for(; unixTime < endTime; unixTime += TEST_SAMPLE_PERIOD)
+	{
+		value = ((unixTime / TEST_SAMPLE_PERIOD) % 500) - 100;
+		sReport.AddSample(unixTime, value);
+		newPeriod = TestReferenceAdd(unixTime, value);
+		for(period = 0; period < maximumReportPeriod; period++)
+		{
+			count = sTestReference[period].count;
+			if(!(newPeriod & (0x01 << period)) || count < 2)
+			{
+				continue;
+			}
+			rollOver[period]++;
+			rollOverSame[period] += (sReport.Get(period, unixTime, 0, &sAggregate) && sAggregate.count == 1 &&
+									 sReport.Get(period, unixTime, 1, &sAggregate) &&
+									 TestSame(&sAggregate, &sTestReference[period].sAggregate[count - 2])) ? 1 : 0;
+		}
+	}
+	for(period = 0; period < maximumReportPeriod; period++)
+	{
+		printf("Roll-over %s: %u of %u right\n", testPeriodName[period], rollOverSame[period], rollOver[period]);
+		TEST_CHECK(rollOver[period] > 0 && rollOverSame[period] == rollOver[period]);
+	}
+	TEST_CHECK(rollOver[REPORT_DAILY] == TEST_DAY_COUNT - 1);
+	// 2025-W02 to 2026-W01, February 2025 to January 2026
+	TEST_CHECK(rollOver[REPORT_WEEKLY] == 52);
+	TEST_CHECK(rollOver[REPORT_MONTHLY] == 12);
+
+	return unixTime - TEST_SAMPLE_PERIOD;
+}
+
+/*******************************************************************************
+ * @fn      TestTable
+ * @brief   Every period kept in ring table is same as reference, older one
+ * 			is gone
+ * @paramz  unixTime	Time of last sample
+ * @return  None
+ ******************************************************************************/
+static void TestTable(time_t unixTime)
+{
+	sREPORT_AGGREGATE sAggregate;
+	uint16_t index = 0;
+	uint16_t count;
+	uint16_t kept;
+	uint16_t same;
+	uint8_t period = 0;
+
+	for(period = 0; period < maximumReportPeriod; period++)
+	{
+		count = sTestReference[period].count;
+		kept = (count < reportTable[period].size) ? count : reportTable[period].size;
+		for(index = 0, same = 0; index < kept; index++)
+		{
+			same += (sReport.Get(period, unixTime, index, &sAggregate) &&
+					 TestSame(&sAggregate, &sTestReference[period].sAggregate[count - 1 - index])) ? 1 : 0;
+		}
+		printf("Table %s: %u period, %u kept, %u same\n", testPeriodName[period], count, kept, same);
+		TEST_CHECK(same == kept);
+		TEST_CHECK(!sReport.Get(period, unixTime, reportTable[period].size, &sAggregate));
+	}
+	// 2026-01-01, every value of the 500 minute cycle
+	TEST_CHECK(sReport.Get(REPORT_DAILY, unixTime, 0, &sAggregate) && sAggregate.count == 1440 &&
+			   sAggregate.minimum == -100 && sAggregate.maximum == 399);
+	TEST_CHECK(sReport.Get(REPORT_DAILY, unixTime, REPORT_DAY_COUNT - 1, &sAggregate) && sAggregate.count == 1440);
+	// 2026-W01 is Monday 2025-12-29 to 2026-01-01 so far
+	TEST_CHECK(sReport.Get(REPORT_WEEKLY, unixTime, 0, &sAggregate) && sAggregate.count == 4 * 1440);
+	TEST_CHECK(sReport.Get(REPORT_WEEKLY, unixTime, 1, &sAggregate) && sAggregate.count == 7 * 1440);
+	// 2025-W01 start 2024-12-30, only its 5 day of 2025 are sampled
+	TEST_CHECK(sReport.Get(REPORT_WEEKLY, unixTime, 52, &sAggregate) && sAggregate.count == 5 * 1440);
+	TEST_CHECK(sReport.Get(REPORT_MONTHLY, unixTime, 1, &sAggregate) && sAggregate.count == 31 * 1440);
+	TEST_CHECK(sReport.Get(REPORT_MONTHLY, unixTime, 11, &sAggregate) && sAggregate.count == 28 * 1440);
+}
+
+/*******************************************************************************
+ * @fn      TestDropped
+ * @brief   Sample of a day and month already overwritten is dropped, its
+ * 			week is still kept
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestDropped(void)
+{
+	sREPORT_STATISTIC sStatistic;
+	sREPORT_AGGREGATE sAggregate;
+	uint32_t droppedCount;
+
+	sReport.GetStatistic(&sStatistic);
+	droppedCount = sStatistic.droppedCount;
+	TEST_CHECK(droppedCount == 0);
+	sReport.AddSample(TEST_START_TIME, 0);
+	sReport.GetStatistic(&sStatistic);
+	TEST_CHECK(sStatistic.droppedCount == droppedCount + 2);
+	TEST_CHECK(sReport.Get(REPORT_WEEKLY, TEST_START_TIME, 0, &sAggregate) && sAggregate.count == 5 * 1440 + 1);
+}
+
+/*******************************************************************************
+ * @fn      TestStatistic
+ * @brief   Update cycle total pass 32 bit, average is still right
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestStatistic(void)
+{
+	sREPORT_STATISTIC sStatistic;
+
+	sReport.GetStatistic(&sStatistic);
+	TEST_CHECK(sStatistic.sampleCount == (TEST_DAY_COUNT * 1440) + 1);
+	TEST_CHECK(sStatistic.updateCycles == (uint64_t)sStatistic.sampleCount * TEST_UPDATE_CYCLES);
+	TEST_CHECK(sStatistic.updateCycles > 0xFFFFFFFFULL);
+	TEST_CHECK(sStatistic.maximumUpdateCycles == TEST_UPDATE_CYCLES);
+	sReport.Print();
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+int main(void)
+{
+	time_t unixTime;
+
+	// Target has no time zone, localtime is UTC
+	setenv("TZ", "UTC", 1);
+	tzset();
+	hostCycleCounter = TestCycleCounter;
+	sReport.Initialize();
+	unixTime = TestReplay();
+	TestTable(unixTime);
+	TestDropped();
+	TestStatistic();
+	return TEST_RESULT();
+}
@@ -0,0 +1,234 @@
+/*******************************************************************************
+ * Filename:			test_temperature_sensor.c
+ * Revised:				Date: 2026.10.19
+ * Revision:			V001
+ * Description:		    VREFINT / sensor block built from calibration
+ * 						constants over temperature and VDDA range to 0.1
+ * 						degree, IIR step settling and noise
+*******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test.h"
+// Module under test, its local functions are reached directly
+#include "temperature_sensor.c"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+// Typical factory calibration of STM32L476
+#define TEST_CAL1					1040
+#define TEST_CAL2					1370
+#define TEST_VREFINT_CAL			1655
+#define TEST_CAL_VDDA				3000
+// Block of the same temperature until filter output is settled
+#define TEST_SETTLE_BLOCK			80
+
+/*******************************************************************************
+ * STRUCTURE
+ ******************************************************************************/
+// Define calibration of one chip
+typedef struct
+{
+	uint16_t cal1;
+	uint16_t cal2;
+	uint16_t vrefintCal;
+}
+sTEST_CALIBRATION;
+
+/*******************************************************************************
+ * LOCAL VARIBLES
+ ******************************************************************************/
+static const sTEST_CALIBRATION sTestCalibration[] =
+{
+	{TEST_CAL1, TEST_CAL2, TEST_VREFINT_CAL},
+	{1000, 1320, 1620},
+	{1080, 1420, 1680},
+};
+
+/*******************************************************************************
+ * STUB FUNCTIONS
+ ******************************************************************************/
+void Error_Handler(void)
+{
+}
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+/*******************************************************************************
+ * @fn      TestBuildSum
+ * @brief   Spread a block sum over the block, sample differ by at most 1 LSB
+ * 			like a noisy reading
+ * @paramz  pSample		First sample of the channel
+ * 			sum
+ * @return  None
+ ******************************************************************************/
+static void TestBuildSum(uint16_t *pSample, uint32_t sum)
+{
+	uint8_t i = 0;
+
+	for(i = 0; i < TEMPERATURE_SENSOR_BLOCK; i++)
+	{
+		pSample[i * TEMPERATURE_SENSOR_CHANNEL_COUNT] = (sum + i) / TEMPERATURE_SENSOR_BLOCK;
+	}
+}
+
+/*******************************************************************************
+ * @fn      TestBuildBlock
+ * @brief   Block the ADC read at a temperature and VDDA, sensor reading is
+ * 			linear between calibration points and scale with 1 / VDDA
+ * @paramz  pSample
+ * 			psCalibration
+ * 			temperature		0.1 degree
+ * 			vdda			mV
+ * @return  None
+ ******************************************************************************/
+static void TestBuildBlock(uint16_t *pSample, const sTEST_CALIBRATION *psCalibration, int16_t temperature, uint16_t vdda)
+{
+	double sensor = psCalibration->cal1 + (double)(temperature - TEMPERATURE_SENSOR_CAL1_TEMPERATURE) *
+					(psCalibration->cal2 - psCalibration->cal1) / (TEMPERATURE_SENSOR_CAL2_TEMPERATURE - TEMPERATURE_SENSOR_CAL1_TEMPERATURE);
+
+	TestBuildSum(&pSample[0], (uint32_t)((double)psCalibration->vrefintCal * TEST_CAL_VDDA * TEMPERATURE_SENSOR_BLOCK / vdda + 0.5));
+	TestBuildSum(&pSample[1], (uint32_t)(sensor * TEST_CAL_VDDA * TEMPERATURE_SENSOR_BLOCK / vdda + 0.5));
+}
+
+/*******************************************************************************
+ * @fn      TestRead
+ * @brief   Convert block, 0.1 degree of first block
+ * @paramz  pSample
+ * 			psCalibration
+ * @return  0.1 degree, TEMPERATURE_SENSOR_NO_VALUE if not converted
+ ******************************************************************************/
+static int16_t TestRead(const uint16_t *pSample, const sTEST_CALIBRATION *psCalibration)
+{
+	int32_t temperature;
+	int32_t filter;
+
+	if(!TemperatureSensorConvert(pSample, psCalibration->cal1, psCalibration->cal2, psCalibration->vrefintCal, &temperature))
+	{
+		return TEMPERATURE_SENSOR_NO_VALUE;
+	}
+	return TemperatureSensorIir(&filter, temperature, true);
+}
+
+/*******************************************************************************
+ * @fn      TestConvert
+ * @brief   Hand worked block, calibration point, whole temperature and VDDA
+ * 			range within 0.1 degree
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestConvert(void)
+{
+	uint16_t sample[TEMPERATURE_SENSOR_HALF_SIZE];
+	const sTEST_CALIBRATION *psCalibration;
+	uint32_t count = 0;
+	uint32_t within = 0;
+	int16_t temperature;
+	int16_t value;
+	int16_t worst = 0;
+	uint16_t vdda;
+	uint8_t i = 0;
+
+	// VDDA 3.3V, VREFINT 1655 * 3.0 / 3.3, sensor 25 degree 1019.4 * 3.0 / 3.3
+	TestBuildSum(&sample[0], 1505 * TEMPERATURE_SENSOR_BLOCK);
+	TestBuildSum(&sample[1], 927 * TEMPERATURE_SENSOR_BLOCK);
+	TEST_CHECK(TestRead(sample, &sTestCalibration[0]) == 250);
+	// Calibration point at VDDA of calibration is exact
+	TestBuildSum(&sample[0], TEST_VREFINT_CAL * TEMPERATURE_SENSOR_BLOCK);
+	TestBuildSum(&sample[1], TEST_CAL1 * TEMPERATURE_SENSOR_BLOCK);
+	TEST_CHECK(TestRead(sample, &sTestCalibration[0]) == TEMPERATURE_SENSOR_CAL1_TEMPERATURE);
+	TestBuildSum(&sample[1], TEST_CAL2 * TEMPERATURE_SENSOR_BLOCK);
+	TEST_CHECK(TestRead(sample, &sTestCalibration[0]) == TEMPERATURE_SENSOR_CAL2_TEMPERATURE);
+	// VREFINT not converted
+	TestBuildSum(&sample[0], 0);
+	TEST_CHECK(TestRead(sample, &sTestCalibration[0]) == TEMPERATURE_SENSOR_NO_VALUE);
+
+	// -40 to 125 degree, VDDA 1.8 to 3.6V
+	for(i = 0; i < sizeof(sTestCalibration) / sizeof(sTestCalibration[0]); i++)
+	{
+		psCalibration = &sTestCalibration[i];
+		for(temperature = -400; temperature <= 1250; temperature += 5)
+		{
+			for(vdda = 1800; vdda <= 3600; vdda += 100)
+			{
+				TestBuildBlock(sample, psCalibration, temperature, vdda);
+				value = TestRead(sample, psCalibration);
+				count++;
+				within += (abs(value - temperature) <= 1) ? 1 : 0;
+				worst = (abs(value - temperature) > worst) ? abs(value - temperature) : worst;
+			}
+		}
+	}
+	printf("Convert: %u of %u block within 0.1 degree, worst %d/10 degree\n", within, count, worst);
+	TEST_CHECK(within == count);
+}
+
+/*******************************************************************************
+ * @fn      TestSettle
+ * @brief   Step of 10 degree up and down, output move one way and reach the
+ * 			new temperature, noise of 1 degree is reduced
+ * @paramz  None
+ * @return  None
+ ******************************************************************************/
+static void TestSettle(void)
+{
+	static const int16_t step[] = {250, 350, 250};
+	uint16_t sample[TEMPERATURE_SENSOR_HALF_SIZE];
+	const sTEST_CALIBRATION *psCalibration = &sTestCalibration[0];
+	int32_t temperature = 0;
+	int32_t filter = 0;
+	int16_t value = 0;
+	int16_t previous;
+	uint32_t block = 0;
+	uint32_t settleBlock;
+	int16_t ripple = 0;
+	uint8_t i = 0;
+	bool isMonotonic;
+
+	for(i = 0; i < sizeof(step) / sizeof(step[0]); i++)
+	{
+		TestBuildBlock(sample, psCalibration, step[i], TEST_CAL_VDDA);
+		settleBlock = 0;
+		isMonotonic = true;
+		for(block = 0; block < TEST_SETTLE_BLOCK; block++)
+		{
+			previous = value;
+			TemperatureSensorConvert(sample, psCalibration->cal1, psCalibration->cal2, psCalibration->vrefintCal, &temperature);
+			value = TemperatureSensorIir(&filter, temperature, i == 0 && block == 0);
+			isMonotonic = isMonotonic && (i == 0 || block == 0 || ((step[i] > step[i - 1]) ? value >= previous : value <= previous));
+			settleBlock = (value != step[i]) ? block + 1 : settleBlock;
+		}
+		// One block per burst, one burst per second
+		printf("Settle %d to %d/10 degree: %u block (s)\n", (i == 0) ? step[i] : step[i - 1], step[i], settleBlock);
+		TEST_CHECK(value == step[i] && isMonotonic);
+		// First block set the filter, step take about ln(1 / 100) / ln(7 / 8) block
+		TEST_CHECK((i == 0) ? settleBlock == 0 : (settleBlock >= 30 && settleBlock <= 45));
+	}
+
+	// Block read +/- 1 degree in turn around 30 degree
+	for(block = 0; block < TEST_SETTLE_BLOCK; block++)
+	{
+		TestBuildBlock(sample, psCalibration, (block & 0x01) ? 310 : 290, TEST_CAL_VDDA);
+		TemperatureSensorConvert(sample, psCalibration->cal1, psCalibration->cal2, psCalibration->vrefintCal, &temperature);
+		value = TemperatureSensorIir(&filter, temperature, false);
+		if(block >= TEST_SETTLE_BLOCK / 2)
+		{
+			ripple = (abs(value - 300) > ripple) ? abs(value - 300) : ripple;
+		}
+	}
+	printf("Noise +/- 10/10 degree: output ripple +/- %d/10 degree\n", ripple);
+	TEST_CHECK(ripple <= 1);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+int main(void)
+{
+	TestConvert();
+	TestSettle();
+	return TEST_RESULT();
+}
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""
+Filename:       predictive_dictionary.py
+Revised:        Date: 2026.10.19
+Revision:       V001
+Description:    Build Core/Inc/predictive_dictionary.h from a word list
+
+Word list is one word per line, optional frequency after it
+("word 1234"), '#' start a comment. Word is folded to lower case and
+word with character other than 'a' - 'z' is skipped.
+
+Trie is keyed by key digit '2' - '9' and stored in level order. Every
+node is one byte bitmap of its child digits, so first child of node i is
+1 + number of set bits before i (LOUDS in fixed alphabet form). A rank
+sample every PREDICTIVE_RANK_BLOCK nodes bound the count to one block.
+Node with word is marked in a terminal bit vector, its rank select the
+word group, words of a group are sorted by frequency, highest first.
+Node is 16 bit (0xFFFF is no node), word pool offset is 32 bit so a
+large word list only cost flash.
+
+Usage: predictive_dictionary.py [word_list] [output_header]
+"""
+
+import os
+import sys
+
+RANK_BLOCK = 16
+
+KEY_LETTERS = {
+    '2': 'abc', '3': 'def', '4': 'ghi', '5': 'jkl',
+    '6': 'mno', '7': 'pqrs', '8': 'tuv', '9': 'wxyz',
+}
+LETTER_KEY = {letter: key for key, letters in KEY_LETTERS.items() for letter in letters}
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DEFAULT_INPUT = os.path.join(ROOT, 'Tools', 'predictive_words.txt')
+DEFAULT_OUTPUT = os.path.join(ROOT, 'Core', 'Inc', 'predictive_dictionary.h')
+
+
+def read_words(path):
+    """Return {word: frequency}, later line of same word add frequency."""
+    words = {}
+    with open(path, encoding='utf-8') as file:
+        for line_number, line in enumerate(file, 1):
+            line = line.split('#', 1)[0].split()
+            if not line:
+                continue
+            word = line[0].lower()
+            if not word.isascii() or not word.isalpha():
+                print('%s:%d: skip "%s"' % (path, line_number, line[0]), file=sys.stderr)
+                continue
+            frequency = int(line[1]) if len(line) > 1 else 1
+            words[word] = words.get(word, 0) + frequency
+    return words
+
+
+def build(words):
+    """Return level order node list, node is (child bitmap, word list)."""
+    # Trie of digit sequence, node is {digit: node} plus word list
+    root = {'child': {}, 'word': []}
+    for word, frequency in words.items():
+        node = root
+        for letter in word:
+            node = node['child'].setdefault(LETTER_KEY[letter], {'child': {}, 'word': []})
+        node['word'].append((frequency, word))
+
+    nodes = []
+    queue = [root]
+    while queue:
+        node = queue.pop(0)
+        bitmap = 0
+        for key in sorted(node['child']):
+            bitmap |= 1 << (ord(key) - ord('2'))
+            queue.append(node['child'][key])
+        ranked = [word for frequency, word in sorted(node['word'], key=lambda item: (-item[0], item[1]))]
+        nodes.append((bitmap, ranked))
+    return nodes
+
+
+def c_array(ctype, name, size, values, per_line):
+    lines = ['static const %s %s[%s] =' % (ctype, name, size), '{']
+    for i in range(0, len(values), per_line):
+        lines.append('\t' + ', '.join(values[i:i + per_line]) + ',')
+    lines.append('};')
+    return lines
+
+
+def generate(nodes, source):
+    node_count = len(nodes)
+    block_count = (node_count + RANK_BLOCK - 1) // RANK_BLOCK
+
+    child_rank = []
+    terminal = []
+    terminal_rank = []
+    word_index = []
+    pool = []
+    offset = 0
+    ones = 0
+    groups = 0
+    for block in range(block_count):
+        child_rank.append(ones)
+        terminal_rank.append(groups)
+        bits = 0
+        for i in range(block * RANK_BLOCK, min((block + 1) * RANK_BLOCK, node_count)):
+            bitmap, ranked = nodes[i]
+            ones += bin(bitmap).count('1')
+            if ranked:
+                bits |= 1 << (i % RANK_BLOCK)
+                groups += 1
+                word_index.append(offset)
+                for word in ranked:
+                    pool.append(word)
+                    offset += len(word) + 1
+        terminal.append(bits)
+    word_index.append(offset)
+
+    if node_count >= 0xFFFF:
+        sys.exit('dictionary too large, %d node for 16 bit node' % node_count)
+
+    footprint = node_count + 2 * block_count * 3 + 4 * len(word_index) + offset
+    lines = [
+        '/*******************************************************************************',
+        ' * Filename:\t\t\tpredictive_dictionary.h',
+        ' * Revised:\t\t\t\tDate: 2026.10.19',
+        ' * Revision:\t\t\tV001',
+        ' * Description:\t\t    Predictive text dictionary, generated by',
+        ' * \t\t\t\t\t\tTools/predictive_dictionary.py from %s, do not edit' % os.path.basename(source),
+        '*******************************************************************************/',
+        '',
+        '#ifndef _PREDICTIVE_DICTIONARY_H_',
+        '#define _PREDICTIVE_DICTIONARY_H_',
+        '',
+        '/*******************************************************************************',
+        ' * CONSTANTS',
+        ' ******************************************************************************/',
+        '// %d word, %d node, %d byte flash' % (len(pool), node_count, footprint),
+        '#define PREDICTIVE_NODE_COUNT\t%d' % node_count,
+        '#define PREDICTIVE_RANK_BLOCK\t%d' % RANK_BLOCK,
+        '#define PREDICTIVE_BLOCK_COUNT\t%d' % block_count,
+        '#define PREDICTIVE_GROUP_COUNT\t%d' % groups,
+        '',
+        '/*******************************************************************************',
+        ' * LOCAL VARIBLES',
+        ' ******************************************************************************/',
+        '// Child digit bitmap of node in level order, bit 0 is key \'2\'',
+    ]
+    lines += c_array('uint8_t', 'predictiveChild', 'PREDICTIVE_NODE_COUNT',
+                     ['0x%02X' % bitmap for bitmap, ranked in nodes], 16)
+    lines += ['', '// Child bit count before each block']
+    lines += c_array('uint16_t', 'predictiveChildRank', 'PREDICTIVE_BLOCK_COUNT',
+                     [str(value) for value in child_rank], 12)
+    lines += ['', '// Node has word bit vector, bit n of entry is node block * 16 + n']
+    lines += c_array('uint16_t', 'predictiveTerminal', 'PREDICTIVE_BLOCK_COUNT',
+                     ['0x%04X' % value for value in terminal], 12)
+    lines += ['', '// Terminal bit count before each block']
+    lines += c_array('uint16_t', 'predictiveTerminalRank', 'PREDICTIVE_BLOCK_COUNT',
+                     [str(value) for value in terminal_rank], 12)
+    lines += ['', '// Word group start in predictiveWord, last entry is end of pool']
+    lines += c_array('uint32_t', 'predictiveWordIndex', 'PREDICTIVE_GROUP_COUNT + 1',
+                     [str(value) for value in word_index], 12)
+    lines += ['', '// Word pool, word of a group share digit sequence, highest frequency first',
+              'static const char predictiveWord[] =']
+    lines += ['\t"%s\\0"' % word for word in pool[:-1]]
+    lines += ['\t"%s";' % pool[-1]]
+    lines += ['', '#endif /* _PREDICTIVE_DICTIONARY_H_ */', '']
+    return '\n'.join(lines), footprint
+
+
+def main():
+    source = sys.argv[1] if len(sys.argv) > 1 else DEFAULT_INPUT
+    output = sys.argv[2] if len(sys.argv) > 2 else DEFAULT_OUTPUT
+    words = read_words(source)
+    if not words:
+        sys.exit('%s: no word' % source)
+    nodes = build(words)
+    text, footprint = generate(nodes, source)
+    with open(output, 'w', encoding='utf-8', newline='\n') as file:
+        file.write(text)
+    print('%s: %d word, %d node, %d byte flash' % (output, len(words), len(nodes), footprint))
+
+
+if __name__ == '__main__':
+    main()